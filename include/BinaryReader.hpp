@@ -0,0 +1,121 @@
+/**
+ * @file BinaryReader.hpp
+ * @author TL044CN
+ * @brief BinaryReader class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Document.hpp"
+#include "List.hpp"
+#include "Object.hpp"
+#include "StreamReadinator.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Serialization
+ * @brief BinaryReader class
+ * @details Reads the binary encoding written by BinaryWriter. The header
+ *          tells the size of the encoding, which is then fetched from the
+ *          stream and decoded from memory. The buffer only grows with the
+ *          bytes the stream delivers, a corrupt size cannot make it reserve
+ *          more. The stream is left
+ *          right behind the encoding, so it can be embedded in other data.
+ *          Packed Lists go straight into typed storage.
+ */
+class BinaryReader {
+public:
+    /**
+     * @brief the deepest nesting of Objects and Lists that is accepted
+     */
+    static constexpr size_t kMaxDepth = 1024;
+
+    /**
+     * @brief the first number of bytes the encoding is read in
+     */
+    static constexpr size_t kLoadChunkSize = 64 * 1024;
+
+private:
+    std::vector<char> mInput;
+    const char* mCursor = nullptr;
+    const char* mEnd = nullptr;
+
+    /**
+     * @brief read the header and the encoding from a stream
+     *
+     * @param reader the stream
+     * @return BaseDataType the type of the root
+     */
+    BaseDataType load(StreamReadinator& reader);
+
+    /**
+     * @brief take a number of bytes of the encoding
+     * @throws InvalidFormatException if the encoding ends before
+     *
+     * @param count the number of bytes
+     * @return const char* the bytes
+     */
+    const char* take(size_t count);
+
+    uint64_t read_varint();
+    std::string_view read_string();
+
+    template<typename Insert>
+    void read_value(size_t depth, Insert&& insert);
+
+    void read_object(Object& object, size_t depth);
+    void read_list(List& list, uint8_t tag, size_t depth);
+
+    template<typename T>
+    void read_scalars(List& list);
+
+    /**
+     * @brief check that the whole encoding was used
+     */
+    void finish();
+
+public:
+    /**
+     * @brief read a Document
+     * @throws InvalidFormatException if the data is not a valid encoding
+     * @throws InvalidKeyException if a key is invalid or appears twice in an Object
+     *
+     * @param reader the stream to read from
+     * @param upstream the memory resource the Document's arena draws from
+     * @return Document the Document
+     */
+    Document read(StreamReadinator& reader,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    /**
+     * @brief read the members of an encoded Object into an Object
+     * @throws InvalidFormatException if the data is not a valid encoding of an Object
+     * @throws InvalidKeyException if a key is invalid or already exists in the Object
+     *
+     * @param reader the stream to read from
+     * @param object the Object to add the members to
+     */
+    void read(StreamReadinator& reader, Object& object);
+
+    /**
+     * @brief read the elements of an encoded List into a List
+     * @throws InvalidFormatException if the data is not a valid encoding of a List
+     *
+     * @param reader the stream to read from
+     * @param list the List to append the elements to
+     */
+    void read(StreamReadinator& reader, List& list);
+};
+
+} // namespace JSONJay
@@ -0,0 +1,104 @@
+/**
+ * @file BinaryWriter.hpp
+ * @author TL044CN
+ * @brief BinaryWriter class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Document.hpp"
+#include "List.hpp"
+#include "Object.hpp"
+#include "StreamWritinator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Serialization
+ * @brief BinaryWriter class
+ * @details Writes Objects and Lists in a compact tagged binary encoding that
+ *          BinaryReader reads back. Every value is a one byte type tag
+ *          followed by its payload: ints and doubles at their native width in
+ *          little endian, strings, keys and counts with varint lengths. Lists
+ *          in typed storage are written as one tag and a packed array.
+ *          The encoding is assembled in a buffer that is kept between writes
+ *          and handed to the stream in one piece behind a small header with
+ *          its size, so a reader can fetch it with a single read.
+ */
+class BinaryWriter {
+private:
+    std::vector<char> mBuffer;
+    size_t mUsed = 0;
+
+    /**
+     * @brief make room for a number of bytes
+     *
+     * @param count the number of bytes
+     * @return char* where to write them
+     */
+    char* room(size_t count) {
+        if ( mBuffer.size() < mUsed + count ) mBuffer.resize(std::max(mBuffer.size() * 2, mUsed + count));
+        return mBuffer.data() + mUsed;
+    }
+
+    void put(char c) {
+        *room(1) = c;
+        mUsed++;
+    }
+
+    void write_varint(uint64_t value);
+    void write_string(std::string_view string);
+    void write_value(const Value& value);
+    void write_object(const Object& object);
+    void write_list(const List& list);
+
+    template<typename T>
+    void write_scalars(std::span<const T> values);
+
+    template<typename Write>
+    bool run(StreamWritinator& stream, Write&& write);
+
+public:
+    /**
+     * @brief write an Object
+     *
+     * @param stream the stream to write to
+     * @param object the Object
+     * @return true the Object was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const Object& object);
+
+    /**
+     * @brief write a List
+     *
+     * @param stream the stream to write to
+     * @param list the List
+     * @return true the List was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const List& list);
+
+    /**
+     * @brief write the root of a Document
+     *
+     * @param stream the stream to write to
+     * @param document the Document
+     * @return true the Document was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const Document& document);
+};
+
+} // namespace JSONJay
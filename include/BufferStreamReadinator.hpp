@@ -12,6 +12,8 @@
 #pragma once
 
 #include "StreamReadinator.hpp"
+#include <cstring>
+#include <string_view>
 #include <vector>
 
 namespace JSONJay {
@@ -22,12 +24,21 @@ namespace JSONJay {
  * @details The BufferStreamReadinator class is a StreamReadinator that reads
  *          data fropm a buffer. Buffers are std::vector<char> objects.
  */
-class BufferStreamReadinator : public StreamReadinator {
+class BufferStreamReadinator final : public StreamReadinator, public ReadinatorHelpers<BufferStreamReadinator> {
 private:
     std::vector<char> buffer;
     uint64_t position;
 
 public:
+    // the helpers of the concrete type are bound statically
+    using ReadinatorHelpers<BufferStreamReadinator>::readBuffer;
+    using ReadinatorHelpers<BufferStreamReadinator>::readString;
+    using ReadinatorHelpers<BufferStreamReadinator>::readRaw;
+    using ReadinatorHelpers<BufferStreamReadinator>::readDeserializable;
+    using ReadinatorHelpers<BufferStreamReadinator>::readMap;
+    using ReadinatorHelpers<BufferStreamReadinator>::readVector;
+    using ReadinatorHelpers<BufferStreamReadinator>::readArray;
+
     /**
      * @brief Construct a new BufferStreamReadinator object
      */
@@ -40,6 +51,15 @@ public:
      */
     BufferStreamReadinator(const std::vector<char>& buffer);
 
+    /**
+     * @brief Construct a new BufferStreamReadinator object
+     * @details Takes over the buffer without copying it. To read memory that
+     *          is owned elsewhere use a SpanStreamReadinator.
+     *
+     * @param buffer the buffer to read from
+     */
+    BufferStreamReadinator(std::vector<char>&& buffer);
+
     /**
      * @brief Destroy the BufferStreamReadinator object
      */
@@ -75,7 +95,69 @@ public:
      * @return true read was successful
      * @return false read was unsuccessful
      */
-    bool readData(char* data, uint64_t size) override;
+    bool readData(char* data, uint64_t size) override {
+        if (position > buffer.size() || size > buffer.size() - position) {
+            return false;
+        }
+
+        if (size != 0) std::memcpy(data, buffer.data() + position, size);
+
+        position += size;
+        return true;
+    }
+
+    /**
+     * @brief reads an unsigned LEB128 varint from the stream
+     * @details Decodes the varint in place without copying it.
+     *
+     * @param value the number
+     * @return true read successful
+     * @return false read failed or the varint is longer than 64 bits
+     */
+    bool readVarint(uint64_t& value) override {
+        size_t size = position < buffer.size() ? decode_varint(buffer.data() + position, buffer.size() - position, value) : 0;
+        position += size;
+        return size != 0;
+    }
+
+    /**
+     * @brief reads up to a number of bytes from the stream
+     *
+     * @param data the buffer to read into
+     * @param size the size of the buffer
+     * @return uint64_t the number of bytes read, 0 at the end of the stream
+     */
+    uint64_t readSome(char* data, uint64_t size) override;
+
+    /**
+     * @brief reads data from the stream until a delimiter is found
+     * @details Searches the rest of the data in one go and appends the bytes
+     *          up to and including the delimiter at once.
+     *
+     * @param data the buffer to read into
+     * @param delim the delimiter to read until
+     * @return true the delimiter was found
+     * @return false the rest of the data was read without finding it
+     */
+    bool readUntil(std::vector<char>& data, char delim) override;
+
+    /**
+     * @brief reads data from the stream until a delimiter is found
+     * @see readUntil(std::vector<char>&, char)
+     */
+    bool readUntil(std::vector<char>& data, std::string delim) override;
+
+    /**
+     * @brief reads data up to a delimiter without copying it
+     * @details The view includes the delimiter and points into the buffer of the readinator.
+     *
+     * @param view the bytes up to and including the delimiter, or the rest
+     *        of the data if it was not found
+     * @param delim the delimiter to read until
+     * @return true the delimiter was found
+     * @return false the rest of the data was read without finding it
+     */
+    bool readViewUntil(std::string_view& view, std::string_view delim);
 
 };
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "StreamWritinator.hpp"
+#include <cstdint>
 #include <vector>
 
 namespace JSONJay {
@@ -21,18 +22,49 @@ namespace JSONJay {
  * @brief BufferStreamWritinator class
  * @details The BufferStreamWritinator class is a StreamWritinator that writes
  *          data to a buffer. Buffers are std::vector<char> objects.
+ *          Writes go to the stream position: after setStreamPosition they
+ *          overwrite what is there, so length prefixes can be patched in
+ *          afterwards, and a gap behind the end is filled with zeros.
+ *          The buffer grows geometrically and can be handed over with
+ *          release().
  */
-class BufferStreamWritinator : public StreamWritinator {
+class BufferStreamWritinator final : public StreamWritinator, public WritinatorHelpers<BufferStreamWritinator> {
 private:
     std::vector<char> buffer;
     uint64_t position;
 
+    /**
+     * @brief writes data anywhere but at the end of the buffer
+     *
+     * @param data the data to write
+     * @param size the size of the data
+     */
+    bool overwriteData(const char* data, uint64_t size);
+
 public:
+    // the helpers of the concrete type are bound statically
+    using WritinatorHelpers<BufferStreamWritinator>::writeBuffer;
+    using WritinatorHelpers<BufferStreamWritinator>::writeZero;
+    using WritinatorHelpers<BufferStreamWritinator>::writeString;
+    using WritinatorHelpers<BufferStreamWritinator>::writeRaw;
+    using WritinatorHelpers<BufferStreamWritinator>::writeVarint;
+    using WritinatorHelpers<BufferStreamWritinator>::writeSerializable;
+    using WritinatorHelpers<BufferStreamWritinator>::writeMap;
+    using WritinatorHelpers<BufferStreamWritinator>::writeVector;
+    using WritinatorHelpers<BufferStreamWritinator>::writeArray;
+
     /**
      * @brief Construct a new BufferStreamWritinator object
      */
     BufferStreamWritinator();
 
+    /**
+     * @brief Construct a new BufferStreamWritinator object
+     *
+     * @param capacity the number of bytes to reserve up front
+     */
+    explicit BufferStreamWritinator(uint64_t capacity);
+
     /**
      * @brief Destroy the BufferStreamWritinator object
      */
@@ -66,7 +98,13 @@ public:
      * @param data the data to write
      * @param size the size of the data
      */
-    bool writeData(const char* data, uint64_t size) override;
+    bool writeData(const char* data, uint64_t size) override {
+        // appending is the common case, the vector grows geometrically
+        if (position != buffer.size()) return overwriteData(data, size);
+        buffer.insert(buffer.end(), data, data + size);
+        position += size;
+        return true;
+    }
 
     /**
      * @brief returns the buffer
@@ -75,6 +113,28 @@ public:
      */
     const std::vector<char>& getBuffer() const;
 
+    /**
+     * @brief reserves room in the buffer
+     *
+     * @param capacity the number of bytes the buffer can hold without growing
+     */
+    void reserve(uint64_t capacity);
+
+    /**
+     * @brief returns the number of bytes the buffer can hold without growing
+     *
+     * @return uint64_t the capacity
+     */
+    uint64_t capacity() const;
+
+    /**
+     * @brief hands the buffer over without copying it
+     * @details The stream is empty afterwards, its position is 0.
+     *
+     * @return std::vector<char> the buffer
+     */
+    std::vector<char> release();
+
 };
 
 } // namespace JSONJay
\ No newline at end of file
@@ -10,10 +10,15 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <concepts>
 #include <string>
 #include <variant>
+#include <memory_resource>
+#include <utility>
 
 namespace JSONJay {
 
@@ -46,6 +51,36 @@ concept IsDeserializable = requires(StreamReadinator* reader, T& t) {
     { T::deserialize(reader, t) };
 };
 
+/**
+ * @interface IsByteSwappable
+ * @ingroup Serialization
+ * @brief checks if the byte order of a type can be swapped
+ * @details Only numbers and enums are swapped, the bytes of other trivially
+ *          copyable types are written and read as they are.
+ *
+ * @tparam T the type to check
+ */
+template<typename T>
+concept IsByteSwappable = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+/**
+ * @ingroup Serialization
+ * @brief reverse the bytes of a number
+ *
+ * @tparam T the type of the number
+ * @param value the number
+ * @return T the number with its bytes reversed
+ */
+template<typename T>
+    requires IsByteSwappable<T>
+T swap_bytes(T value) noexcept {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    std::reverse(bytes, bytes + sizeof(T));
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
 /**
  * @interface numerical
  * @brief Concept for checking if a type is numerical
@@ -93,7 +128,7 @@ concept IsValidPtrDataType = std::disjunction_v<
  * @ingroup StorageClasses
  * @brief Enum class for the data type of the Storage Classes
  */
-enum class BaseDataType {
+enum class BaseDataType : uint8_t {
     STRING,     ///< The element is a string
     INT,        ///< The element is an integer
     DOUBLE,     ///< The element is a double
@@ -103,18 +138,53 @@ enum class BaseDataType {
     NONE        ///< The element is empty
 };
 
+class Value;
+
 /**
  * @ingroup StorageClasses
  * @brief the storage type for the Storage Classes
+ * @see Value
+ */
+using storage_t = Value;
+
+/**
+ * @ingroup StorageClasses
+ * @brief the allocator type used by the Storage Classes
+ */
+using node_allocator_t = std::pmr::polymorphic_allocator<std::byte>;
+
+/**
+ * @ingroup StorageClasses
+ * @brief create a nested node that allocates from an allocator
+ * @details Nodes of the new/delete resource are created with plain new so
+ *          they stay interchangeable with nodes handed over as raw pointers.
+ *
+ * @tparam T the type of the node
+ * @param allocator the allocator
+ * @param args the constructor arguments
+ * @return T* the new node
  */
-using storage_t = std::variant<std::string, int, double, bool, Object*, List*, std::monostate>;
+template<typename T, typename... Args>
+    requires IsValidPtrDataType<T>
+T* new_node(node_allocator_t allocator, Args&&... args) {
+    if ( allocator.resource() == std::pmr::new_delete_resource() )
+        return new T(std::forward<Args>(args)..., allocator);
+    return allocator.new_object<T>(std::forward<Args>(args)...);
+}
 
 /**
- * @brief Get the type of the data
+ * @ingroup StorageClasses
+ * @brief destroy a nested node created with new_node
  *
- * @param data the data to get the type of
- * @return BaseDataType the type of the data
+ * @tparam T the type of the node
+ * @param allocator the allocator the node was created with
+ * @param node the node
  */
-BaseDataType get_type(storage_t& data);
+template<typename T>
+    requires IsValidPtrDataType<T>
+void delete_node(node_allocator_t allocator, T* node) {
+    if ( allocator.resource() == std::pmr::new_delete_resource() ) delete node;
+    else allocator.delete_object(node);
+}
 
 } // namespace JSONJay
\ No newline at end of file
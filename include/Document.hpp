@@ -0,0 +1,171 @@
+/**
+ * @file Document.hpp
+ * @author TL044CN
+ * @brief Document class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+#include "Exceptions.hpp"
+#include "Object.hpp"
+#include "List.hpp"
+
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup StorageClasses
+ * @brief Document class
+ * @details A Document owns a tree of Objects and Lists together with a
+ *          monotonic arena. Every node and container buffer created inside
+ *          the tree is carved out of that arena, so building a document is
+ *          mostly pointer bumping and tearing it down releases a handful of
+ *          large blocks instead of one allocation per node.
+ *          Nodes created on the heap and moved into the Document are
+ *          relocated into the arena.
+ * @see Object
+ * @see List
+ */
+class Document {
+public:
+    /**
+     * @brief The allocator used by all nodes of the Document
+     */
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    /**
+     * @brief The size of the first block the arena requests
+     */
+    static constexpr size_t kDefaultBlockSize = 4096;
+
+private:
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> mArena;
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> mAdopted;  ///< arenas of appended Documents
+    BaseDataType mRootType;
+    Object* mObject = nullptr;
+    List* mList = nullptr;
+
+public:
+    /**
+     * @brief Construct a new Document
+     *
+     * @param rootType          the type of the root node, OBJECT or LIST
+     * @param initialBlockSize  the size of the first arena block
+     * @param upstream          the resource the arena requests its blocks from
+     */
+    explicit Document(
+        BaseDataType rootType = BaseDataType::OBJECT,
+        size_t initialBlockSize = kDefaultBlockSize,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource()
+    );
+
+    Document(Document&& other) noexcept;
+    Document& operator=(Document&& other) noexcept;
+
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+
+    ~Document();
+
+private:
+    /**
+     * @brief release the arena and with it the whole tree
+     */
+    void release();
+
+public:
+
+    /**
+     * @brief Get the type of the root node
+     *
+     * @return BaseDataType OBJECT or LIST
+     */
+    BaseDataType root_type() const;
+
+    /**
+     * @brief Get the root Object
+     * @throws InvalidTypeException if the root is not an Object
+     *
+     * @return Object& the root Object
+     */
+    Object& object();
+
+    /**
+     * @brief Get the root Object
+     * @throws InvalidTypeException if the root is not an Object
+     *
+     * @return const Object& the root Object
+     */
+    const Object& object() const;
+
+    /**
+     * @brief Get the root List
+     * @throws InvalidTypeException if the root is not a List
+     *
+     * @return List& the root List
+     */
+    List& list();
+
+    /**
+     * @brief Get the root List
+     * @throws InvalidTypeException if the root is not a List
+     *
+     * @return const List& the root List
+     */
+    const List& list() const;
+
+    /**
+     * @brief Append the elements of another Document's root List
+     * @details The elements are not copied: the Document takes over the
+     *          arena of the other Document, which is left empty.
+     * @throws InvalidTypeException if either root is not a List
+     *
+     * @param other the Document to take the elements from
+     */
+    void append(Document&& other);
+
+    /**
+     * @brief Create an empty Object that allocates from this Document
+     * @details Moving the returned Object into the tree does not copy
+     *          any of its nodes.
+     *
+     * @return Object the new Object
+     */
+    Object make_object();
+
+    /**
+     * @brief Create an empty List that allocates from this Document
+     * @details Moving the returned List into the tree does not copy
+     *          any of its nodes.
+     *
+     * @return List the new List
+     */
+    List make_list();
+
+    /**
+     * @brief Get the allocator of the Document
+     *
+     * @return allocator_type the allocator
+     */
+    allocator_type get_allocator() const;
+
+    /**
+     * @brief Get the memory resource backing the Document
+     *
+     * @return std::pmr::memory_resource* the arena
+     */
+    std::pmr::memory_resource* resource() const;
+
+};
+
+} // namespace JSONJay
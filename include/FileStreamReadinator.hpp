@@ -21,11 +21,20 @@ namespace JSONJay {
  * @brief The FileStreamReadinator class is a class that reads data from a file
  * @details The FileStreamReadinator class is a class that reads binary data from a file
  */
-class FileStreamReadinator : public StreamReadinator {
+class FileStreamReadinator final : public StreamReadinator, public ReadinatorHelpers<FileStreamReadinator> {
 private:
     std::ifstream mFile;
 
 public:
+    // the helpers of the concrete type are bound statically
+    using ReadinatorHelpers<FileStreamReadinator>::readBuffer;
+    using ReadinatorHelpers<FileStreamReadinator>::readString;
+    using ReadinatorHelpers<FileStreamReadinator>::readRaw;
+    using ReadinatorHelpers<FileStreamReadinator>::readDeserializable;
+    using ReadinatorHelpers<FileStreamReadinator>::readMap;
+    using ReadinatorHelpers<FileStreamReadinator>::readVector;
+    using ReadinatorHelpers<FileStreamReadinator>::readArray;
+
     explicit FileStreamReadinator(const std::string& filename);
     ~FileStreamReadinator() override;
 
@@ -34,6 +43,15 @@ public:
     void setStreamPosition(uint64_t position) override;
     bool readData(char* data, uint64_t size) override;
 
+    /**
+     * @brief reads up to a number of bytes from the stream
+     *
+     * @param data the buffer to read into
+     * @param size the size of the buffer
+     * @return uint64_t the number of bytes read, 0 at the end of the stream
+     */
+    uint64_t readSome(char* data, uint64_t size) override;
+
 };
 
 } // namespace JSONJay
\ No newline at end of file
@@ -20,11 +20,22 @@ namespace JSONJay {
  * @brief The FileStreamWritinator class is a class that writes data to a file
  * @details The FileStreamWritinator class is a class that writes binary data to a file
  */
-class FileStreamWritinator : public StreamWritinator {
+class FileStreamWritinator final : public StreamWritinator, public WritinatorHelpers<FileStreamWritinator> {
 private:
     std::ofstream mFile;
 
 public:
+    // the helpers of the concrete type are bound statically
+    using WritinatorHelpers<FileStreamWritinator>::writeBuffer;
+    using WritinatorHelpers<FileStreamWritinator>::writeZero;
+    using WritinatorHelpers<FileStreamWritinator>::writeString;
+    using WritinatorHelpers<FileStreamWritinator>::writeRaw;
+    using WritinatorHelpers<FileStreamWritinator>::writeVarint;
+    using WritinatorHelpers<FileStreamWritinator>::writeSerializable;
+    using WritinatorHelpers<FileStreamWritinator>::writeMap;
+    using WritinatorHelpers<FileStreamWritinator>::writeVector;
+    using WritinatorHelpers<FileStreamWritinator>::writeArray;
+
     explicit FileStreamWritinator(const std::string& filename);
     ~FileStreamWritinator() override;
 
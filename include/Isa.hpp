@@ -0,0 +1,35 @@
+/**
+ * @file Isa.hpp
+ * @author TL044CN
+ * @brief runtime detection of vector instruction sets
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace JSONJay {
+
+/**
+ * @brief vector instruction set used by the SIMD kernels
+ * @details Ordered from least to most capable.
+ */
+enum class Isa : uint8_t {
+    SCALAR,     ///< plain C++
+    SSE2,       ///< 128 bit vectors
+    AVX2        ///< 256 bit vectors
+};
+
+/**
+ * @brief Get the best instruction set supported by the CPU
+ *
+ * @return Isa the instruction set
+ */
+Isa detected_isa() noexcept;
+
+} // namespace JSONJay
@@ -12,17 +12,32 @@
 
 #include "Common.hpp"
 #include "Exceptions.hpp"
-#include "StreamReader.hpp"
-#include "StreamWriter.hpp"
+#include "StreamReadinator.hpp"
+#include "StreamWritinator.hpp"
 #include "List.hpp"
 #include "Object.hpp"
-#include "XMLObject.hpp"
+#include "Document.hpp"
+#include "JSONParser.hpp"
+#include "SaxParser.hpp"
+#include "LazyDocument.hpp"
+#include "NDJSONReader.hpp"
+#include "ParallelParser.hpp"
+#include "JSONWriter.hpp"
+#include "BinaryWriter.hpp"
+#include "BinaryReader.hpp"
+#include "MappedWriter.hpp"
+#include "MappedDocument.hpp"
 
  /**
   * @defgroup StorageClasses Storage Classes
   * @brief    this group contains the storage classes used by the JSONJay library
   */
 
+ /**
+  * @defgroup Parsing Parsing
+  * @brief    this group contains the JSON parser of the JSONJay library
+  */
+
  /**
   * @defgroup Serialization Serialization
   * @brief    this group contains the serialization classes used by the JSONJay library
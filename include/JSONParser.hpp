@@ -0,0 +1,162 @@
+/**
+ * @file JSONParser.hpp
+ * @author TL044CN
+ * @brief JSONParser class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Document.hpp"
+#include "Isa.hpp"
+#include "StreamReadinator.hpp"
+#include "StructuralIndex.hpp"
+
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Parsing
+ * @brief JSONParser class
+ * @details Parses JSON text into a Document in two stages: the
+ *          StructuralIndex finds all structural characters with vector
+ *          instructions, then the tree is built by walking that index.
+ *          Strings without escapes are copied into the Document straight
+ *          from the text.
+ *          The parser keeps its buffers between calls, reusing one parser
+ *          for many texts avoids reallocating them.
+ * @note The root of the text has to be an Object or a List, like the root
+ *       of a Document. Any string is accepted as key, also those Key would
+ *       reject. Of duplicate keys the last one wins.
+ */
+class JSONParser {
+public:
+    /**
+     * @brief the deepest nesting of Objects and Lists that is accepted
+     */
+    static constexpr size_t kMaxDepth = 1024;
+
+    /**
+     * @brief the number of bytes requested from a stream at once
+     */
+    static constexpr uint64_t kReadChunkSize = 64 * 1024;
+
+private:
+    Isa mIsa = detected_isa();
+    StructuralIndex mIndex;
+    std::string mInput;
+    std::string mKeyBuffer;
+    std::string mStringBuffer;
+
+    std::string_view mText;
+    std::span<const uint32_t> mPositions;
+    size_t mNext = 0;
+
+    friend class ParallelParser;
+
+    /**
+     * @brief get the position of the next structural character
+     * @throws InvalidFormatException at the end of the text
+     */
+    size_t next_structural();
+
+    /**
+     * @brief read the string starting at an opening quote
+     * @details The returned view points into the text if the string holds no
+     *          escapes and into the buffer otherwise.
+     * @throws InvalidFormatException on invalid escapes
+     *
+     * @param open the position of the opening quote
+     * @param buffer the buffer for the unescaped string
+     * @return std::string_view the string
+     */
+    std::string_view read_string(size_t open, std::string& buffer);
+
+    template<typename Insert>
+    void parse_value(size_t depth, Insert&& insert);
+
+    template<typename Insert>
+    void parse_scalar(size_t position, Insert&& insert);
+
+    void parse_object(Object& object, size_t depth);
+    void parse_list(List& list, size_t depth);
+
+    /**
+     * @brief parse a text whose structural index is already built
+     *
+     * @param text the JSON text
+     * @param positions the structural index of the text
+     * @param upstream the memory resource the Document's arena draws from
+     * @return Document the parsed Document
+     */
+    Document parse_indexed(std::string_view text, std::span<const uint32_t> positions,
+        std::pmr::memory_resource* upstream);
+
+    /**
+     * @brief parse elements of a List into another List
+     * @details The positions cover whole elements and the commas between
+     *          them, but not the brackets of the List.
+     *
+     * @param text the JSON text
+     * @param positions the structural characters of the elements
+     * @param list the List to append the elements to
+     */
+    void parse_elements(std::string_view text, std::span<const uint32_t> positions, List& list);
+
+public:
+    JSONParser() = default;
+
+    /**
+     * @brief Get the instruction set used for the structural index
+     *
+     * @return Isa the instruction set
+     */
+    Isa isa() const noexcept {
+        return mIsa;
+    }
+
+    /**
+     * @brief Set the instruction set used for the structural index
+     * @details Instruction sets the CPU does not support fall back to the
+     *          best supported one.
+     *
+     * @param isa the instruction set
+     * @return Isa the previous instruction set
+     */
+    Isa set_isa(Isa isa) noexcept;
+
+    /**
+     * @brief Parse a JSON text
+     * @throws InvalidFormatException if the text is not valid JSON
+     * @throws InvalidKeyException if a key is invalid or appears twice in an Object
+     *
+     * @param text the JSON text
+     * @param upstream the memory resource the Document's arena draws from
+     * @return Document the parsed Document
+     */
+    Document parse(std::string_view text,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    /**
+     * @brief Parse a JSON text read from a stream
+     * @details Reads the stream to its end.
+     * @throws InvalidFormatException if the text is not valid JSON
+     * @throws InvalidKeyException if a key is invalid or appears twice in an Object
+     *
+     * @param reader the stream
+     * @param upstream the memory resource the Document's arena draws from
+     * @return Document the parsed Document
+     */
+    Document parse(StreamReadinator& reader,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+};
+
+} // namespace JSONJay
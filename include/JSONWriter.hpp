@@ -0,0 +1,180 @@
+/**
+ * @file JSONWriter.hpp
+ * @author TL044CN
+ * @brief JSONWriter class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Document.hpp"
+#include "Isa.hpp"
+#include "List.hpp"
+#include "Object.hpp"
+#include "StreamWritinator.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Serialization
+ * @brief the layout of written JSON text
+ */
+enum class JSONStyle : uint8_t {
+    MINIFIED,   ///< no whitespace at all
+    PRETTY      ///< one value per line, nested values indented
+};
+
+/**
+ * @ingroup Serialization
+ * @brief JSONWriter class
+ * @details Writes Objects and Lists as JSON text to a StreamWritinator.
+ *          The text is assembled in one buffer of kBufferSize bytes that is
+ *          handed to the stream whenever it fills up, so the stream sees few
+ *          large writes and no node allocates a string of its own.
+ *          Strings are scanned for characters that need escaping with vector
+ *          instructions, doubles are written in their shortest form that
+ *          reads back to the same value.
+ *          Doubles that happen to be integral get a ".0" so they are read
+ *          back as doubles.
+ */
+class JSONWriter {
+public:
+    /**
+     * @brief the size of the output buffer
+     */
+    static constexpr size_t kBufferSize = 64 * 1024;
+
+private:
+    std::vector<char> mBuffer;
+    size_t mUsed = 0;
+    StreamWritinator* mStream = nullptr;
+    bool mGood = true;
+
+    JSONStyle mStyle;
+    size_t mIndent;
+    size_t mDepth = 0;
+
+    Isa mIsa = detected_isa();
+    size_t (*mFindEscape)(const char*, size_t);
+
+    /**
+     * @brief hand the buffered text to the stream
+     */
+    void flush();
+
+    /**
+     * @brief make room for a number of bytes
+     *
+     * @param count the number of bytes, at most kBufferSize
+     * @return char* where to write them
+     */
+    char* room(size_t count) {
+        if ( mBuffer.size() - mUsed < count ) flush();
+        return mBuffer.data() + mUsed;
+    }
+
+    void put(char c) {
+        if ( mUsed == mBuffer.size() ) flush();
+        mBuffer[mUsed++] = c;
+    }
+
+    void append(const char* data, size_t size);
+    void newline();
+
+    void write_string(std::string_view string);
+    void write_int(int value);
+    void write_double(double value);
+    void write_bool(bool value);
+    void write_value(const Value& value);
+    void write_object(const Object& object);
+    void write_list(const List& list);
+
+    /**
+     * @brief write a separator before an element
+     *
+     * @param first whether the element is the first of its container
+     */
+    void separate(bool first);
+
+    /**
+     * @brief write the end of a container
+     *
+     * @param close the closing bracket
+     * @param empty whether the container is empty
+     */
+    void close(char close, bool empty);
+
+    template<typename Write>
+    bool run(StreamWritinator& stream, Write&& write);
+
+public:
+    /**
+     * @brief Construct a new JSONWriter
+     *
+     * @param style the layout of the text
+     * @param indent the number of spaces per nesting level of PRETTY text
+     */
+    explicit JSONWriter(JSONStyle style = JSONStyle::MINIFIED, size_t indent = 4);
+
+    /**
+     * @brief Get the layout of the text
+     *
+     * @return JSONStyle the layout
+     */
+    JSONStyle style() const noexcept {
+        return mStyle;
+    }
+
+    /**
+     * @brief Set the instruction set used for escaping strings
+     * @details Instruction sets the CPU does not support fall back to the
+     *          best supported one.
+     *
+     * @param isa the instruction set
+     * @return Isa the previous instruction set
+     */
+    Isa set_isa(Isa isa) noexcept;
+
+    /**
+     * @brief write an Object as JSON text
+     * @throws InvalidValueException if a double is NaN or infinite
+     *
+     * @param stream the stream to write to
+     * @param object the Object
+     * @return true all text was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const Object& object);
+
+    /**
+     * @brief write a List as JSON text
+     * @throws InvalidValueException if a double is NaN or infinite
+     *
+     * @param stream the stream to write to
+     * @param list the List
+     * @return true all text was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const List& list);
+
+    /**
+     * @brief write the root of a Document as JSON text
+     * @throws InvalidValueException if a double is NaN or infinite
+     *
+     * @param stream the stream to write to
+     * @param document the Document
+     * @return true all text was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const Document& document);
+};
+
+} // namespace JSONJay
@@ -0,0 +1,77 @@
+/**
+ * @file Key.hpp
+ * @author TL044CN
+ * @brief Key class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Exceptions.hpp"
+#include "MemberStore.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace JSONJay {
+
+/**
+ * @ingroup StorageClasses
+ * @brief A validated and prehashed Object key
+ * @details Validates and hashes a key name once, so Object accessors can
+ *          probe the member store directly. Keys with static names can be
+ *          built at compile time, an invalid name then fails to compile:
+ * @code
+ * static constexpr JSONJay::Key kName("name");
+ * int& value = object.get_int(kName);
+ * @endcode
+ * @note The Key only views its name, the characters have to outlive it.
+ * @see Object
+ */
+class Key {
+private:
+    std::string_view mName;
+    uint32_t mHash;
+
+public:
+    /**
+     * @brief Construct a Key
+     * @throws InvalidKeyException if the name is empty or contains whitespace
+     *
+     * @param name the name of the key
+     */
+    constexpr explicit Key(std::string_view name) : mName(name), mHash(0) {
+        if ( name.empty() ) throw InvalidKeyException("Invalid key");
+
+        KeyHasher hasher;
+        for ( char c : name ) {
+            if ( c == ' ' || c == '\t' || c == '\n' ) throw InvalidKeyException("Invalid key");
+            hasher.update(c);
+        }
+        mHash = hasher.finish();
+    }
+
+    /**
+     * @brief Get the name of the key
+     *
+     * @return std::string_view the name
+     */
+    constexpr std::string_view name() const noexcept {
+        return mName;
+    }
+
+    /**
+     * @brief Get the hash of the key
+     *
+     * @return uint32_t the hash, see hash_key
+     */
+    constexpr uint32_t hash() const noexcept {
+        return mHash;
+    }
+};
+
+} // namespace JSONJay
@@ -0,0 +1,244 @@
+/**
+ * @file LazyDocument.hpp
+ * @author TL044CN
+ * @brief LazyDocument and LazyValue class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+#include "Isa.hpp"
+#include "StructuralIndex.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace JSONJay {
+
+class LazyDocument;
+
+/**
+ * @ingroup Parsing
+ * @brief a cursor to one value of a LazyDocument
+ * @details Lookups walk the structural index of the text, Objects and Lists
+ *          that are not asked for are skipped by counting their brackets.
+ *          Values are only decoded by the typed getters.
+ *          Malformed text is only detected where it is walked over.
+ * @see LazyDocument
+ */
+class LazyValue {
+private:
+    const LazyDocument* mDocument;
+    size_t mIndex;     ///< the index of the first structural character of the value
+
+    friend class LazyDocument;
+
+    LazyValue(const LazyDocument* document, size_t index) noexcept
+        : mDocument(document), mIndex(index) {}
+
+    /**
+     * @brief get the text of a number or literal
+     * @throws InvalidTypeException if the value is an Object, List or string
+     */
+    std::string_view atom() const;
+
+    /**
+     * @brief find the value under a key
+     *
+     * @param key the key
+     * @return size_t the index of the value or 0 if the key does not exist
+     */
+    size_t find_member(std::string_view key) const;
+
+public:
+    /**
+     * @brief Get the type of the value
+     * @details Numbers are decoded to tell INT from DOUBLE. null is NONE.
+     * @throws InvalidFormatException if the value is malformed
+     *
+     * @return BaseDataType the type
+     */
+    BaseDataType type() const;
+
+    /**
+     * @brief Get the number of members or elements
+     * @throws InvalidTypeException if the value is no Object or List
+     *
+     * @return size_t the number of members or elements
+     */
+    size_t size() const;
+
+    /**
+     * @brief check if an Object has a key
+     * @throws InvalidTypeException if the value is no Object
+     *
+     * @param key the key
+     * @return true the key exists
+     * @return false the key does not exist
+     */
+    bool contains(std::string_view key) const;
+
+    /**
+     * @brief Get the value under a key
+     * @throws InvalidTypeException if the value is no Object
+     * @throws InvalidKeyException if the key does not exist
+     *
+     * @param key the key
+     * @return LazyValue the value
+     */
+    LazyValue operator[](std::string_view key) const;
+
+    /**
+     * @brief Get an element of a List
+     * @throws InvalidTypeException if the value is no List
+     * @throws InvalidIndexException if the index is out of bounds
+     *
+     * @param index the index of the element
+     * @return LazyValue the element
+     */
+    LazyValue operator[](size_t index) const;
+
+    /**
+     * @brief Get a string
+     * @details Strings without escapes are views into the text, others are
+     *          unescaped into memory of the document. Both stay valid as
+     *          long as the document.
+     * @throws InvalidTypeException if the value is no string
+     *
+     * @return std::string_view the string
+     */
+    std::string_view get_string() const;
+
+    /**
+     * @brief Get an integer
+     * @throws InvalidTypeException if the value is no integer
+     *
+     * @return int the integer
+     */
+    int get_int() const;
+
+    /**
+     * @brief Get a double
+     * @throws InvalidTypeException if the value is no double
+     *
+     * @return double the double
+     */
+    double get_double() const;
+
+    /**
+     * @brief Get a boolean
+     * @throws InvalidTypeException if the value is no boolean
+     *
+     * @return bool the boolean
+     */
+    bool get_bool() const;
+
+    /**
+     * @brief check if the value is null
+     *
+     * @return true the value is null
+     * @return false the value is not null
+     */
+    bool is_null() const;
+};
+
+/**
+ * @ingroup Parsing
+ * @brief LazyDocument class
+ * @details Reads values out of JSON text without building a tree. Only the
+ *          StructuralIndex of the text is built up front, everything else is
+ *          done by the LazyValue cursors on access:
+ *          @code
+ *          LazyDocument document(text);
+ *          int id = document["user"]["id"].get_int();
+ *          @endcode
+ *          The text is not copied and has to outlive the document.
+ * @see LazyValue
+ * @see JSONParser
+ */
+class LazyDocument {
+private:
+    std::string_view mText;
+    StructuralIndex mIndex;
+    mutable std::pmr::monotonic_buffer_resource mStrings;
+    mutable std::string mScratch;
+
+    friend class LazyValue;
+
+    /**
+     * @brief get the position of a structural character
+     * @throws InvalidFormatException if the text ends early
+     */
+    size_t position(size_t index) const;
+
+    /**
+     * @brief get a structural character
+     * @throws InvalidFormatException if the text ends early
+     */
+    char structural(size_t index) const {
+        return mText[position(index)];
+    }
+
+    /**
+     * @brief find the end of a value
+     *
+     * @param index the index of the value
+     * @return size_t the index after the value
+     */
+    size_t skip(size_t index) const;
+
+    /**
+     * @brief read the string starting at an opening quote
+     *
+     * @param index the index of the opening quote
+     * @param keep whether unescaped strings have to stay valid
+     * @return std::string_view the string
+     */
+    std::string_view string_at(size_t index, bool keep) const;
+
+public:
+    /**
+     * @brief Construct a new LazyDocument
+     * @throws InvalidFormatException if a string of the text is broken
+     *
+     * @param text the JSON text
+     * @param isa the instruction set used to index the text
+     */
+    explicit LazyDocument(std::string_view text, Isa isa = detected_isa());
+
+    LazyDocument(const LazyDocument&) = delete;
+    LazyDocument& operator=(const LazyDocument&) = delete;
+
+    /**
+     * @brief Get the root value
+     * @throws InvalidFormatException if the text is empty
+     *
+     * @return LazyValue the root value
+     */
+    LazyValue root() const;
+
+    /**
+     * @brief Get a member of the root Object
+     * @see LazyValue::operator[]
+     */
+    LazyValue operator[](std::string_view key) const {
+        return root()[key];
+    }
+
+    /**
+     * @brief Get an element of the root List
+     * @see LazyValue::operator[]
+     */
+    LazyValue operator[](size_t index) const {
+        return root()[index];
+    }
+};
+
+} // namespace JSONJay
@@ -2,8 +2,8 @@
  * @file List.hpp
  * @author TL044CN
  * @brief  List class header file
- * @version 0.3
- * @date 2024-04-25
+ * @version 0.4
+ * @date 2026-10-16
  *
  * @copyright Copyright (c) 2024
  *
@@ -13,12 +13,18 @@
 
 #include "Common.hpp"
 #include "Exceptions.hpp"
+#include "Value.hpp"
+#include "Result.hpp"
+#include "ScalarArray.hpp"
 
-#include <variant>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <concepts>
 #include <type_traits>
+#include <memory_resource>
+#include <optional>
+#include <span>
 
 namespace JSONJay {
 
@@ -27,26 +33,163 @@ namespace JSONJay {
  * @brief List class
  * @details The List class is used to store a list of values. The values can be
  *          any of the supported data types.
+ *          Lists that only hold ints, doubles or bools store them as a plain
+ *          contiguous array, see ints(), doubles() and bools(). The first
+ *          element of another type moves them into Value storage, where they
+ *          stay until the List is cleared. Iterating, find() and operator[]
+ *          hand out Elements, which work on either storage.
  * @see IsValidDataType
  * @see IsValidPtrDataType
  * @see BaseDataType
  */
 class List {
+public:
+    /**
+     * @brief The allocator used for the elements and nested nodes
+     */
+    using allocator_type = node_allocator_t;
+
 protected:
     /**
      * @brief The internal data type of the list
      */
-    using data_t = std::variant<std::string, int, double, bool, Object*, List*, std::monostate>;
+    using data_t = Value;
 
 private:
-    std::vector<data_t> mData;
+    std::pmr::vector<data_t> mData;
+    ScalarArray mScalars;
+    BaseDataType mElementType = BaseDataType::NONE;    ///< the type of all elements, NONE if empty
+    bool mMixed = false;                                ///< the elements have different types
 
 public:
     List() = default;
-    List(List&&) = default;
+    List(List&& other) noexcept;
+
+    /**
+     * @brief Construct a new List that allocates from an allocator
+     *
+     * @param allocator the allocator for elements and nested nodes
+     */
+    explicit List(const allocator_type& allocator);
+
+    /**
+     * @brief Move a List into a possibly different allocator
+     * @details Nested nodes are relocated if the allocators differ.
+     *
+     * @param other     the List to move from
+     * @param allocator the allocator of the new List
+     */
+    List(List&& other, const allocator_type& allocator);
+
     ~List();
 
 private:
+    /**
+     * @brief take ownership of a node allocated with new
+     * @details The node is relocated if this List does not allocate from
+     *          the new/delete resource.
+     *
+     * @tparam T the type of the node
+     * @param node the node
+     * @return T* the node owned by this List
+     */
+    template<typename T>
+        requires IsValidPtrDataType<T>
+    T* adopt(T* node) {
+        if ( node == nullptr || get_allocator().resource() == std::pmr::new_delete_resource() )
+            return node;
+        T* adopted = new_node<T>(get_allocator(), std::move(*node));
+        delete node;
+        return adopted;
+    }
+
+    /**
+     * @brief whether the elements live in the scalar array
+     */
+    bool typed() const noexcept {
+        return !mMixed && (mElementType == BaseDataType::INT || mElementType == BaseDataType::DOUBLE
+                           || mElementType == BaseDataType::BOOL);
+    }
+
+    /**
+     * @brief whether T is stored in the scalar array of homogeneous Lists
+     */
+    template<typename T>
+    static constexpr bool kScalar = std::is_same_v<T, int> || std::is_same_v<T, double> || std::is_same_v<T, bool>;
+
+    /**
+     * @brief move the elements of the scalar array into Value storage
+     */
+    void to_values();
+
+    /**
+     * @brief record the type of a new element stored as a Value
+     * @details Moves typed elements into Value storage first.
+     *
+     * @param type the type of the new element
+     */
+    void note_value(BaseDataType type);
+
+    /**
+     * @brief insert a value, into the scalar array if it fits there
+     *
+     * @tparam T the type of the value
+     * @param index the position of the new element
+     * @param value the value
+     */
+    template<typename T>
+        requires IsValidDataType<T>
+    void insert_element(size_t index, const T& value) {
+        if constexpr ( kScalar<T> ) {
+            if ( mData.empty() && !mMixed && (mElementType == BaseDataType::NONE || mElementType == data_t::type_of<T>()) ) {
+                mElementType = data_t::type_of<T>();
+                mScalars.insert<T>(index, value);
+                return;
+            }
+        }
+        insert_value(index, make_element(value));
+    }
+
+    /**
+     * @brief insert an element into Value storage
+     * @details The element is destroyed if it cannot be inserted.
+     *
+     * @param index the position of the new element
+     * @param element the element
+     */
+    void insert_value(size_t index, data_t element);
+
+    /**
+     * @brief reset the element type once the List is empty
+     */
+    void forget_type_if_empty() noexcept;
+
+    /**
+     * @brief move the elements of another List to the end of this one
+     * @details Strings and nested nodes are not relocated, they stay in the
+     *          memory of the other List. Only used by Document::append,
+     *          which keeps that memory alive.
+     *
+     * @param other the List to take the elements from
+     */
+    void absorb(List& other);
+
+    friend class Document;
+
+    /**
+     * @brief turn a value into an element owned by this List
+     *
+     * @tparam T the type of the value
+     * @param value the value
+     * @return data_t the element
+     */
+    template<typename T>
+        requires IsValidDataType<T>
+    data_t make_element(const T& value) {
+        if constexpr ( std::is_pointer_v<T> ) return data_t(adopt(value));
+        else return data_t::make(value, get_allocator());
+    }
+
     /**
      * @brief Check if the index is in bounds
      *
@@ -54,18 +197,128 @@ private:
      */
     void check_index(size_t index) const;
 
+public:
+    /**
+     * @brief Reference to an element of a List
+     * @details Reads and writes the element where it is stored, in the typed
+     *          array or as a Value, with the accessors of Value. Like other
+     *          references it is invalidated by inserting or erasing elements.
+     *
+     * @tparam Const whether the element is read only
+     */
+    template<bool Const>
+    class BasicElement {
+    private:
+        using list_t = std::conditional_t<Const, const List, List>;
+
+        list_t* mList;
+        size_t mIndex;
+
+        template<bool>
+        friend class BasicElement;
+
+    public:
+        BasicElement(list_t& list, size_t index) noexcept : mList(&list), mIndex(index) {}
+
+        /**
+         * @brief Construct a read only Element from a writable one
+         *
+         * @param other the writable Element
+         */
+        template<bool OtherConst>
+            requires (Const && !OtherConst)
+        BasicElement(const BasicElement<OtherConst>& other) noexcept : mList(other.mList), mIndex(other.mIndex) {}
+
+        /**
+         * @brief Get the type of the element
+         *
+         * @return BaseDataType the type
+         */
+        BaseDataType type() const {
+            return mList->get_type(mIndex);
+        }
+
+        /**
+         * @brief check if the element holds a type
+         *
+         * @tparam T the type to check
+         * @return true the element holds T
+         * @return false the element holds another type
+         */
+        template<typename T>
+            requires IsValidDataType<T>
+        bool holds() const {
+            return type() == data_t::type_of<T>();
+        }
+
+        /**
+         * @brief Get the string of a string element
+         *
+         * @return std::string_view the string, empty for other types
+         */
+        std::string_view as_string() const {
+            if ( mList->typed() ) return std::string_view();
+            return mList->mData[mIndex].as_string();
+        }
+
+        /**
+         * @brief Get the content of the element
+         * @throws InvalidTypeException if the element does not hold T
+         *
+         * @tparam T the type of the content
+         * @return the content, a copy for read only Elements
+         */
+        template<typename T>
+            requires IsValidDataType<T>
+        std::conditional_t<Const, value_copy_t<T>, value_reference_t<T>> get() const {
+            return mList->template at<T>(mIndex);
+        }
+
+        /**
+         * @brief Get a pointer to the content of the element
+         * @details Strings have no pointer to hand out, see as_string.
+         *
+         * @tparam T the type of the content
+         * @return the content or nullptr if the element does not hold T
+         */
+        template<typename T>
+            requires IsValidDataType<T> && (!std::is_same_v<T, std::string>) && (!std::is_same_v<T, std::monostate>)
+        std::conditional_t<Const, const T*, T*> get_if() const noexcept {
+            List& list = const_cast<List&>(*mList);
+            if ( list.typed() ) {
+                if constexpr ( kScalar<T> ) {
+                    if ( list.mElementType == data_t::type_of<T>() ) return list.mScalars.template data<T>() + mIndex;
+                }
+                return nullptr;
+            }
+            return list.mData[mIndex].template get_if<T>();
+        }
+    };
+
+    /**
+     * @brief Writable reference to an element of a List
+     */
+    using Element = BasicElement<false>;
+
+    /**
+     * @brief Read only reference to an element of a List
+     */
+    using ConstElement = BasicElement<true>;
+
+private:
     /**
      * @brief Iterator Class of the List
      */
     class Iterator {
     private:
-        std::vector<data_t>::iterator mIt;
+        List* mList;
+        size_t mIndex;
 
     public:
         using iterator_category = std::forward_iterator_tag;
-        using value_type = std::pair<data_t&, BaseDataType>;
+        using value_type = std::pair<Element, BaseDataType>;
 
-        explicit Iterator(std::vector<data_t>::iterator it);
+        Iterator(List& list, size_t index);
 
         Iterator& operator++();
         bool operator!=(const Iterator& other) const;
@@ -74,8 +327,17 @@ private:
 
 public:
 
+    /**
+     * @brief Get the allocator of the list
+     *
+     * @return allocator_type the allocator
+     */
+    allocator_type get_allocator() const;
+
     /**
      * @brief Get the begin iterator of the list
+     * @details The iterator hands out Elements and leaves the storage as it
+     *          is, ints(), doubles() and bools() still work afterwards.
      *
      * @return Iterator the begin iterator
      */
@@ -97,7 +359,7 @@ public:
     template<typename T>
         requires IsValidDataType<T>
     void push_back(T value) {
-        mData.push_back(data_t(value));
+        insert_element(size(), value);
     }
 
     /**
@@ -109,7 +371,8 @@ public:
     template<typename T>
         requires IsValidPtrDataType<T>
     void push_back(T&& value) {
-        mData.push_back(new T(std::move(value)));
+        note_value(data_t::type_of<T*>());
+        mData.push_back(data_t(new_node<T>(get_allocator(), std::move(value))));
     }
 
     /**
@@ -118,9 +381,126 @@ public:
      * @param value the string to push
      */
     void push_back(const char* value) {
-        mData.push_back(std::string(value));
+        note_value(BaseDataType::STRING);
+        mData.push_back(data_t(std::string_view(value), get_allocator()));
+    }
+
+    /**
+     * @brief Construct an element in place at the end of the list
+     *
+     * @tparam T the type of the element
+     * @param args the constructor arguments of the element
+     * @return value_reference_t<T> the new element
+     */
+    template<typename T, typename... Args>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    value_reference_t<T> emplace_back(Args&&... args) {
+        if constexpr ( kScalar<T> ) {
+            insert_element(size(), T(std::forward<Args>(args)...));
+            return at<T>(size() - 1);
+        } else if constexpr ( IsValidPtrDataType<T> ) {
+            T* node = new_node<T>(get_allocator(), std::forward<Args>(args)...);
+            insert_value(size(), data_t(node));
+            return *node;
+        } else if constexpr ( std::is_same_v<T, std::string> ) {
+            insert_value(size(), data_t(std::string_view(std::forward<Args>(args)...), get_allocator()));
+            return mData.back().as_string();
+        } else {
+            insert_value(size(), data_t());
+            return std::monostate();
+        }
     }
 
+    /**
+     * @brief make room for a number of elements
+     *
+     * @param count the number of elements
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Get the type shared by all elements
+     *
+     * @return BaseDataType the type, NONE if the list is empty or mixed
+     */
+    BaseDataType element_type() const noexcept {
+        return mMixed ? BaseDataType::NONE : mElementType;
+    }
+
+    /**
+     * @brief Get the elements of a list of integers
+     * @throws InvalidTypeException if the list holds anything but integers
+     *
+     * @return std::span<const int> the integers
+     */
+    std::span<const int> ints() const;
+
+    /**
+     * @brief Get the elements of a list of doubles
+     * @throws InvalidTypeException if the list holds anything but doubles
+     *
+     * @return std::span<const double> the doubles
+     */
+    std::span<const double> doubles() const;
+
+    /**
+     * @brief Get the elements of a list of booleans
+     * @throws InvalidTypeException if the list holds anything but booleans
+     *
+     * @return std::span<const bool> the booleans
+     */
+    std::span<const bool> bools() const;
+
+    /**
+     * @brief Get the elements of a list of strings
+     * @details Every Value holds a string, read them with Value::as_string.
+     * @throws InvalidTypeException if the list holds anything but strings
+     *
+     * @return std::span<const data_t> the strings
+     */
+    std::span<const data_t> strings() const;
+
+    /**
+     * @brief Get the elements held as Values
+     * @details Empty while the list stores its scalars in the plain array,
+     *          that is while element_type() is INT, DOUBLE or BOOL.
+     *
+     * @return std::span<const data_t> the elements
+     */
+    std::span<const data_t> values() const noexcept {
+        return std::span<const data_t>(mData.data(), mData.size());
+    }
+
+    /**
+     * @brief Get the elements of a list of integers
+     * @throws InvalidTypeException if the list holds anything but integers
+     *
+     * @return std::span<int> the integers
+     */
+    std::span<int> ints();
+
+    /**
+     * @brief Get the elements of a list of doubles
+     * @throws InvalidTypeException if the list holds anything but doubles
+     *
+     * @return std::span<double> the doubles
+     */
+    std::span<double> doubles();
+
+    /**
+     * @brief Get the elements of a list of booleans
+     * @throws InvalidTypeException if the list holds anything but booleans
+     *
+     * @return std::span<bool> the booleans
+     */
+    std::span<bool> bools();
+
+    /**
+     * @brief Turn a list of numbers into a homogeneous list of doubles
+     * @throws InvalidTypeException if the list holds something other than numbers
+     */
+    void convert_to_doubles();
+
     /**
      * @brief Get the size of the list
      *
@@ -132,47 +512,137 @@ public:
      * @brief Access an element of the list
      *
      * @param index the index of the element
-     * @return const data_t& the element
+     * @return value_reference_t<T> the element
      */
     template<typename T>
         requires IsValidDataType<T> || IsValidPtrDataType<T>
-    T & at(size_t index) {
+    value_reference_t<T> at(size_t index) {
         check_index(index);
-        if constexpr ( IsValidPtrDataType<T> ) {
-            if ( !std::holds_alternative<T*>(mData[index]) )
-                throw InvalidTypeException("Invalid type");
-            return *std::get<T*>(mData.at(index));
-        } else {
-            if ( !std::holds_alternative<T>(mData[index]) )
-                throw InvalidTypeException("Invalid type");
-            return std::get<T>(mData.at(index));
+        if ( typed() ) {
+            if constexpr ( kScalar<T> ) {
+                if ( mElementType == data_t::type_of<T>() ) return mScalars.data<T>()[index];
+            }
+            throw InvalidTypeException("Invalid type");
         }
+        if constexpr ( IsValidPtrDataType<T> ) return *mData[index].get<T*>();
+        else return mData[index].get<T>();
     }
 
     /**
-     * @brief Access an element of the list
+     * @brief Read an element of the list
+     * @throws InvalidTypeException if the element does not hold T
      *
+     * @tparam T the type of the element
      * @param index the index of the element
-     * @return data_t& the element
+     * @return value_copy_t<T> a copy of the element, a view for strings
      */
-    const data_t& operator[](size_t index) const {
+    template<typename T>
+        requires IsValidDataType<T>
+    value_copy_t<T> at(size_t index) const {
         check_index(index);
-        return mData[index];
+        if ( typed() ) {
+            if constexpr ( kScalar<T> ) {
+                if ( mElementType == data_t::type_of<T>() ) return mScalars.span<T>()[index];
+            }
+            throw InvalidTypeException("Invalid type");
+        }
+        return mData[index].get<T>();
     }
 
+    /**
+     * @brief Access an element of the list
+     *
+     * @param index the index of the element
+     * @return ConstElement the element
+     */
+    ConstElement operator[](size_t index) const;
+
+    /**
+     * @brief Get a copy of an element of the list
+     * @details Strings of the copy may point into the copy itself, keep it
+     *          alive while using them.
+     *
+     * @param index the index of the element
+     * @return data_t a copy of the element
+     */
+    data_t value_at(size_t index) const;
+
     /**
      * @brief Access an element of the list
      *
      * @tparam T the type of the element
      * @param index the index of the element
-     * @return const T& the element
+     * @return value_reference_t<T> the element
      */
     template <typename T>
         requires IsValidDataType<T> || IsValidPtrDataType<T>
-    T & operator[](size_t index) {
+    value_reference_t<T> operator[](size_t index) {
         return at<T>(index);
     }
 
+    /**
+     * @brief Find an element
+     * @details An index out of bounds yields no element.
+     *
+     * @param index the index of the element
+     * @return std::optional<Element> the element
+     */
+    std::optional<Element> find(size_t index);
+
+    /**
+     * @brief Get a pointer to an element if it exists and has the type T
+     * @details Works like std::get_if: never throws. Strings have no pointer
+     *          to hand out, use try_get<std::string> for them.
+     *
+     * @tparam T int, double, bool, Object or List
+     * @param index the index of the element
+     * @return T* the element or nullptr
+     */
+    template<typename T>
+        requires (IsValidDataType<T> && !std::is_pointer_v<T> && !std::is_same_v<T, std::string>) || IsValidPtrDataType<T>
+    T* get_if(size_t index) noexcept {
+        if ( index >= size() ) return nullptr;
+        if ( typed() ) {
+            if constexpr ( kScalar<T> ) {
+                if ( mElementType == data_t::type_of<T>() ) return mScalars.data<T>() + index;
+            }
+            return nullptr;
+        }
+        data_t* element = &mData[index];
+        if constexpr ( IsValidPtrDataType<T> ) {
+            T** node = element->get_if<T*>();
+            return node == nullptr ? nullptr : *node;
+        } else {
+            return element->get_if<T>();
+        }
+    }
+
+    /**
+     * @brief Get an element without throwing
+     * @details An index out of bounds yields LookupError::INVALID_INDEX, an
+     *          element of another type LookupError::INVALID_TYPE.
+     *
+     * @tparam T the type of the element
+     * @param index the index of the element
+     * @return Result<value_reference_t<T>> the element or the error
+     */
+    template<typename T>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    Result<value_reference_t<T>> try_get(size_t index) noexcept {
+        using Stored = std::conditional_t<IsValidPtrDataType<T>, T*, T>;
+        if ( index >= size() ) return LookupError::INVALID_INDEX;
+        if ( typed() ) {
+            if constexpr ( kScalar<T> ) {
+                if ( mElementType == data_t::type_of<T>() ) return mScalars.data<T>()[index];
+            }
+            return LookupError::INVALID_TYPE;
+        }
+        data_t* element = &mData[index];
+        if ( !element->holds<Stored>() ) return LookupError::INVALID_TYPE;
+        if constexpr ( IsValidPtrDataType<T> ) return *element->get<T*>();
+        else return element->get<T>();
+    }
+
     /**
      * @brief Clear the list
      */
@@ -204,7 +674,7 @@ public:
         requires IsValidDataType<T>
     void insert(size_t index, T value) {
         check_index(index);
-        mData.insert(mData.begin() + index, value);
+        insert_element(index, value);
     }
 
     /**
@@ -218,7 +688,8 @@ public:
         requires IsValidPtrDataType<T>
     void insert(size_t index, T&& value) {
         check_index(index);
-        mData.insert(mData.begin() + index, new T(std::move(value)));
+        note_value(data_t::type_of<T*>());
+        mData.insert(mData.begin() + index, data_t(new_node<T>(get_allocator(), std::move(value))));
     }
 
     /**
@@ -229,22 +700,17 @@ public:
      */
     inline BaseDataType get_type(size_t index) const {
         check_index(index);
-        
-        // This is a hack to remove the const qualifier.
-        // This is safe because we are not modifying the data.
-        auto& nonConstData = const_cast<std::vector<data_t>&>(mData);
-        auto& nonConstElement = nonConstData.at(index);
-
-        return JSONJay::get_type(nonConstElement);
+        if ( typed() ) return mElementType;
+        return JSONJay::get_type(mData[index]);
     }
 
     /**
      * @brief Get a string from the list
      *
      * @param index the index of the string
-     * @return std::string the string
+     * @return std::string_view the string
      */
-    std::string& get_string(size_t index);
+    std::string_view get_string(size_t index);
 
     /**
      * @brief Get an integer from the list
@@ -286,6 +752,27 @@ public:
      */
     List& get_list(size_t index);
 
+    /**
+     * @brief write a List in the binary encoding
+     * @details Lets Lists take part in StreamWritinator::writeSerializable.
+     * @see BinaryWriter
+     *
+     * @param writer the stream to write to
+     * @param list the List
+     */
+    static void serialize(StreamWritinator* writer, const List& list);
+
+    /**
+     * @brief read a List in the binary encoding
+     * @details Lets Lists take part in StreamReadinator::readDeserializable.
+     * @throws InvalidFormatException if the data is not a valid encoding
+     * @see BinaryReader
+     *
+     * @param reader the stream to read from
+     * @param list the List to add the elements to
+     */
+    static void deserialize(StreamReadinator* reader, List& list);
+
 };
 
 } // namespace JSONJay
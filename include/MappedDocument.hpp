@@ -0,0 +1,368 @@
+/**
+ * @file MappedDocument.hpp
+ * @author TL044CN
+ * @brief MappedDocument class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace JSONJay {
+
+class MappedDocument;
+class MappedObject;
+class MappedList;
+
+/**
+ * @ingroup Serialization
+ * @brief a read-only view of one value of a MappedDocument
+ * @details Ints and bools are held by the view itself, everything else is
+ *          read from the image on access.
+ * @see MappedDocument
+ */
+class MappedValue {
+private:
+    const MappedDocument* mDocument;
+    BaseDataType mType;
+    uint32_t mData;     ///< the value of ints and bools, the offset of anything else
+
+    friend class MappedDocument;
+    friend class MappedObject;
+    friend class MappedList;
+
+    MappedValue(const MappedDocument* document, BaseDataType type, uint32_t data) noexcept
+        : mDocument(document), mType(type), mData(data) {}
+
+public:
+    /**
+     * @brief Get the type of the value
+     *
+     * @return BaseDataType the type
+     */
+    BaseDataType type() const noexcept {
+        return mType;
+    }
+
+    /**
+     * @brief check if the value is null
+     *
+     * @return true the value is null
+     * @return false the value is not null
+     */
+    bool is_null() const noexcept {
+        return mType == BaseDataType::NONE;
+    }
+
+    /**
+     * @brief Get a string
+     * @details The view points into the image.
+     * @throws InvalidTypeException if the value is no string
+     * @throws InvalidFormatException if the string lies outside of the image
+     *
+     * @return std::string_view the string
+     */
+    std::string_view get_string() const;
+
+    /**
+     * @brief Get an integer
+     * @throws InvalidTypeException if the value is no integer
+     *
+     * @return int the integer
+     */
+    int get_int() const;
+
+    /**
+     * @brief Get a double
+     * @throws InvalidTypeException if the value is no double
+     * @throws InvalidFormatException if the double lies outside of the image
+     *
+     * @return double the double
+     */
+    double get_double() const;
+
+    /**
+     * @brief Get a boolean
+     * @throws InvalidTypeException if the value is no boolean
+     *
+     * @return bool the boolean
+     */
+    bool get_bool() const;
+
+    /**
+     * @brief Get the value as an Object
+     * @throws InvalidTypeException if the value is no Object
+     * @throws InvalidFormatException if the Object lies outside of the image
+     *
+     * @return MappedObject the Object
+     */
+    MappedObject as_object() const;
+
+    /**
+     * @brief Get the value as a List
+     * @throws InvalidTypeException if the value is no List
+     * @throws InvalidFormatException if the List lies outside of the image
+     *
+     * @return MappedList the List
+     */
+    MappedList as_list() const;
+
+    /**
+     * @brief Get a member of an Object
+     * @see MappedObject::operator[]
+     */
+    MappedValue operator[](std::string_view key) const;
+
+    /**
+     * @brief Get an element of a List
+     * @see MappedList::operator[]
+     */
+    MappedValue operator[](size_t index) const;
+};
+
+/**
+ * @ingroup Serialization
+ * @brief a read-only view of an Object of a MappedDocument
+ * @details The members are sorted by key, lookups are binary searches over
+ *          the key table of the Object.
+ * @see MappedDocument
+ */
+class MappedObject {
+private:
+    const MappedDocument* mDocument;
+    uint32_t mOffset;   ///< the offset of the first entry
+    uint32_t mCount;
+
+    friend class MappedValue;
+
+    MappedObject(const MappedDocument* document, uint32_t offset);
+
+    /**
+     * @brief get the key of an entry without checking the index
+     */
+    std::string_view key_at(size_t index) const;
+
+public:
+    /**
+     * @brief Get the number of members
+     *
+     * @return size_t the number of members
+     */
+    size_t size() const noexcept {
+        return mCount;
+    }
+
+    /**
+     * @brief check if the Object is empty
+     *
+     * @return true the Object has no members
+     * @return false the Object has members
+     */
+    bool empty() const noexcept {
+        return mCount == 0;
+    }
+
+    /**
+     * @brief check if the Object has a key
+     *
+     * @param key the key
+     * @return true the key exists
+     * @return false the key does not exist
+     */
+    bool contains(std::string_view key) const;
+
+    /**
+     * @brief Get the value under a key
+     * @throws InvalidKeyException if the key does not exist
+     *
+     * @param key the key
+     * @return MappedValue the value
+     */
+    MappedValue operator[](std::string_view key) const;
+
+    /**
+     * @brief Get the key of the member at a position in key order
+     * @throws InvalidIndexException if the index is out of bounds
+     *
+     * @param index the position of the member
+     * @return std::string_view the key
+     */
+    std::string_view key(size_t index) const;
+
+    /**
+     * @brief Get the value of the member at a position in key order
+     * @throws InvalidIndexException if the index is out of bounds
+     *
+     * @param index the position of the member
+     * @return MappedValue the value
+     */
+    MappedValue value(size_t index) const;
+};
+
+/**
+ * @ingroup Serialization
+ * @brief a read-only view of a List of a MappedDocument
+ * @details Lists that held only ints, doubles or bools are stored packed and
+ *          aligned, their elements can be used in place through the spans.
+ * @see MappedDocument
+ */
+class MappedList {
+private:
+    const MappedDocument* mDocument;
+    uint32_t mOffset;   ///< the offset of the first element
+    uint32_t mCount;
+    BaseDataType mElementType;
+
+    friend class MappedValue;
+
+    MappedList(const MappedDocument* document, uint32_t offset);
+
+public:
+    /**
+     * @brief Get the number of elements
+     *
+     * @return size_t the number of elements
+     */
+    size_t size() const noexcept {
+        return mCount;
+    }
+
+    /**
+     * @brief check if the List is empty
+     *
+     * @return true the List has no elements
+     * @return false the List has elements
+     */
+    bool empty() const noexcept {
+        return mCount == 0;
+    }
+
+    /**
+     * @brief Get the type of the packed elements
+     *
+     * @return BaseDataType INT, DOUBLE or BOOL for packed Lists, NONE otherwise
+     */
+    BaseDataType element_type() const noexcept {
+        return mElementType;
+    }
+
+    /**
+     * @brief Get an element
+     * @throws InvalidIndexException if the index is out of bounds
+     *
+     * @param index the index of the element
+     * @return MappedValue the element
+     */
+    MappedValue operator[](size_t index) const;
+
+    /**
+     * @brief Get the elements of a packed List of integers
+     * @throws InvalidTypeException if the List holds anything but integers
+     *
+     * @return std::span<const int> the integers
+     */
+    std::span<const int> ints() const;
+
+    /**
+     * @brief Get the elements of a packed List of doubles
+     * @throws InvalidTypeException if the List holds anything but doubles
+     *
+     * @return std::span<const double> the doubles
+     */
+    std::span<const double> doubles() const;
+
+    /**
+     * @brief Get the elements of a packed List of booleans
+     * @throws InvalidTypeException if the List holds anything but booleans
+     * @throws InvalidFormatException if a byte is no valid boolean
+     *
+     * @return std::span<const bool> the booleans
+     */
+    std::span<const bool> bools() const;
+};
+
+/**
+ * @ingroup Serialization
+ * @brief MappedDocument class
+ * @details Reads an image written by MappedWriter in place, without
+ *          deserializing it. Opening a document only checks its header, so
+ *          it takes the same time for any size, and an image in a shared
+ *          file mapping is shared by every process that maps it:
+ *          @code
+ *          MappedDocument document(image);
+ *          int id = document["users"][0]["id"].get_int();
+ *          @endcode
+ *          Offsets are checked against the image as they are followed.
+ *          The image is not copied, it has to outlive the document and all
+ *          views into it and has to be aligned to 8 bytes.
+ * @see MappedWriter
+ */
+class MappedDocument {
+private:
+    std::span<const char> mImage;
+    BaseDataType mRootType;
+    uint32_t mRoot;
+
+    friend class MappedValue;
+    friend class MappedObject;
+    friend class MappedList;
+
+    /**
+     * @brief get a node of the image
+     * @throws InvalidFormatException if the node lies outside of the image
+     *         or is misaligned
+     *
+     * @tparam T the type of the node
+     * @param offset the offset of the node
+     * @param count the number of consecutive nodes
+     * @return const T* the first node
+     */
+    template<typename T>
+    const T* at(uint64_t offset, uint64_t count = 1) const;
+
+public:
+    /**
+     * @brief Construct a new MappedDocument
+     * @throws InvalidFormatException if the image has no valid header, was
+     *         written on a host of other byte order or is misaligned
+     *
+     * @param image the image
+     */
+    explicit MappedDocument(std::span<const char> image);
+
+    /**
+     * @brief Get the root value
+     *
+     * @return MappedValue the root Object or List
+     */
+    MappedValue root() const noexcept {
+        return MappedValue(this, mRootType, mRoot);
+    }
+
+    /**
+     * @brief Get a member of the root Object
+     * @see MappedValue::operator[]
+     */
+    MappedValue operator[](std::string_view key) const {
+        return root()[key];
+    }
+
+    /**
+     * @brief Get an element of the root List
+     * @see MappedValue::operator[]
+     */
+    MappedValue operator[](size_t index) const {
+        return root()[index];
+    }
+};
+
+} // namespace JSONJay
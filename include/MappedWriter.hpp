@@ -0,0 +1,118 @@
+/**
+ * @file MappedWriter.hpp
+ * @author TL044CN
+ * @brief MappedWriter class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Document.hpp"
+#include "List.hpp"
+#include "Object.hpp"
+#include "StreamWritinator.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Serialization
+ * @brief MappedWriter class
+ * @details Writes Objects and Lists as an image that MappedDocument reads in
+ *          place, for example straight out of a file mapping. Nodes refer to
+ *          each other by offsets, the members of every Object are sorted by
+ *          key and Lists in typed storage are written as aligned arrays.
+ *          The image is in host byte order and at most 4 GiB large. It is
+ *          assembled in a buffer that is kept between writes and handed to
+ *          the stream in one piece.
+ * @see MappedDocument
+ */
+class MappedWriter {
+private:
+    std::vector<char> mImage;
+
+    /**
+     * @brief reserve aligned space at the end of the image
+     * @throws InvalidValueException if the image grows to 4 GiB
+     *
+     * @param size the number of bytes
+     * @param alignment the alignment of the space
+     * @return uint32_t the offset of the space
+     */
+    uint32_t reserve(size_t size, size_t alignment);
+
+    /**
+     * @brief copy bytes into the image
+     *
+     * @param offset where to copy to
+     * @param data the bytes
+     * @param size the number of bytes
+     */
+    void store(uint32_t offset, const void* data, size_t size) {
+        std::memcpy(mImage.data() + offset, data, size);
+    }
+
+    uint32_t write_string(std::string_view string);
+    uint32_t write_object(const Object& object);
+    uint32_t write_list(const List& list);
+
+    template<typename T>
+    uint32_t write_scalars(std::span<const T> values);
+
+    /**
+     * @brief write a value
+     *
+     * @param value the value
+     * @param type where to store the type of the value
+     * @param data where to store the data of the value
+     */
+    void write_value(const Value& value, uint32_t& type, uint32_t& data);
+
+    template<typename Write>
+    bool run(StreamWritinator& stream, BaseDataType rootType, Write&& write);
+
+public:
+    /**
+     * @brief write an Object as a mapped document
+     * @throws InvalidValueException if the image would be 4 GiB or larger
+     *
+     * @param stream the stream to write to
+     * @param object the Object
+     * @return true the image was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const Object& object);
+
+    /**
+     * @brief write a List as a mapped document
+     * @throws InvalidValueException if the image would be 4 GiB or larger
+     *
+     * @param stream the stream to write to
+     * @param list the List
+     * @return true the image was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const List& list);
+
+    /**
+     * @brief write the root of a Document as a mapped document
+     * @throws InvalidValueException if the image would be 4 GiB or larger
+     *
+     * @param stream the stream to write to
+     * @param document the Document
+     * @return true the image was written
+     * @return false the stream failed
+     */
+    bool write(StreamWritinator& stream, const Document& document);
+};
+
+} // namespace JSONJay
@@ -0,0 +1,298 @@
+/**
+ * @file MemberStore.hpp
+ * @author TL044CN
+ * @brief MemberStore class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+#include "Value.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup StorageClasses
+ * @brief incremental hash of an Object key
+ * @details 64 bit FNV-1a folded down to 32 bits. Feeding the key one
+ *          character at a time lets callers validate it in the same pass.
+ */
+struct KeyHasher {
+    uint64_t state = 0xcbf29ce484222325ull;
+
+    /**
+     * @brief add a character to the hash
+     *
+     * @param c the character
+     */
+    constexpr void update(char c) noexcept {
+        state ^= static_cast<unsigned char>(c);
+        state *= 0x100000001b3ull;
+    }
+
+    /**
+     * @brief get the hash of all characters added so far
+     *
+     * @return uint32_t the hash
+     */
+    constexpr uint32_t finish() const noexcept {
+        return static_cast<uint32_t>(state ^ (state >> 32));
+    }
+};
+
+/**
+ * @ingroup StorageClasses
+ * @brief hash a key of an Object
+ *
+ * @param key the key
+ * @return uint32_t the hash of the key
+ */
+constexpr uint32_t hash_key(std::string_view key) noexcept {
+    KeyHasher hasher;
+    for ( char c : key ) hasher.update(c);
+    return hasher.finish();
+}
+
+/**
+ * @ingroup StorageClasses
+ * @brief MemberStore class
+ * @details Flat key-value storage of an Object. The members are kept in a
+ *          vector sorted by key, whatever the size of the store, so they are
+ *          always iterated in key order. Small stores look them up by binary
+ *          search. Once a store reaches kHashThreshold members it adds an
+ *          open addressing index with the stored hashes of the keys, and
+ *          drops it again when it shrinks below half of that.
+ *          Keys are copied into memory of the store's allocator. Values are
+ *          owned by the Object: the store never destroys them.
+ * @warning Pointers to members are invalidated by every insertion and
+ *          erasure.
+ * @see Object
+ */
+class MemberStore {
+public:
+    /**
+     * @brief The allocator used for the members and keys
+     */
+    using allocator_type = node_allocator_t;
+
+    /**
+     * @brief the size at which the store switches to the hash index
+     */
+    static constexpr size_t kHashThreshold = 16;
+
+    /**
+     * @brief A key-value pair of the store
+     */
+    struct Member {
+        const char* keyData;
+        uint32_t    keySize;
+        uint32_t    hash;
+        Value       value;
+
+        /**
+         * @brief Get the key of the member
+         *
+         * @return std::string_view the key
+         */
+        std::string_view key() const noexcept {
+            return std::string_view(keyData, keySize);
+        }
+    };
+
+private:
+    /**
+     * @brief A slot of the hash index
+     * @details index is one past the position of the member, 0 marks an
+     *          empty slot.
+     */
+    struct Slot {
+        uint32_t hash;
+        uint32_t index;
+    };
+
+    std::pmr::vector<Member> mMembers;
+    std::pmr::vector<Slot> mSlots;
+
+public:
+    MemberStore() = default;
+    MemberStore(MemberStore&&) = default;
+
+    /**
+     * @brief Construct an empty store that allocates from an allocator
+     *
+     * @param allocator the allocator
+     */
+    explicit MemberStore(const allocator_type& allocator);
+
+    /**
+     * @brief Move a store into a possibly different allocator
+     * @details Keys and values are relocated if the allocators differ.
+     *
+     * @param other     the store to move from
+     * @param allocator the allocator of the new store
+     */
+    MemberStore(MemberStore&& other, const allocator_type& allocator);
+
+    MemberStore(const MemberStore&) = delete;
+    MemberStore& operator=(const MemberStore&) = delete;
+    MemberStore& operator=(MemberStore&&) = delete;
+
+    ~MemberStore();
+
+private:
+    /**
+     * @brief whether the hash index is in use
+     */
+    bool hashed() const noexcept {
+        return !mSlots.empty();
+    }
+
+    /**
+     * @brief find the position of a key in the sorted members
+     *
+     * @param key the key
+     * @return size_t the first position not less than the key
+     */
+    size_t lower_bound(std::string_view key) const noexcept;
+
+    /**
+     * @brief find the slot of a key in the hash index
+     *
+     * @param key the key
+     * @param hash the hash of the key
+     * @return size_t the slot holding the key or the empty slot ending the probe
+     */
+    size_t probe(std::string_view key, uint32_t hash) const noexcept;
+
+    /**
+     * @brief find the slot pointing at a member
+     *
+     * @param index the position of the member
+     * @return size_t the slot
+     */
+    size_t slot_of(size_t index) const noexcept;
+
+    /**
+     * @brief build the hash index for the current members
+     *
+     * @param capacity the number of slots, a power of two
+     */
+    void rehash(size_t capacity);
+
+    /**
+     * @brief drop the hash index
+     */
+    void unhash();
+
+    /**
+     * @brief copy a key into memory of the store
+     *
+     * @param key the key
+     * @param hash the hash of the key
+     * @return Member the new member holding an empty value
+     */
+    Member make_member(std::string_view key, uint32_t hash);
+
+    /**
+     * @brief release the key of a member
+     *
+     * @param member the member
+     */
+    void release_key(Member& member) noexcept;
+
+public:
+
+    /**
+     * @brief Get the allocator of the store
+     *
+     * @return allocator_type the allocator
+     */
+    allocator_type get_allocator() const;
+
+    /**
+     * @brief Get the number of members
+     *
+     * @return size_t the number of members
+     */
+    size_t size() const noexcept {
+        return mMembers.size();
+    }
+
+    /**
+     * @brief whether the store is empty
+     *
+     * @return true the store is empty
+     * @return false the store is not empty
+     */
+    bool empty() const noexcept {
+        return mMembers.empty();
+    }
+
+    /**
+     * @brief Find a member
+     *
+     * @param key the key
+     * @return Member* the member or nullptr if the key does not exist
+     */
+    Member* find(std::string_view key) noexcept;
+
+    /**
+     * @brief Find a member with a precomputed hash
+     *
+     * @param key the key
+     * @param hash the hash of the key, see hash_key
+     * @return Member* the member or nullptr if the key does not exist
+     */
+    Member* find(std::string_view key, uint32_t hash) noexcept;
+
+    /**
+     * @brief Find a member
+     *
+     * @param key the key
+     * @return const Member* the member or nullptr if the key does not exist
+     */
+    const Member* find(std::string_view key) const noexcept {
+        return const_cast<MemberStore*>(this)->find(key);
+    }
+
+    /**
+     * @brief Find a member or insert an empty one
+     *
+     * @param key the key
+     * @param hash the hash of the key, see hash_key
+     * @return std::pair<Member*, bool> the member and whether it was inserted
+     */
+    std::pair<Member*, bool> try_emplace(std::string_view key, uint32_t hash);
+
+    /**
+     * @brief Remove a member
+     * @note the value of the member has to be destroyed by the caller
+     *
+     * @param member the member, as returned by find
+     */
+    void erase(Member* member);
+
+    /**
+     * @brief Remove all members
+     * @note the values of the members have to be destroyed by the caller
+     */
+    void clear() noexcept;
+
+    Member* begin() noexcept { return mMembers.data(); }
+    Member* end() noexcept { return mMembers.data() + mMembers.size(); }
+    const Member* begin() const noexcept { return mMembers.data(); }
+    const Member* end() const noexcept { return mMembers.data() + mMembers.size(); }
+
+};
+
+} // namespace JSONJay
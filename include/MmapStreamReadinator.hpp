@@ -0,0 +1,168 @@
+/**
+ * @file MmapStreamReadinator.hpp
+ * @author TL044CN
+ * @brief This file contains the MmapStreamReadinator class declaration
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "StreamReadinator.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Serialization
+ * @brief how a mapped file is going to be read
+ */
+enum class MmapAdvice : uint8_t {
+    NORMAL,         ///< no particular order
+    SEQUENTIAL,     ///< front to back, pages are read ahead aggressively
+    RANDOM,         ///< in random order, no pages are read ahead
+    WILLNEED        ///< soon, all pages are read ahead right away
+};
+
+/**
+ * @ingroup Serialization
+ * @brief The MmapStreamReadinator class reads data from a memory mapped file
+ * @details The whole file is mapped read-only when the readinator is
+ *          constructed. Reads are plain copies out of the mapping, and the
+ *          mapped bytes can also be used in place through bytes(), for
+ *          example by a MappedDocument.
+ *          A file that cannot be opened or mapped leaves the stream bad.
+ */
+class MmapStreamReadinator final : public StreamReadinator, public ReadinatorHelpers<MmapStreamReadinator> {
+private:
+    const char* mData = nullptr;
+    uint64_t mSize = 0;
+    uint64_t mPosition = 0;
+    bool mGood = false;
+#ifdef _WIN32
+    void* mFile = nullptr;
+    void* mMapping = nullptr;
+#endif
+
+public:
+    // the helpers of the concrete type are bound statically
+    using ReadinatorHelpers<MmapStreamReadinator>::readBuffer;
+    using ReadinatorHelpers<MmapStreamReadinator>::readString;
+    using ReadinatorHelpers<MmapStreamReadinator>::readRaw;
+    using ReadinatorHelpers<MmapStreamReadinator>::readDeserializable;
+    using ReadinatorHelpers<MmapStreamReadinator>::readMap;
+    using ReadinatorHelpers<MmapStreamReadinator>::readVector;
+    using ReadinatorHelpers<MmapStreamReadinator>::readArray;
+
+    /**
+     * @brief Map a file
+     *
+     * @param filename the name of the file
+     * @param advice how the file is going to be read
+     */
+    explicit MmapStreamReadinator(const std::string& filename, MmapAdvice advice = MmapAdvice::SEQUENTIAL);
+    ~MmapStreamReadinator() override;
+
+    MmapStreamReadinator(const MmapStreamReadinator&) = delete;
+    MmapStreamReadinator& operator=(const MmapStreamReadinator&) = delete;
+
+    bool isStreamGood() const override;
+    uint64_t getStreamPosition() override;
+    void setStreamPosition(uint64_t position) override;
+    bool readData(char* data, uint64_t size) override {
+        if ( mPosition > mSize || size > mSize - mPosition ) {
+            mGood = false;
+            return false;
+        }
+        if ( size != 0 ) std::memcpy(data, mData + mPosition, size);
+        mPosition += size;
+        return true;
+    }
+
+    /**
+     * @brief reads an unsigned LEB128 varint from the stream
+     * @details Decodes the varint in place without copying it.
+     *
+     * @param value the number
+     * @return true read successful
+     * @return false read failed or the varint is longer than 64 bits
+     */
+    bool readVarint(uint64_t& value) override {
+        size_t size = mPosition < mSize ? decode_varint(mData + mPosition, mSize - mPosition, value) : 0;
+        if ( size == 0 ) {
+            mGood = false;
+            return false;
+        }
+        mPosition += size;
+        return true;
+    }
+
+    /**
+     * @brief reads up to a number of bytes from the stream
+     *
+     * @param data the buffer to read into
+     * @param size the size of the buffer
+     * @return uint64_t the number of bytes read, 0 at the end of the stream
+     */
+    uint64_t readSome(char* data, uint64_t size) override;
+
+    /**
+     * @brief reads data from the stream until a delimiter is found
+     * @details Searches the rest of the data in one go and appends the bytes
+     *          up to and including the delimiter at once.
+     *
+     * @param data the buffer to read into
+     * @param delim the delimiter to read until
+     * @return true the delimiter was found
+     * @return false the rest of the data was read without finding it
+     */
+    bool readUntil(std::vector<char>& data, char delim) override;
+
+    /**
+     * @brief reads data from the stream until a delimiter is found
+     * @see readUntil(std::vector<char>&, char)
+     */
+    bool readUntil(std::vector<char>& data, std::string delim) override;
+
+    /**
+     * @brief reads data up to a delimiter without copying it
+     * @details The view includes the delimiter and points into the mapping.
+     *
+     * @param view the bytes up to and including the delimiter, or the rest
+     *        of the data if it was not found
+     * @param delim the delimiter to read until
+     * @return true the delimiter was found
+     * @return false the rest of the data was read without finding it
+     */
+    bool readViewUntil(std::string_view& view, std::string_view delim);
+
+    /**
+     * @brief tell the system how the file is going to be read
+     * @details Only a hint, systems without it ignore it.
+     *
+     * @param advice how the file is going to be read
+     */
+    void advise(MmapAdvice advice);
+
+    /**
+     * @brief get the mapped bytes of the whole file
+     * @details The bytes are page aligned and stay valid as long as the
+     *          readinator. Empty and unmapped files have no bytes.
+     *
+     * @return std::span<const char> the bytes
+     */
+    std::span<const char> bytes() const noexcept {
+        return std::span<const char>(mData, mSize);
+    }
+
+};
+
+} // namespace JSONJay
@@ -0,0 +1,147 @@
+/**
+ * @file NDJSONReader.hpp
+ * @author TL044CN
+ * @brief NDJSONReader class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Document.hpp"
+#include "JSONParser.hpp"
+#include "StreamReadinator.hpp"
+#include "ThreadPool.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Parsing
+ * @brief the Documents parsed from one chunk of NDJSON text
+ */
+struct NDJSONBatch {
+    size_t index = 0;                   ///< the position of the chunk in the input
+    std::vector<Document> documents;    ///< one Document per non-empty line, in input order
+};
+
+/**
+ * @ingroup Parsing
+ * @brief the order in which batches are handed to the consumer
+ */
+enum class BatchOrder : uint8_t {
+    ORDERED,    ///< in input order
+    UNORDERED   ///< as soon as they are parsed
+};
+
+/**
+ * @ingroup Parsing
+ * @brief NDJSONReader class
+ * @details Reads newline delimited JSON, one Object or List per line. The
+ *          input is cut into chunks at line ends, the chunks are parsed on a
+ *          ThreadPool and the resulting batches are handed to a consumer on
+ *          the calling thread, so the consumer needs no locking.
+ *          At most two chunks per worker are in flight at a time, which
+ *          bounds the memory used for streams.
+ *          Empty lines are skipped.
+ * @note One read runs at a time per reader.
+ */
+class NDJSONReader {
+public:
+    /**
+     * @brief the default size of a chunk
+     */
+    static constexpr size_t kDefaultChunkSize = 1024 * 1024;
+
+    /**
+     * @brief the receiver of the parsed batches
+     */
+    using consumer_t = std::function<void(NDJSONBatch&)>;
+
+private:
+    ThreadPool mPool;
+    size_t mChunkSize;
+    std::vector<JSONParser> mParsers;   ///< one per worker
+
+    std::mutex mMutex;
+    std::condition_variable mReady;
+    std::map<size_t, NDJSONBatch> mDone;
+    size_t mInFlight = 0;
+    size_t mNextBatch = 0;
+    size_t mDelivered = 0;
+    bool mFailed = false;
+
+    /**
+     * @brief parse a chunk on the pool
+     *
+     * @param text the chunk, whole lines only
+     * @param owner keeps the memory of the chunk alive, may be empty
+     * @param index the position of the chunk in the input
+     */
+    void submit(std::string_view text, std::shared_ptr<const std::string> owner, size_t index);
+
+    /**
+     * @brief hand finished batches to the consumer
+     * @details Returns once at most limit chunks are in flight.
+     * @throws the first exception thrown while parsing
+     */
+    void deliver(const consumer_t& consumer, BatchOrder order, size_t limit);
+
+    void start();
+
+    /**
+     * @brief wait for the chunks in flight after an error
+     */
+    void settle() noexcept;
+
+    void read_chunks(std::string_view text, const consumer_t& consumer, BatchOrder order);
+    void read_chunks(StreamReadinator& reader, const consumer_t& consumer, BatchOrder order);
+
+public:
+    /**
+     * @brief Construct a new NDJSONReader
+     *
+     * @param threads the number of worker threads
+     * @param chunkSize the size of the chunks the input is cut into
+     */
+    explicit NDJSONReader(size_t threads = std::thread::hardware_concurrency(),
+        size_t chunkSize = kDefaultChunkSize);
+
+    /**
+     * @brief read NDJSON text from memory, for example a mapped file
+     * @details The chunks are parsed in place, the text is not copied.
+     * @throws InvalidFormatException if a line is not valid JSON
+     *
+     * @param text the text
+     * @param consumer the receiver of the batches
+     * @param order the order of the batches
+     * @return size_t the number of Documents read
+     */
+    size_t read(std::string_view text, const consumer_t& consumer, BatchOrder order = BatchOrder::ORDERED);
+
+    /**
+     * @brief read NDJSON text from a stream
+     * @throws InvalidFormatException if a line is not valid JSON
+     *
+     * @param reader the stream, read to its end
+     * @param consumer the receiver of the batches
+     * @param order the order of the batches
+     * @return size_t the number of Documents read
+     */
+    size_t read(StreamReadinator& reader, const consumer_t& consumer, BatchOrder order = BatchOrder::ORDERED);
+};
+
+} // namespace JSONJay
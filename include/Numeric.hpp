@@ -0,0 +1,218 @@
+/**
+ * @file Numeric.hpp
+ * @author TL044CN
+ * @brief vectorized kernels over numeric Lists
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+#include "Isa.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace JSONJay {
+
+class List;
+
+/**
+ * @defgroup Numeric Numeric kernels
+ * @brief reductions and transforms over numeric data
+ * @details Every kernel has an AVX2, an SSE2 and a scalar implementation.
+ *          The best one supported by the CPU is picked on first use.
+ *          Floating point sums are reassociated by the vector kernels and
+ *          may differ from a sequential sum in the last bits.
+ */
+namespace numeric {
+
+using JSONJay::Isa;
+using JSONJay::detected_isa;
+
+/**
+ * @ingroup Numeric
+ * @brief comparison applied by count_if
+ */
+enum class Compare : uint8_t {
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    EQUAL,
+    NOT_EQUAL
+};
+
+/**
+ * @ingroup Numeric
+ * @brief the smallest and the largest element of a range
+ */
+template<typename T>
+struct MinMax {
+    T min;
+    T max;
+};
+
+/**
+ * @ingroup Numeric
+ * @brief Get the instruction set the kernels currently use
+ *
+ * @return Isa the instruction set
+ */
+Isa active_isa() noexcept;
+
+/**
+ * @ingroup Numeric
+ * @brief Select the instruction set of the kernels
+ * @details Requests beyond what the CPU supports are lowered to the
+ *          detected instruction set. Mainly useful for testing.
+ *
+ * @param isa the requested instruction set
+ * @return Isa the instruction set now in use
+ */
+Isa set_isa(Isa isa) noexcept;
+
+/**
+ * @ingroup Numeric
+ * @brief Sum up doubles
+ *
+ * @param values the values
+ * @return double the sum
+ */
+double sum(std::span<const double> values) noexcept;
+
+/**
+ * @ingroup Numeric
+ * @brief Sum up integers without overflow
+ *
+ * @param values the values
+ * @return int64_t the sum
+ */
+int64_t sum(std::span<const int> values) noexcept;
+
+/**
+ * @ingroup Numeric
+ * @brief Find the smallest and the largest double
+ * @note the result is unspecified if the values contain NaN
+ * @throws InvalidValueException if there are no values
+ *
+ * @param values the values
+ * @return MinMax<double> the extremes
+ */
+MinMax<double> minmax(std::span<const double> values);
+
+/**
+ * @ingroup Numeric
+ * @brief Find the smallest and the largest integer
+ * @throws InvalidValueException if there are no values
+ *
+ * @param values the values
+ * @return MinMax<int> the extremes
+ */
+MinMax<int> minmax(std::span<const int> values);
+
+/**
+ * @ingroup Numeric
+ * @brief Count the doubles that compare true against a threshold
+ *
+ * @param values the values
+ * @param compare the comparison, applied as value <compare> threshold
+ * @param threshold the threshold
+ * @return size_t the number of matching values
+ */
+size_t count_if(std::span<const double> values, Compare compare, double threshold) noexcept;
+
+/**
+ * @ingroup Numeric
+ * @brief Count the integers that compare true against a threshold
+ *
+ * @param values the values
+ * @param compare the comparison, applied as value <compare> threshold
+ * @param threshold the threshold
+ * @return size_t the number of matching values
+ */
+size_t count_if(std::span<const int> values, Compare compare, int threshold) noexcept;
+
+/**
+ * @ingroup Numeric
+ * @brief Multiply doubles in place
+ *
+ * @param values the values
+ * @param factor the factor
+ */
+void scale(std::span<double> values, double factor) noexcept;
+
+/**
+ * @ingroup Numeric
+ * @brief Convert integers to doubles
+ * @throws InvalidValueException if the ranges differ in size
+ *
+ * @param values the integers
+ * @param out the doubles, as many as there are integers
+ */
+void convert(std::span<const int> values, std::span<double> out);
+
+/**
+ * @ingroup Numeric
+ * @brief Sum up the numbers of a List
+ * @details Homogeneous lists use the vector kernels, mixed lists of ints
+ *          and doubles are summed element by element.
+ * @throws InvalidTypeException if the list holds something other than numbers
+ *
+ * @param list the list
+ * @return double the sum
+ */
+double sum(const List& list);
+
+/**
+ * @ingroup Numeric
+ * @brief Get the mean of the numbers of a List
+ * @throws InvalidTypeException if the list holds something other than numbers
+ * @throws InvalidValueException if the list is empty
+ *
+ * @param list the list
+ * @return double the mean
+ */
+double mean(const List& list);
+
+/**
+ * @ingroup Numeric
+ * @brief Find the smallest and the largest number of a List
+ * @throws InvalidTypeException if the list holds something other than numbers
+ * @throws InvalidValueException if the list is empty
+ *
+ * @param list the list
+ * @return MinMax<double> the extremes
+ */
+MinMax<double> minmax(const List& list);
+
+/**
+ * @ingroup Numeric
+ * @brief Count the numbers of a List that compare true against a threshold
+ * @throws InvalidTypeException if the list holds something other than numbers
+ *
+ * @param list the list
+ * @param compare the comparison, applied as value <compare> threshold
+ * @param threshold the threshold
+ * @return size_t the number of matching values
+ */
+size_t count_if(const List& list, Compare compare, double threshold);
+
+/**
+ * @ingroup Numeric
+ * @brief Multiply the numbers of a List
+ * @details Lists of integers are converted to doubles first.
+ * @throws InvalidTypeException if the list holds something other than numbers
+ *
+ * @param list the list
+ * @param factor the factor
+ */
+void scale(List& list, double factor);
+
+} // namespace numeric
+
+} // namespace JSONJay
@@ -2,8 +2,8 @@
  * @file Object.hpp
  * @author TL044CN
  * @brief Object class header file
- * @version 0.3
- * @date 2024-04-25
+ * @version 0.4
+ * @date 2026-10-16
  *
  * @copyright Copyright (c) 2024
  *
@@ -13,10 +13,14 @@
 
 #include "Common.hpp"
 #include "Exceptions.hpp"
+#include "Value.hpp"
+#include "MemberStore.hpp"
+#include "Key.hpp"
+#include "Result.hpp"
 
-#include <variant>
 #include <string>
-#include <map>
+#include <string_view>
+#include <memory_resource>
 
 namespace JSONJay {
 
@@ -28,34 +32,238 @@ class Object;
  * @brief Object class
  * @details The Object class is used to store key-value pairs. The keys are
  *          strings and the values can be any of the supported data types.
+ *          Members are stored flat, so references to scalar and string
+ *          values are invalidated when members are added or erased.
+ *          References to nested Objects and Lists stay valid.
+ * @see MemberStore
  * @see IsValidDataType
  * @see IsValidPtrDataType
  * @see BaseDataType
  */
 class Object {
+public:
+    /**
+     * @brief The allocator used for the members and nested nodes
+     */
+    using allocator_type = node_allocator_t;
+
 protected:
     /**
      * @brief The internal data type of the Object
      */
-    using data_t = std::variant<std::string, int, double, bool, Object*, List*, std::monostate>;
+    using data_t = Value;
 
 private:
-    std::map<std::string, data_t> mData;
+    MemberStore mData;
 
 public:
     Object() = default;
     Object(Object&&) = default;
 
+    /**
+     * @brief Construct a new Object that allocates from an allocator
+     *
+     * @param allocator the allocator for members and nested nodes
+     */
+    explicit Object(const allocator_type& allocator);
+
+    /**
+     * @brief Move an Object into a possibly different allocator
+     * @details Nested nodes are relocated if the allocators differ.
+     *
+     * @param other     the Object to move from
+     * @param allocator the allocator of the new Object
+     */
+    Object(Object&& other, const allocator_type& allocator);
+
     virtual ~Object();
 
 private:
+    /**
+     * @brief take ownership of a node allocated with new
+     * @details The node is relocated if this Object does not allocate from
+     *          the new/delete resource.
+     *
+     * @tparam T the type of the node
+     * @param node the node
+     * @return T* the node owned by this Object
+     */
+    template<typename T>
+        requires IsValidPtrDataType<T>
+    T* adopt(T* node) {
+        if ( node == nullptr || get_allocator().resource() == std::pmr::new_delete_resource() )
+            return node;
+        T* adopted = new_node<T>(get_allocator(), std::move(*node));
+        delete node;
+        return adopted;
+    }
+
+    /**
+     * @brief turn a value into an element owned by this Object
+     * @details Objects and Lists are moved into a node of this Object's
+     *          allocator, raw pointers are adopted.
+     *
+     * @tparam T the type of the value
+     * @param value the value
+     * @return data_t the element
+     */
+    template<typename T>
+        requires IsValidDataType<std::remove_cvref_t<T>> || IsValidPtrDataType<T>
+    data_t make_element(T&& value) {
+        using U = std::remove_cvref_t<T>;
+        if constexpr ( IsValidPtrDataType<U> ) return data_t(new_node<U>(get_allocator(), std::move(value)));
+        else if constexpr ( std::is_pointer_v<U> ) return data_t(adopt(value));
+        else return data_t::make(value, get_allocator());
+    }
+
+    /**
+     * @brief construct an element owned by this Object in place
+     *
+     * @tparam T the type of the element
+     * @param args the constructor arguments
+     * @return data_t the element
+     */
+    template<typename T, typename... Args>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    data_t construct_element(Args&&... args) {
+        if      constexpr ( IsValidPtrDataType<T> )                return data_t(new_node<T>(get_allocator(), std::forward<Args>(args)...));
+        else if constexpr ( std::is_same_v<T, std::string> )      return data_t(std::string_view(std::forward<Args>(args)...), get_allocator());
+        else if constexpr ( std::is_same_v<T, std::monostate> )   return data_t();
+        else if constexpr ( std::is_pointer_v<T> )                return data_t(adopt(T(std::forward<Args>(args)...)));
+        else                                                      return data_t(T(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief get a reference to the content of an element
+     *
+     * @tparam T the type of the content
+     * @param element the element
+     * @return value_reference_t<T> the content
+     */
+    template<typename T>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    static value_reference_t<T> content(data_t& element) {
+        if constexpr ( IsValidPtrDataType<T> ) return *element.get<T*>();
+        else return element.get<T>();
+    }
+
+    /**
+     * @brief look up an element without throwing
+     *
+     * @tparam T the type of the element
+     * @param element the element or nullptr if the key does not exist
+     * @return Result<value_reference_t<T>> the content of the element or the error
+     */
+    template<typename T>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    static Result<value_reference_t<T>> lookup(data_t* element) noexcept {
+        using Stored = std::conditional_t<IsValidPtrDataType<T>, T*, T>;
+        if ( element == nullptr ) return LookupError::MISSING_KEY;
+        if ( !element->holds<Stored>() ) return LookupError::INVALID_TYPE;
+        return content<T>(*element);
+    }
+
+    /**
+     * @brief get a pointer to the content of an element
+     *
+     * @tparam T the type of the content
+     * @param element the element or nullptr
+     * @return T* the content or nullptr
+     */
+    template<typename T>
+        requires (IsValidDataType<T> && !std::is_pointer_v<T> && !std::is_same_v<T, std::string>) || IsValidPtrDataType<T>
+    static T* pointer_to(data_t* element) noexcept {
+        if ( element == nullptr ) return nullptr;
+        if constexpr ( IsValidPtrDataType<T> ) {
+            T** node = element->get_if<T*>();
+            return node == nullptr ? nullptr : *node;
+        } else {
+            return element->get_if<T>();
+        }
+    }
+
+    /**
+     * @brief get the element at a key or throw if it does not exist
+     *
+     * @param key the key
+     * @return data_t& the element
+     */
+    data_t& element_at(std::string_view key);
+
+    /**
+     * @brief get the element at a prehashed key or throw if it does not exist
+     *
+     * @param key the key
+     * @return data_t& the element
+     */
+    data_t& element_at(const Key& key);
+
+    /**
+     * @brief find the member of a key or insert an empty one
+     * @details The key is validated and hashed by Key, the store is
+     *          probed once.
+     * @throws InvalidKeyException if the key is invalid
+     *
+     * @param key the key
+     * @return std::pair<MemberStore::Member*, bool> the member and whether it was inserted
+     */
+    std::pair<MemberStore::Member*, bool> find_or_insert(const Key& key);
+
+    /**
+     * @brief store a new element in a member found by find_or_insert
+     * @details The previous content of the member is destroyed. If building
+     *          the element throws, a freshly inserted member is removed again.
+     *
+     * @tparam Build the type of the element factory
+     * @param member the member
+     * @param inserted whether the member was just inserted
+     * @param build callable returning the new element
+     * @return data_t& the element
+     */
+    template<typename Build>
+    data_t& store(MemberStore::Member* member, bool inserted, Build&& build) {
+        data_t element;
+        try {
+            element = build();
+        } catch ( ... ) {
+            if ( inserted ) mData.erase(member);
+            throw;
+        }
+        member->value.destroy(get_allocator());
+        member->value = element;
+        return member->value;
+    }
+
+    /**
+     * @brief Construct a value in place under a member name of parsed input
+     * @details JSON allows any string as member name, so the name is not
+     *          checked against the rules of Key. A name that occurs again
+     *          replaces the earlier value: the last one wins.
+     *
+     * @tparam T the type of the value
+     * @param name the member name
+     * @param args the constructor arguments of the value
+     * @return value_reference_t<T> the new value
+     */
+    template<typename T, typename... Args>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    value_reference_t<T> emplace_member(std::string_view name, Args&&... args) {
+        auto [member, inserted] = mData.try_emplace(name, hash_key(name));
+        data_t& element = store(member, inserted, [&] { return construct_element<T>(std::forward<Args>(args)...); });
+        return content<T>(element);
+    }
+
+    friend class JSONParser;
+    friend class BinaryReader;
+
+
     /**
      * @brief check if a key is valid or throw on invalid key
      *
      * @param key               the key
      * @param bThrow            if true, throw an exception if the key is invalid
      */
-    bool check_key_valid(const std::string& key, bool bThrow = true) const;
+    bool check_key_valid(std::string_view key, bool bThrow = true) const;
 
     /**
      * @brief check if a key exists or throw on collision
@@ -65,10 +273,17 @@ private:
      *                          or if it exists and bThrowCollision is true
      * @param bThrowCollision   if true, throw an exception if the key already exists
      */
-    bool check_key_exists(const std::string& key, bool bThrow = false, bool bThrowCollision = false) const;
+    bool check_key_exists(std::string_view key, bool bThrow = false, bool bThrowCollision = false) const;
 
 public:
 
+    /**
+     * @brief Get the allocator of the Object
+     *
+     * @return allocator_type the allocator
+     */
+    allocator_type get_allocator() const;
+
     /**
      * @brief weather the object is empty
      * 
@@ -84,6 +299,16 @@ public:
      */
     size_t size() const;
 
+    /**
+     * @brief Get the members of the object
+     * @details The members are sorted by key.
+     *
+     * @return const MemberStore& the members
+     */
+    const MemberStore& members() const noexcept {
+        return mData;
+    }
+
     /**
      * @brief Get the value at a key
      *
@@ -94,17 +319,8 @@ public:
      */
     template<typename T>
         requires IsValidDataType<T> || IsValidPtrDataType<T>
-    T& at(const std::string& key) {
-        check_key_exists(key, true);
-        if constexpr ( IsValidPtrDataType<T> ) {
-            if(!std::holds_alternative<T*>(mData.at(key)))
-                throw InvalidTypeException("Invalid type");
-            return *std::get<T*>(mData.at(key));
-        } else {
-            if(!std::holds_alternative<T>(mData.at(key)))
-                throw InvalidTypeException("Invalid type");
-            return std::get<T>(mData.at(key));
-        }
+    value_reference_t<T> at(std::string_view key) {
+        return content<T>(element_at(key));
     }
 
     /**
@@ -112,69 +328,249 @@ public:
      *
      * @tparam T the type of the value
      * @param key the key
-     * @return T& the value
+     * @return value_reference_t<T> the value
      */
     template<typename T>
         requires IsValidDataType<T> || IsValidPtrDataType<T>
-    T& operator[](const std::string& key) {
-        return at<T>(key, T());
+    value_reference_t<T> operator[](std::string_view key) {
+        return at<T>(key);
     }
 
     /**
-     * @brief Get the value at a key
+     * @brief Get the value at a prehashed key
+     * @details The key is neither validated nor hashed again.
      *
      * @tparam T the type of the value
      * @param key the key
-     * @return T& the value
+     * @return value_reference_t<T> the value
+     */
+    template<typename T>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    value_reference_t<T> at(const Key& key) {
+        return content<T>(element_at(key));
+    }
+
+    /**
+     * @brief Get the value at a prehashed key
+     *
+     * @tparam T the type of the value
+     * @param key the key
+     * @return value_reference_t<T> the value
+     */
+    template<typename T>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    value_reference_t<T> operator[](const Key& key) {
+        return at<T>(key);
+    }
+
+    /**
+     * @brief Find an element
+     * @details Never throws, a missing or invalid key yields nullptr.
+     *
+     * @param key the key
+     * @return data_t* the element or nullptr if the key does not exist
+     */
+    data_t* find(std::string_view key) noexcept;
+
+    /**
+     * @brief Find an element
+     *
+     * @param key the key
+     * @return const data_t* the element or nullptr if the key does not exist
+     */
+    const data_t* find(std::string_view key) const noexcept;
+
+    /**
+     * @brief Find an element at a prehashed key
+     *
+     * @param key the key
+     * @return data_t* the element or nullptr if the key does not exist
+     */
+    data_t* find(const Key& key) noexcept;
+
+    /**
+     * @brief Get a pointer to a value if it exists and has the type T
+     * @details Works like std::get_if: never throws. Strings have no pointer
+     *          to hand out, use try_get<std::string> for them.
+     *
+     * @tparam T int, double, bool, Object or List
+     * @param key the key
+     * @return T* the value or nullptr
+     */
+    template<typename T>
+        requires (IsValidDataType<T> && !std::is_pointer_v<T> && !std::is_same_v<T, std::string>) || IsValidPtrDataType<T>
+    T* get_if(std::string_view key) noexcept {
+        return pointer_to<T>(find(key));
+    }
+
+    /**
+     * @brief Get a pointer to a value at a prehashed key if it has the type T
+     *
+     * @tparam T int, double, bool, Object or List
+     * @param key the key
+     * @return T* the value or nullptr
+     */
+    template<typename T>
+        requires (IsValidDataType<T> && !std::is_pointer_v<T> && !std::is_same_v<T, std::string>) || IsValidPtrDataType<T>
+    T* get_if(const Key& key) noexcept {
+        return pointer_to<T>(find(key));
+    }
+
+    /**
+     * @brief Get a value without throwing
+     * @details A missing key yields LookupError::MISSING_KEY, a value of
+     *          another type LookupError::INVALID_TYPE.
+     *
+     * @tparam T the type of the value
+     * @param key the key
+     * @return Result<value_reference_t<T>> the value or the error
+     */
+    template<typename T>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    Result<value_reference_t<T>> try_get(std::string_view key) noexcept {
+        return lookup<T>(find(key));
+    }
+
+    /**
+     * @brief Get a value at a prehashed key without throwing
+     *
+     * @tparam T the type of the value
+     * @param key the key
+     * @return Result<value_reference_t<T>> the value or the error
      */
     template<typename T>
         requires IsValidDataType<T> || IsValidPtrDataType<T>
-    T& at(const char* key) {
-        return at<T>(std::string(key));
+    Result<value_reference_t<T>> try_get(const Key& key) noexcept {
+        return lookup<T>(find(key));
     }
 
     /**
      * @brief Set a value
+     * @details Objects and Lists are taken by move, raw Object and List
+     *          pointers are adopted.
+     * @throws InvalidKeyException if the key is invalid
+     * @throws InvalidTypeException if the key holds a value of another type
      *
      * @tparam T the type of the value
      * @param key the key
      * @param value the value
      */
     template<typename T>
-        requires IsValidDataType<T>
-    void set(const std::string& key, const T& value) {
-        check_key_valid(key, true);
-        if ( check_key_exists(key) ) at<T>(key) = value;
-        else mData.insert({ key, data_t(value) });
+        requires IsValidDataType<std::remove_cvref_t<T>> || IsValidPtrDataType<T>
+    void set(std::string_view key, T&& value) {
+        set(Key(key), std::forward<T>(value));
     }
 
     /**
-     * @brief Set a value
+     * @brief Set a value at a prehashed key
+     * @throws InvalidTypeException if the key holds a value of another type
      *
      * @tparam T the type of the value
      * @param key the key
      * @param value the value
      */
-    void set(const char* key, const char* value) {
-        set(std::string(key), std::string(value));
+    template<typename T>
+        requires IsValidDataType<std::remove_cvref_t<T>> || IsValidPtrDataType<T>
+    void set(const Key& key, T&& value) {
+        using U = std::remove_cvref_t<T>;
+        using Stored = std::conditional_t<IsValidPtrDataType<U>, U*, U>;
+
+        auto [member, inserted] = find_or_insert(key);
+        if ( !inserted ) {
+            if ( !member->value.holds<Stored>() ) throw InvalidTypeException("Invalid type");
+            if constexpr ( std::is_pointer_v<U> ) {
+                if ( member->value.get<U>() == value ) return;
+            }
+        }
+        store(member, inserted, [&] { return make_element(std::forward<T>(value)); });
     }
 
     /**
-     * @brief Set a value
+     * @brief Set a string value
+     * @throws InvalidKeyException if the key is invalid
+     * @throws InvalidTypeException if the key holds a value of another type
+     *
+     * @param key the key
+     * @param value the value
+     */
+    void set(std::string_view key, std::string_view value);
+
+    /**
+     * @brief Set a string value at a prehashed key
+     * @throws InvalidTypeException if the key holds a value of another type
+     *
+     * @param key the key
+     * @param value the value
+     */
+    void set(const Key& key, std::string_view value);
+
+    /**
+     * @brief Set a value, replacing a value of any type
+     * @throws InvalidKeyException if the key is invalid
      *
      * @tparam T the type of the value
      * @param key the key
      * @param value the value
+     * @return true the key was inserted
+     * @return false an existing value was replaced
      */
     template<typename T>
-        requires IsValidPtrDataType<T>
-    void set(const std::string& key, T&& value) {
-        check_key_valid(key, true);
-        if ( check_key_exists(key) ) at<T*>(key) = value;
-        else mData.insert({ key, data_t(new T(value)) });
+        requires IsValidDataType<std::remove_cvref_t<T>> || IsValidPtrDataType<T>
+    bool insert_or_assign(std::string_view key, T&& value) {
+        using U = std::remove_cvref_t<T>;
+
+        auto [member, inserted] = find_or_insert(Key(key));
+        if constexpr ( std::is_pointer_v<U> ) {
+            if ( !inserted && member->value.holds<U>() && member->value.get<U>() == value ) return false;
+        }
+        store(member, inserted, [&] { return make_element(std::forward<T>(value)); });
+        return inserted;
     }
 
-    void erase(const std::string& key);
+    /**
+     * @brief Construct a value in place if the key does not exist yet
+     * @throws InvalidKeyException if the key is invalid
+     * @throws InvalidTypeException if the key holds a value of another type
+     *
+     * @tparam T the type of the value
+     * @param key the key
+     * @param args the constructor arguments of the value
+     * @return std::pair<value_reference_t<T>, bool> the value and whether it was inserted
+     */
+    template<typename T, typename... Args>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    std::pair<value_reference_t<T>, bool> try_emplace(std::string_view key, Args&&... args) {
+        auto [member, inserted] = find_or_insert(Key(key));
+        if ( !inserted ) return { content<T>(member->value), false };
+        data_t& element = store(member, inserted, [&] { return construct_element<T>(std::forward<Args>(args)...); });
+        return { content<T>(element), true };
+    }
+
+    /**
+     * @brief Construct a value in place under a new key
+     * @throws InvalidKeyException if the key is invalid or already exists
+     *
+     * @tparam T the type of the value
+     * @param key the key
+     * @param args the constructor arguments of the value
+     * @return value_reference_t<T> the new value
+     */
+    template<typename T, typename... Args>
+        requires IsValidDataType<T> || IsValidPtrDataType<T>
+    value_reference_t<T> emplace(std::string_view key, Args&&... args) {
+        auto [member, inserted] = find_or_insert(Key(key));
+        if ( !inserted ) throw InvalidKeyException("Key already exists");
+        data_t& element = store(member, inserted, [&] { return construct_element<T>(std::forward<Args>(args)...); });
+        return content<T>(element);
+    }
+
+    /**
+     * @brief Erase an element
+     * @throws InvalidKeyException if the key does not exist
+     *
+     * @param key the key of the element
+     */
+    void erase(std::string_view key);
 
     /**
      * @brief Get the type of an element
@@ -182,24 +578,37 @@ public:
      * @param key the key of the element
      * @return BaseDataType the type of the element
      */
-    inline BaseDataType get_type(const std::string& key) const {
-        check_key_exists(key, true);
-
-        // This is a hack to remove the const qualifier.
-        // This is safe because we are not modifying the data.
-        auto& nonConstData = const_cast<std::map<std::string, data_t>&>(mData);
-        auto& nonConstElement = nonConstData.at(key);
+    inline BaseDataType get_type(std::string_view key) const {
+        const MemberStore::Member* member = mData.find(key);
+        if ( member == nullptr ) throw InvalidKeyException("Key does not exist");
+        return JSONJay::get_type(member->value);
+    }
 
-        return JSONJay::get_type(nonConstElement);
+    /**
+     * @brief Get the type of an element at a prehashed key
+     *
+     * @param key the key of the element
+     * @return BaseDataType the type of the element
+     */
+    inline BaseDataType get_type(const Key& key) const {
+        return JSONJay::get_type(const_cast<Object*>(this)->element_at(key));
     }
 
     /**
      * @brief Get a string value
      *
      * @param key the key
-     * @return std::string the value
+     * @return std::string_view the value
+     */
+    std::string_view get_string(std::string_view key);
+
+    /**
+     * @brief Get a string value at a prehashed key
+     *
+     * @param key the key
+     * @return std::string_view the value
      */
-    std::string& get_string(const std::string& key);
+    std::string_view get_string(const Key& key);
 
     /**
      * @brief Get an integer value
@@ -207,7 +616,15 @@ public:
      * @param key the key
      * @return int the value
      */
-    int& get_int(const std::string& key);
+    int& get_int(std::string_view key);
+
+    /**
+     * @brief Get an integer value at a prehashed key
+     *
+     * @param key the key
+     * @return int the value
+     */
+    int& get_int(const Key& key);
 
     /**
      * @brief Get a double value
@@ -215,7 +632,15 @@ public:
      * @param key the key
      * @return double the value
      */
-    double& get_double(const std::string& key);
+    double& get_double(std::string_view key);
+
+    /**
+     * @brief Get a double value at a prehashed key
+     *
+     * @param key the key
+     * @return double the value
+     */
+    double& get_double(const Key& key);
 
     /**
      * @brief Get a boolean value
@@ -223,7 +648,15 @@ public:
      * @param key the key
      * @return bool the value
      */
-    bool& get_bool(const std::string& key);
+    bool& get_bool(std::string_view key);
+
+    /**
+     * @brief Get a boolean value at a prehashed key
+     *
+     * @param key the key
+     * @return bool the value
+     */
+    bool& get_bool(const Key& key);
 
     /**
      * @brief Get an object value
@@ -231,7 +664,15 @@ public:
      * @param key the key
      * @return Object the value
      */
-    Object& get_object(const std::string& key);
+    Object& get_object(std::string_view key);
+
+    /**
+     * @brief Get an object value at a prehashed key
+     *
+     * @param key the key
+     * @return Object the value
+     */
+    Object& get_object(const Key& key);
 
     /**
      * @brief Get a list value
@@ -239,7 +680,36 @@ public:
      * @param key the key
      * @return List the value
      */
-    List& get_list(const std::string& key);
+    List& get_list(std::string_view key);
+
+    /**
+     * @brief Get a list value at a prehashed key
+     *
+     * @param key the key
+     * @return List the value
+     */
+    List& get_list(const Key& key);
+
+    /**
+     * @brief write an Object in the binary encoding
+     * @details Lets Objects take part in StreamWritinator::writeSerializable.
+     * @see BinaryWriter
+     *
+     * @param writer the stream to write to
+     * @param object the Object
+     */
+    static void serialize(StreamWritinator* writer, const Object& object);
+
+    /**
+     * @brief read an Object in the binary encoding
+     * @details Lets Objects take part in StreamReadinator::readDeserializable.
+     * @throws InvalidFormatException if the data is not a valid encoding
+     * @see BinaryReader
+     *
+     * @param reader the stream to read from
+     * @param object the Object to add the members to
+     */
+    static void deserialize(StreamReadinator* reader, Object& object);
 
 };
 
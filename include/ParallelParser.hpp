@@ -0,0 +1,84 @@
+/**
+ * @file ParallelParser.hpp
+ * @author TL044CN
+ * @brief ParallelParser class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Document.hpp"
+#include "Isa.hpp"
+#include "JSONParser.hpp"
+#include "StructuralIndex.hpp"
+#include "ThreadPool.hpp"
+
+#include <memory_resource>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Parsing
+ * @brief ParallelParser class
+ * @details Parses a JSON text whose root is one large List on all workers of
+ *          a ThreadPool. The structural index is built in speculative chunks,
+ *          see StructuralIndex::build. The elements of the root List are then
+ *          split into runs, each run is parsed into a Document of its own, and
+ *          the Documents are appended in order without copying their trees.
+ *          Texts with an Object root or below the parallel threshold are
+ *          parsed on the calling thread, with the same result as JSONParser.
+ */
+class ParallelParser {
+public:
+    /**
+     * @brief the default size below which texts are parsed on one thread
+     */
+    static constexpr size_t kDefaultMinParallelSize = 1024 * 1024;
+
+private:
+    ThreadPool mPool;
+    size_t mMinParallelSize;
+    Isa mIsa = detected_isa();
+    StructuralIndex mIndex;
+    JSONParser mParser;
+    std::vector<JSONParser> mParsers;   ///< one per worker
+
+public:
+    /**
+     * @brief Construct a new ParallelParser
+     *
+     * @param threads the number of worker threads
+     * @param minParallelSize the size below which texts are parsed on one thread
+     */
+    explicit ParallelParser(size_t threads = std::thread::hardware_concurrency(),
+        size_t minParallelSize = kDefaultMinParallelSize);
+
+    /**
+     * @brief Set the instruction set used for the structural index
+     *
+     * @param isa the instruction set
+     * @return Isa the previous instruction set
+     */
+    Isa set_isa(Isa isa) noexcept;
+
+    /**
+     * @brief Parse a JSON text
+     * @throws InvalidFormatException if the text is not valid JSON
+     * @throws InvalidKeyException if a key is invalid or appears twice in an Object
+     *
+     * @param text the JSON text
+     * @param upstream the memory resource the Document's arenas draw from
+     * @return Document the parsed Document
+     */
+    Document parse(std::string_view text,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+};
+
+} // namespace JSONJay
@@ -0,0 +1,173 @@
+/**
+ * @file Result.hpp
+ * @author TL044CN
+ * @brief Result class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Exceptions.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace JSONJay {
+
+/**
+ * @ingroup StorageClasses
+ * @brief reason why a non-throwing lookup failed
+ */
+enum class LookupError : uint8_t {
+    NONE,
+    MISSING_KEY,
+    INVALID_INDEX,
+    INVALID_TYPE
+};
+
+template<typename T>
+class Result;
+
+/**
+ * @brief true for Result types
+ */
+template<typename T>
+struct is_result : std::false_type {};
+
+template<typename T>
+struct is_result<Result<T>> : std::true_type {};
+
+/**
+ * @ingroup StorageClasses
+ * @brief Result of a non-throwing lookup
+ * @details Holds either a value or the LookupError explaining why there is
+ *          none, similar to std::expected. T may be an lvalue reference, the
+ *          Result then refers to the element in its container. Lookups can
+ *          be chained with and_then without any exception being thrown:
+ * @code
+ * JSONJay::Result<int&> id = object.try_get<JSONJay::Object>("user")
+ *     .and_then([](JSONJay::Object& user) { return user.try_get<int>("id"); });
+ * if ( id ) use(*id);
+ * @endcode
+ *
+ * @tparam T the type of the value
+ */
+template<typename T>
+class Result {
+public:
+    using value_type = T;
+
+private:
+    using stored_t = std::conditional_t<std::is_reference_v<T>, std::remove_reference_t<T>*, T>;
+
+    stored_t mValue{};
+    LookupError mError = LookupError::NONE;
+
+public:
+    /**
+     * @brief Construct a Result holding a value
+     *
+     * @param value the value
+     */
+    Result(T value) noexcept(std::is_nothrow_move_constructible_v<stored_t>) {
+        if constexpr ( std::is_reference_v<T> ) mValue = std::addressof(value);
+        else mValue = std::move(value);
+    }
+
+    /**
+     * @brief Construct a Result holding an error
+     *
+     * @param error the error, must not be LookupError::NONE
+     */
+    Result(LookupError error) noexcept : mError(error) {}
+
+    /**
+     * @brief whether the Result holds a value
+     *
+     * @return true the Result holds a value
+     * @return false the Result holds an error
+     */
+    bool has_value() const noexcept {
+        return mError == LookupError::NONE;
+    }
+
+    explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    /**
+     * @brief Get the error
+     *
+     * @return LookupError the error, LookupError::NONE if there is a value
+     */
+    LookupError error() const noexcept {
+        return mError;
+    }
+
+    /**
+     * @brief Get the value
+     * @throws InvalidKeyException, InvalidIndexException or InvalidTypeException
+     *         matching the error if there is no value
+     *
+     * @return T the value
+     */
+    T value() const {
+        switch ( mError ) {
+            case LookupError::MISSING_KEY:   throw InvalidKeyException("Key does not exist");
+            case LookupError::INVALID_INDEX: throw InvalidIndexException("Index out of bounds");
+            case LookupError::INVALID_TYPE:  throw InvalidTypeException("Invalid type");
+            default: break;
+        }
+        return **this;
+    }
+
+    /**
+     * @brief Get the value or a fallback
+     *
+     * @param fallback the value returned if there is none
+     * @return std::remove_cvref_t<T> the value or the fallback
+     */
+    std::remove_cvref_t<T> value_or(std::remove_cvref_t<T> fallback) const
+        requires std::is_copy_constructible_v<std::remove_cvref_t<T>> {
+        return has_value() ? std::remove_cvref_t<T>(**this) : fallback;
+    }
+
+    /**
+     * @brief Get the value without checking
+     * @warning the Result has to hold a value
+     *
+     * @return T the value
+     */
+    T operator*() const noexcept {
+        if constexpr ( std::is_reference_v<T> ) return *mValue;
+        else return mValue;
+    }
+
+    auto operator->() const noexcept {
+        if constexpr ( std::is_reference_v<T> ) return mValue;
+        else return std::addressof(mValue);
+    }
+
+    /**
+     * @brief Continue with another lookup if there is a value
+     *
+     * @tparam F the type of the continuation
+     * @param function callable taking the value and returning a Result
+     * @return the Result of the continuation, or its error type holding this error
+     */
+    template<typename F>
+    auto and_then(F&& function) const {
+        using next_t = std::invoke_result_t<F, T>;
+        static_assert(is_result<next_t>::value, "and_then continuations have to return a Result");
+        if ( !has_value() ) return next_t(mError);
+        return std::forward<F>(function)(**this);
+    }
+};
+
+} // namespace JSONJay
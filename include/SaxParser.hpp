@@ -0,0 +1,188 @@
+/**
+ * @file SaxParser.hpp
+ * @author TL044CN
+ * @brief SaxParser class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+#include "StreamReadinator.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Parsing
+ * @brief a receiver of the events of the SaxParser
+ * @details Strings are passed as views that are only valid during the call.
+ *          null is passed as std::monostate.
+ */
+template<typename Handler>
+concept SaxHandler = requires(Handler& handler, std::string_view text) {
+    handler.start_object();
+    handler.end_object();
+    handler.start_list();
+    handler.end_list();
+    handler.key(text);
+    handler.value(text);
+    handler.value(int());
+    handler.value(double());
+    handler.value(bool());
+    handler.value(std::monostate());
+};
+
+/**
+ * @ingroup Parsing
+ * @brief SaxParser class
+ * @details Parses JSON text from a StreamReadinator without building a tree.
+ *          The stream is read in chunks of a fixed size and every token is
+ *          reported to a handler as soon as it is complete. The handler is a
+ *          template parameter, so the events are plain function calls.
+ *          Memory use is bounded by the chunk size, the nesting depth and the
+ *          longest string or number of the text, never by the size of the
+ *          text itself.
+ * @see SaxHandler
+ */
+class SaxParser {
+public:
+    /**
+     * @brief the deepest nesting of Objects and Lists that is accepted
+     */
+    static constexpr size_t kMaxDepth = 1024;
+
+    /**
+     * @brief the default number of bytes requested from the stream at once
+     */
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+private:
+    /**
+     * @brief the tokens of JSON text
+     */
+    enum class Token : uint8_t {
+        START_OBJECT,
+        END_OBJECT,
+        START_LIST,
+        END_LIST,
+        KEY,
+        STRING,
+        INT,
+        DOUBLE,
+        BOOL,
+        NONE,
+        END
+    };
+
+    /**
+     * @brief what the grammar expects next
+     */
+    enum class State : uint8_t {
+        VALUE,              ///< any value
+        FIRST_ELEMENT,      ///< a value or the end of an empty List
+        FIRST_KEY,          ///< a key or the end of an empty Object
+        KEY,                ///< a key
+        COLON,              ///< the colon after a key
+        NEXT,               ///< a comma or the end of the container
+        DONE                ///< the end of the text
+    };
+
+    StreamReadinator* mReader = nullptr;
+    std::vector<char> mChunk;
+    size_t mPosition = 0;
+    size_t mEnd = 0;
+    bool mEndOfStream = false;
+
+    State mState = State::VALUE;
+    std::vector<bool> mStack;   ///< the open containers, true for Objects
+
+    std::string mToken;
+    std::string mString;
+    std::string_view mText;
+    int mInt = 0;
+    double mDouble = 0.0;
+    bool mBool = false;
+
+    /**
+     * @brief read the next chunk of the stream
+     *
+     * @return true a chunk was read
+     * @return false the stream has ended
+     */
+    bool refill();
+
+    /**
+     * @brief consume whitespace and the character after it
+     *
+     * @return int the character or -1 at the end of the stream
+     */
+    int next_char();
+
+    void read_string();
+    Token read_value(int c);
+    Token read_scalar(char first);
+    Token open(bool object);
+    Token close(char c);
+    void after_value() noexcept;
+
+    /**
+     * @brief read the next token
+     * @throws InvalidFormatException if the text is not valid JSON
+     *
+     * @return Token the token
+     */
+    Token next();
+
+    void start(StreamReadinator& reader);
+
+public:
+    /**
+     * @brief Construct a new SaxParser
+     *
+     * @param chunkSize the number of bytes requested from the stream at once
+     */
+    explicit SaxParser(size_t chunkSize = kDefaultChunkSize);
+
+    /**
+     * @brief Parse a JSON text and report its tokens to a handler
+     * @details The text may have any value at its root.
+     * @throws InvalidFormatException if the text is not valid JSON, events
+     *         before the error have already been reported
+     *
+     * @tparam Handler the type of the handler
+     * @param reader the stream to read the text from
+     * @param handler the handler
+     */
+    template<typename Handler>
+        requires SaxHandler<Handler>
+    void parse(StreamReadinator& reader, Handler& handler) {
+        start(reader);
+        while ( true ) {
+            switch ( next() ) {
+                case Token::START_OBJECT: handler.start_object(); break;
+                case Token::END_OBJECT:   handler.end_object(); break;
+                case Token::START_LIST:   handler.start_list(); break;
+                case Token::END_LIST:     handler.end_list(); break;
+                case Token::KEY:          handler.key(mText); break;
+                case Token::STRING:       handler.value(mText); break;
+                case Token::INT:          handler.value(mInt); break;
+                case Token::DOUBLE:       handler.value(mDouble); break;
+                case Token::BOOL:         handler.value(mBool); break;
+                case Token::NONE:         handler.value(std::monostate()); break;
+                case Token::END:          return;
+            }
+        }
+    }
+};
+
+} // namespace JSONJay
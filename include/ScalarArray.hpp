@@ -0,0 +1,254 @@
+/**
+ * @file ScalarArray.hpp
+ * @author TL044CN
+ * @brief ScalarArray class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace JSONJay {
+
+/**
+ * @ingroup StorageClasses
+ * @brief contiguous storage of one scalar type
+ * @details Backs homogeneous Lists of ints, doubles or bools. The array does
+ *          not know its element type: the owning List passes it to every
+ *          call and has to use the same type until the array is cleared.
+ * @see List
+ */
+class ScalarArray {
+public:
+    /**
+     * @brief The allocator of the elements
+     */
+    using allocator_type = node_allocator_t;
+
+private:
+    static constexpr size_t kAlignment = alignof(double);
+    static constexpr size_t kMinCapacity = 64;
+
+    std::byte* mData = nullptr;
+    size_t mSize = 0;       ///< in bytes
+    size_t mCapacity = 0;   ///< in bytes
+    allocator_type mAllocator;
+
+    /**
+     * @brief reallocate to hold at least a number of bytes
+     *
+     * @param bytes the number of bytes
+     */
+    void grow(size_t bytes) {
+        size_t capacity = std::max({ bytes, mCapacity * 2, kMinCapacity });
+        std::byte* data = static_cast<std::byte*>(mAllocator.allocate_bytes(capacity, kAlignment));
+        if ( mSize > 0 ) std::memcpy(data, mData, mSize);
+        release();
+        mData = data;
+        mCapacity = capacity;
+    }
+
+    /**
+     * @brief free the buffer
+     */
+    void release() noexcept {
+        if ( mData != nullptr ) mAllocator.deallocate_bytes(mData, mCapacity, kAlignment);
+        mData = nullptr;
+        mCapacity = 0;
+    }
+
+public:
+    ScalarArray() = default;
+
+    /**
+     * @brief Construct an empty array that allocates from an allocator
+     *
+     * @param allocator the allocator
+     */
+    explicit ScalarArray(const allocator_type& allocator) : mAllocator(allocator) {}
+
+    ScalarArray(ScalarArray&& other) noexcept
+        : mData(std::exchange(other.mData, nullptr)),
+          mSize(std::exchange(other.mSize, 0)),
+          mCapacity(std::exchange(other.mCapacity, 0)),
+          mAllocator(other.mAllocator) {}
+
+    /**
+     * @brief Move an array into a possibly different allocator
+     *
+     * @param other     the array to move from
+     * @param allocator the allocator of the new array
+     */
+    ScalarArray(ScalarArray&& other, const allocator_type& allocator) : mAllocator(allocator) {
+        if ( allocator == other.mAllocator ) {
+            mData = std::exchange(other.mData, nullptr);
+            mSize = std::exchange(other.mSize, 0);
+            mCapacity = std::exchange(other.mCapacity, 0);
+            return;
+        }
+        if ( other.mSize > 0 ) {
+            grow(other.mSize);
+            std::memcpy(mData, other.mData, other.mSize);
+            mSize = other.mSize;
+        }
+        other.mSize = 0;
+    }
+
+    ScalarArray(const ScalarArray&) = delete;
+    ScalarArray& operator=(const ScalarArray&) = delete;
+    ScalarArray& operator=(ScalarArray&&) = delete;
+
+    ~ScalarArray() {
+        release();
+    }
+
+    /**
+     * @brief Get the number of elements
+     *
+     * @tparam T the element type
+     * @return size_t the number of elements
+     */
+    template<typename T>
+    size_t size() const noexcept {
+        return mSize / sizeof(T);
+    }
+
+    /**
+     * @brief whether the array is empty
+     */
+    bool empty() const noexcept {
+        return mSize == 0;
+    }
+
+    /**
+     * @brief Get the elements
+     *
+     * @tparam T the element type
+     * @return T* the first element
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    T* data() noexcept {
+        return reinterpret_cast<T*>(mData);
+    }
+
+    /**
+     * @brief Get the elements
+     *
+     * @tparam T the element type
+     * @return std::span<const T> the elements
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    std::span<const T> span() const noexcept {
+        return std::span<const T>(reinterpret_cast<const T*>(mData), size<T>());
+    }
+
+    /**
+     * @brief make room for a number of elements
+     *
+     * @tparam T the element type
+     * @param count the number of elements
+     */
+    template<typename T>
+    void reserve(size_t count) {
+        if ( count * sizeof(T) > mCapacity ) grow(count * sizeof(T));
+    }
+
+    /**
+     * @brief Set the number of elements
+     * @details New elements are left uninitialized.
+     *
+     * @tparam T the element type
+     * @param count the number of elements
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void resize(size_t count) {
+        reserve<T>(count);
+        mSize = count * sizeof(T);
+    }
+
+    /**
+     * @brief Exchange the contents with another array of the same allocator
+     *
+     * @param other the other array
+     */
+    void swap(ScalarArray& other) noexcept {
+        std::swap(mData, other.mData);
+        std::swap(mSize, other.mSize);
+        std::swap(mCapacity, other.mCapacity);
+    }
+
+    /**
+     * @brief Insert an element
+     *
+     * @tparam T the element type
+     * @param index the position of the new element
+     * @param value the element
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void insert(size_t index, T value) {
+        if ( mSize + sizeof(T) > mCapacity ) grow(mSize + sizeof(T));
+        std::byte* position = mData + index * sizeof(T);
+        std::memmove(position + sizeof(T), position, mSize - index * sizeof(T));
+        std::memcpy(position, &value, sizeof(T));
+        mSize += sizeof(T);
+    }
+
+    /**
+     * @brief Append an element
+     *
+     * @tparam T the element type
+     * @param value the element
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void push_back(T value) {
+        insert<T>(size<T>(), value);
+    }
+
+    /**
+     * @brief Remove an element
+     *
+     * @tparam T the element type
+     * @param index the position of the element
+     */
+    template<typename T>
+    void erase(size_t index) {
+        std::byte* position = mData + index * sizeof(T);
+        std::memmove(position, position + sizeof(T), mSize - (index + 1) * sizeof(T));
+        mSize -= sizeof(T);
+    }
+
+    /**
+     * @brief Remove all elements, keeping the buffer
+     */
+    void clear() noexcept {
+        mSize = 0;
+    }
+
+    /**
+     * @brief Remove all elements and free the buffer
+     */
+    void reset() noexcept {
+        mSize = 0;
+        release();
+    }
+};
+
+} // namespace JSONJay
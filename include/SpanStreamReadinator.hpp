@@ -0,0 +1,181 @@
+/**
+ * @file SpanStreamReadinator.hpp
+ * @author TL044CN
+ * @brief SpanStreamReadinator class declaration
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "StreamReadinator.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Serialization
+ * @brief SpanStreamReadinator class
+ * @details The SpanStreamReadinator class is a StreamReadinator that reads
+ *          from memory it does not own, such as a received network payload.
+ *          Nothing is copied up front. Besides copying reads it offers
+ *          readStringView and readSpan, which return views into the memory.
+ *          The memory has to outlive the readinator and all views.
+ */
+class SpanStreamReadinator final : public StreamReadinator, public ReadinatorHelpers<SpanStreamReadinator> {
+private:
+    std::span<const char> mData;
+    uint64_t mPosition = 0;
+
+public:
+    // the helpers of the concrete type are bound statically
+    using ReadinatorHelpers<SpanStreamReadinator>::readBuffer;
+    using ReadinatorHelpers<SpanStreamReadinator>::readString;
+    using ReadinatorHelpers<SpanStreamReadinator>::readRaw;
+    using ReadinatorHelpers<SpanStreamReadinator>::readDeserializable;
+    using ReadinatorHelpers<SpanStreamReadinator>::readMap;
+    using ReadinatorHelpers<SpanStreamReadinator>::readVector;
+    using ReadinatorHelpers<SpanStreamReadinator>::readArray;
+
+    /**
+     * @brief Construct a new SpanStreamReadinator object
+     *
+     * @param data the memory to read from
+     */
+    explicit SpanStreamReadinator(std::span<const char> data) noexcept : mData(data) {}
+
+    /**
+     * @brief Construct a new SpanStreamReadinator object
+     *
+     * @param data the memory to read from
+     */
+    explicit SpanStreamReadinator(std::string_view data) noexcept : mData(data.data(), data.size()) {}
+
+    /**
+     * @brief checks if the stream is good
+     *
+     * @return true there is data left
+     * @return false the stream is at its end
+     */
+    bool isStreamGood() const override;
+
+    /**
+     * @brief returns the current stream position
+     *
+     * @return uint64_t the current stream position
+     */
+    uint64_t getStreamPosition() override;
+
+    /**
+     * @brief sets the stream position
+     *
+     * @param position the position to set
+     */
+    void setStreamPosition(uint64_t position) override;
+
+    /**
+     * @brief reads data from the stream
+     *
+     * @param data the buffer to read into
+     * @param size the size of the buffer
+     * @return true read was successful
+     * @return false read was unsuccessful
+     */
+    bool readData(char* data, uint64_t size) override {
+        if ( mPosition > mData.size() || size > mData.size() - mPosition ) return false;
+        if ( size != 0 ) std::memcpy(data, mData.data() + mPosition, size);
+        mPosition += size;
+        return true;
+    }
+
+    /**
+     * @brief reads an unsigned LEB128 varint from the stream
+     * @details Decodes the varint in place without copying it.
+     *
+     * @param value the number
+     * @return true read successful
+     * @return false read failed or the varint is longer than 64 bits
+     */
+    bool readVarint(uint64_t& value) override {
+        size_t size = mPosition < mData.size() ? decode_varint(mData.data() + mPosition, mData.size() - mPosition, value) : 0;
+        mPosition += size;
+        return size != 0;
+    }
+
+    /**
+     * @brief reads up to a number of bytes from the stream
+     *
+     * @param data the buffer to read into
+     * @param size the size of the buffer
+     * @return uint64_t the number of bytes read, 0 at the end of the stream
+     */
+    uint64_t readSome(char* data, uint64_t size) override;
+
+    /**
+     * @brief reads data from the stream until a delimiter is found
+     * @details Searches the rest of the data in one go and appends the bytes
+     *          up to and including the delimiter at once.
+     *
+     * @param data the buffer to read into
+     * @param delim the delimiter to read until
+     * @return true the delimiter was found
+     * @return false the rest of the data was read without finding it
+     */
+    bool readUntil(std::vector<char>& data, char delim) override;
+
+    /**
+     * @brief reads data from the stream until a delimiter is found
+     * @see readUntil(std::vector<char>&, char)
+     */
+    bool readUntil(std::vector<char>& data, std::string delim) override;
+
+    /**
+     * @brief reads data up to a delimiter without copying it
+     * @details The view includes the delimiter and points into the span.
+     *
+     * @param view the bytes up to and including the delimiter, or the rest
+     *        of the data if it was not found
+     * @param delim the delimiter to read until
+     * @return true the delimiter was found
+     * @return false the rest of the data was read without finding it
+     */
+    bool readViewUntil(std::string_view& view, std::string_view delim);
+
+    /**
+     * @brief reads a number of bytes without copying them
+     *
+     * @param span the view of the bytes
+     * @param size the number of bytes
+     * @return true read was successful
+     * @return false not enough data left, the position is unchanged
+     */
+    bool readSpan(std::span<const char>& span, uint64_t size);
+
+    /**
+     * @brief reads a string written by writeString without copying it
+     *
+     * @param str the view of the string
+     * @return true read was successful
+     * @return false not enough data left, the position is unchanged
+     */
+    bool readStringView(std::string_view& str);
+
+    /**
+     * @brief get the memory that is left to read
+     *
+     * @return std::span<const char> the memory behind the position
+     */
+    std::span<const char> remaining() const noexcept {
+        return mPosition < mData.size() ? mData.subspan(mPosition) : std::span<const char>();
+    }
+
+};
+
+} // namespace JSONJay
@@ -10,86 +10,180 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <cstring>
+#include <span>
 #include <vector>
 #include <string>
 #include <map>
 #include <unordered_map>
 
 #include "Common.hpp"
+#include "Varint.hpp"
 
 namespace JSONJay {
 
 /**
  * @ingroup Serialization
- * @brief abstract StreamReadinator base class
- * @details The StreamReadinator class is an abstract base class for reading
- *          data from a stream. The stream can be a file, a network socket
- *          or any other source of data.
+ * @brief the helpers of a StreamReadinator
+ * @details The helpers read through Self::readData. StreamReadinator
+ *          instantiates them for itself, so they go through the virtual
+ *          readData. Final backends such as BufferStreamReadinator also
+ *          instantiate them for their own type. Calls on the concrete type
+ *          are then bound statically, and the compiler can inline them down
+ *          to the copy.
+ *
+ * @tparam Self the class readData is called on
  */
-class StreamReadinator {
-public:
+template<typename Self>
+class ReadinatorHelpers {
+private:
     /**
-     * @brief Destroy the StreamReadinator object
+     * @brief the size of the buffer map entries are read in
      */
-    virtual ~StreamReadinator() = default;
+    static constexpr size_t kChunkSize = 4096;
 
-    /**
-     * @brief checks if the stream is good
-     *
-     * @return true stream is good
-     * @return false stream is bad
-     */
-    virtual bool isStreamGood() const = 0;
+    Self& self() {
+        return static_cast<Self&>(*this);
+    }
 
     /**
-     * @brief returns the current stream position
+     * @brief check if values of a type have to be swapped after reading
      *
-     * @return uint64_t the current stream position
+     * @tparam T the type of the values
      */
-    virtual uint64_t getStreamPosition() = 0;
+    template<typename T>
+    bool swapsBytes() {
+        if constexpr ( sizeof(T) > 1 && IsByteSwappable<T> )
+            return self().getByteOrder() != std::endian::native;
+        else
+            return false;
+    }
 
     /**
-     * @brief sets the stream position
+     * @brief check if values of a type are read as varints
      *
-     * @param position the position to set
+     * @tparam T the type of the values
      */
-    virtual void setStreamPosition(uint64_t position) = 0;
+    template<typename T>
+    bool usesVarints() {
+        if constexpr ( IsVarintEncodable<T> )
+            return self().getIntegerEncoding() == IntegerEncoding::VARINT;
+        else
+            return false;
+    }
 
     /**
-     * @brief reads data from the stream
+     * @brief copy a value from a buffer in the byte order of the stream
      *
-     * @param data the buffer to read into
-     * @param size the size of the buffer
+     * @param in where to copy from, moved behind the value
+     * @return T the value
      */
-    virtual bool readData(char* data, uint64_t size) = 0;
+    template<typename T>
+    T take(const char*& in) {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        if constexpr ( IsByteSwappable<T> )
+            if ( swapsBytes<T>() ) value = swap_bytes(value);
+        return value;
+    }
 
     /**
-     * @brief reads data from the stream until a delimiter is found
+     * @brief reads trivially copyable elements with a single readData
+     * @details Integers read as varints are decoded one by one with readVarint.
      *
-     * @param data the buffer to read into
-     * @param delim the delimiter to read until
+     * @param data where to read to
+     * @param count the number of elements
+     * @return true read successful
+     * @return false read failed or a varint is out of range
      */
-    virtual bool readUntil(std::vector<char>& data, char delim);
+    template<typename T>
+    bool readElements(T* data, size_t count) {
+        if constexpr ( IsVarintEncodable<T> ) {
+            if ( usesVarints<T>() ) {
+                for ( size_t i = 0; i < count; i++ ) {
+                    uint64_t varint;
+                    if ( !self().readVarint(varint) || !from_varint(varint, data[i]) ) return false;
+                }
+                return true;
+            }
+        }
+        if ( !self().readData(reinterpret_cast<char*>(data), count * sizeof(T)) )
+            return false;
+        if constexpr ( IsByteSwappable<T> )
+            if ( swapsBytes<T>() )
+                for ( size_t i = 0; i < count; i++ ) data[i] = swap_bytes(data[i]);
+        return true;
+    }
 
     /**
-     * @brief reads data from the stream until a delimiter is found
-     *
-     * @param data the buffer to read into
-     * @param delim the delimiter to read until
+     * @brief reads the entries of a map
+     * @details Trivial keys and values are read in chunks, so a map costs a
+     *          readData per chunk instead of two per entry.
      */
-    virtual bool readUntil(std::vector<char>& data, std::string delim);
+    template<typename Map>
+    void readEntries(Map& map, uint32_t size) {
+        using K = typename Map::key_type;
+        using V = typename Map::mapped_type;
+        if (size == 0)
+            readRaw(size);
 
-    /**
-     * @brief returns weather the stream is good
-     * 
-     * @return true the stream is good
-     * @return false the stream is bad
-     */
-    operator bool() const {
-        return isStreamGood();
+        // entries are written in key order, so std::map inserts them at the end
+        auto insert = [&map](K&& key, V&& value) {
+            if constexpr ( requires { map.reserve(size_t()); } )
+                map.insert_or_assign(std::move(key), std::move(value));
+            else
+                map.insert_or_assign(map.end(), std::move(key), std::move(value));
+        };
+        if constexpr ( requires { map.reserve(size_t()); } )
+            map.reserve(map.size() + size);
+
+        // entries of varints have no fixed size and are read one by one
+        if constexpr ( std::is_trivial_v<K> && std::is_trivial_v<V> && sizeof(K) + sizeof(V) <= kChunkSize ) {
+            if ( !usesVarints<K>() && !usesVarints<V>() ) {
+                constexpr size_t entrySize = sizeof(K) + sizeof(V);
+                constexpr size_t perChunk = kChunkSize / entrySize;
+                char chunk[kChunkSize];
+                for (uint32_t i = 0; i < size; i += perChunk) {
+                    size_t n = std::min<size_t>(perChunk, size - i);
+                    if (!self().readData(chunk, n * entrySize))
+                        return;
+                    const char* in = chunk;
+                    for (size_t j = 0; j < n; j++) {
+                        K key = take<K>(in);
+                        insert(std::move(key), take<V>(in));
+                    }
+                }
+                return;
+            }
+        }
+
+        for (uint32_t i = 0; i < size; i++) {
+            K key;
+            if constexpr (std::is_trivial_v<K>)
+                readRaw(key);
+            else if constexpr (std::is_same_v<K, std::string>)
+                readString(key);
+            else
+                readDeserializable(key);
+
+            V value;
+            if constexpr (std::is_trivial_v<V>)
+                readRaw(value);
+            else if constexpr (std::is_same_v<V, std::string>)
+                readString(value);
+            else
+                readDeserializable(value);
+
+            insert(std::move(key), std::move(value));
+        }
     }
 
+public:
     /**
      * @brief reads a buffer from the stream
      * 
@@ -98,7 +192,14 @@ public:
      * @return true read successful
      * @return false read failed
      */
-    bool readBuffer(std::vector<char>& buffer, uint32_t size = 0);
+    bool readBuffer(std::vector<char>& buffer, uint32_t size = 0) {
+        uint32_t bufferSize = size;
+        if (bufferSize == 0) {
+            readRaw(bufferSize);
+        }
+        buffer.resize(bufferSize);
+        return self().readData(buffer.data(), buffer.size());
+    }
 
     /**
      * @brief reads a string from the stream
@@ -107,10 +208,19 @@ public:
      * @return true read successful
      * @return false read failed
      */
-    bool readString(std::string& str);
+    bool readString(std::string& str) {
+        size_t size;
+        if(!readRaw(size))
+            return false;
+
+        str.resize(size);
+        return self().readData(str.data(), str.size());
+    }
 
     /**
      * @brief reads raw data from the stream
+     * @details Numbers and enums are read in the byte order of the stream,
+     *          integers as varints if the stream uses them.
      * 
      * @tparam T the type to read
      * @param t the data to read into
@@ -119,8 +229,7 @@ public:
      */
     template<typename T>
     bool readRaw(T& t) {
-        bool success = readData(reinterpret_cast<char*>(&t), sizeof(T));
-        return success;
+        return readElements(&t, 1);
     }
 
     /**
@@ -132,7 +241,7 @@ public:
     template<typename T>
         requires IsDeserializable<T>
     void readDeserializable(T& t) {
-        T::deserialize(*this, t);
+        T::deserialize(&self(), t);
     }
 
     /**
@@ -141,32 +250,14 @@ public:
      * 
      * @tparam K the key type
      * @tparam V the value type
-     * @param std::is_same_v<K,std::string> the map to read into
+     * @param map the map to read into
+     * @param size the number of entries, 0 to read it from the stream
      */
     template<typename K, typename V>
         requires (IsDeserializable<K> || std::is_trivial_v<K> || std::is_same_v<K,std::string>) &&
                  (IsDeserializable<V> || std::is_trivial_v<V> || std::is_same_v<V,std::string>)
     void readMap(std::map<K,V>& map, uint32_t size = 0) {
-        if (size == 0)
-            readRaw(size);
-        
-        for (uint32_t i = 0; i < size; i++) {
-            K key;
-            if constexpr (std::is_trivial_v<K>)
-                readRaw(key);
-            else if constexpr (std::is_same_v<K, std::string>)
-                readString(key);
-            else 
-                readDeserializable(key);
-
-            if constexpr (std::is_trivial_v<V>)
-                readRaw<V>(map[key]);
-            else if constexpr (std::is_same_v<V, std::string>)
-                readString(map[key]);
-            else
-                readDeserializable<V>(map[key]);
-
-        }
+        readEntries(map, size);
     }
 
     /**
@@ -176,58 +267,224 @@ public:
      * @tparam K the key type
      * @tparam V the value type
      * @param map the map to read into
+     * @param size the number of entries, 0 to read it from the stream
      */
     template<typename K, typename V>
         requires (IsDeserializable<K> || std::is_trivial_v<K> || std::is_same_v<K,std::string>) &&
                  (IsDeserializable<V> || std::is_trivial_v<V> || std::is_same_v<V,std::string>)
     void readMap(std::unordered_map<K,V>& map, uint32_t size = 0) {
-        if (size == 0)
-            readRaw(size);
-        
-        for (uint32_t i = 0; i < size; i++) {
-            K key;
-            if constexpr (std::is_trivial_v<K>)
-                readRaw(key);
-            else if constexpr (std::is_same_v<K, std::string>)
-                readString(key);
-            else 
-                readDeserializable(key);
-
-            if constexpr (std::is_trivial_v<V>)
-                readRaw<V>(map[key]);
-            else if constexpr (std::is_same_v<V, std::string>)
-                readString(map[key]);
-            else
-                readDeserializable<V>(map[key]);
-
-        }
+        readEntries(map, size);
     }
 
     /**
      * @brief reads a vector from the stream
-     * @note the type must be deserializable, trivial or a string
+     * @details The elements are appended. Trivially copyable elements are
+     *          read in one piece straight into the vector.
+     * @note the type must be deserializable, trivially copyable or a string
      * 
      * @tparam T the type to read
      * @param vec the vector to read into
+     * @param size the number of elements, 0 to read it from the stream
      */
     template<typename T>
-        requires (IsDeserializable<T> || std::is_trivial_v<T> || std::is_same_v<T,std::string>)
+        requires (IsDeserializable<T> || (std::is_trivially_copyable_v<T> && std::default_initializable<T>) ||
+                  std::is_same_v<T,std::string>)
     void readVector(std::vector<T>& vec, uint32_t size = 0) {
         if (size == 0)
             readRaw(size);
-        
-        for (uint32_t i = 0; i < size; i++) {
-            T t;
-            if constexpr (std::is_trivial_v<T>)
-                readRaw(t);
-            else if constexpr (std::is_same_v<T, std::string>)
-                readString(t);
-            else
-                readDeserializable(t);
-            vec.push_back(t);
+
+        size_t first = vec.size();
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            vec.resize(first + size);
+            if (!readElements(vec.data() + first, size))
+                vec.resize(first);
+        } else {
+            vec.reserve(first + size);
+            for (uint32_t i = 0; i < size; i++) {
+                T t;
+                if constexpr (std::is_same_v<T, std::string>)
+                    readString(t);
+                else
+                    readDeserializable(t);
+                vec.push_back(std::move(t));
+            }
         }
     }
 
+    /**
+     * @brief reads elements into a span with a single readData
+     * @details Reads exactly as many elements as fit, see
+     *          WritinatorHelpers::writeArray.
+     *
+     * @tparam T the type of the elements, trivially copyable
+     * @param data where to read to
+     * @return true read successful
+     * @return false read failed
+     */
+    template<typename T, size_t Extent>
+        requires (std::is_trivially_copyable_v<T> && !std::is_const_v<T>)
+    bool readArray(std::span<T, Extent> data) {
+        return readElements(data.data(), data.size());
+    }
+
+    /**
+     * @brief reads elements into an array
+     * @see readArray(std::span<T, Extent>)
+     */
+    template<typename T, size_t N>
+        requires std::is_trivially_copyable_v<T>
+    bool readArray(std::array<T, N>& data) {
+        return readElements(data.data(), N);
+    }
+
+    /**
+     * @brief reads elements into an array
+     * @see readArray(std::span<T, Extent>)
+     */
+    template<typename T, size_t N>
+        requires std::is_trivially_copyable_v<T>
+    bool readArray(T (&data)[N]) {
+        return readElements(data, N);
+    }
+};
+
+/**
+ * @ingroup Serialization
+ * @brief abstract StreamReadinator base class
+ * @details The StreamReadinator class is an abstract base class for reading
+ *          data from a stream. The stream can be a file, a network socket
+ *          or any other source of data.
+ */
+class StreamReadinator : public ReadinatorHelpers<StreamReadinator> {
+private:
+    std::endian mByteOrder = std::endian::native;
+    IntegerEncoding mIntegerEncoding = IntegerEncoding::FIXED;
+
+public:
+    /**
+     * @brief Destroy the StreamReadinator object
+     */
+    virtual ~StreamReadinator() = default;
+
+    /**
+     * @brief checks if the stream is good
+     *
+     * @return true stream is good
+     * @return false stream is bad
+     */
+    virtual bool isStreamGood() const = 0;
+
+    /**
+     * @brief returns the current stream position
+     *
+     * @return uint64_t the current stream position
+     */
+    virtual uint64_t getStreamPosition() = 0;
+
+    /**
+     * @brief sets the stream position
+     *
+     * @param position the position to set
+     */
+    virtual void setStreamPosition(uint64_t position) = 0;
+
+    /**
+     * @brief reads data from the stream
+     *
+     * @param data the buffer to read into
+     * @param size the size of the buffer
+     */
+    virtual bool readData(char* data, uint64_t size) = 0;
+
+    /**
+     * @brief reads up to a number of bytes from the stream
+     * @details Unlike readData this also succeeds when fewer bytes are left.
+     *
+     * @param data the buffer to read into
+     * @param size the size of the buffer
+     * @return uint64_t the number of bytes read, 0 at the end of the stream
+     */
+    virtual uint64_t readSome(char* data, uint64_t size);
+
+    /**
+     * @brief reads an unsigned LEB128 varint from the stream
+     * @details Read as varint whatever the integer encoding of the stream.
+     *          Reads byte by byte, backends that hold their data in memory
+     *          decode it in place.
+     *
+     * @param value the number
+     * @return true read successful
+     * @return false read failed or the varint is longer than 64 bits
+     */
+    virtual bool readVarint(uint64_t& value);
+
+    /**
+     * @brief reads data from the stream until a delimiter is found
+     *
+     * @param data the buffer to read into
+     * @param delim the delimiter to read until
+     */
+    virtual bool readUntil(std::vector<char>& data, char delim);
+
+    /**
+     * @brief reads data from the stream until a delimiter is found
+     *
+     * @param data the buffer to read into
+     * @param delim the delimiter to read until
+     */
+    virtual bool readUntil(std::vector<char>& data, std::string delim);
+
+    /**
+     * @brief sets the byte order numbers are read in
+     * @details Numbers read with readRaw, readVector, readArray and readMap
+     *          are swapped if the order differs from the one of the host.
+     *          The default is the order of the host.
+     *
+     * @param order the byte order
+     */
+    void setByteOrder(std::endian order) {
+        mByteOrder = order;
+    }
+
+    /**
+     * @brief returns the byte order numbers are read in
+     *
+     * @return std::endian the byte order
+     */
+    std::endian getByteOrder() const {
+        return mByteOrder;
+    }
+
+    /**
+     * @brief sets how integers and lengths are read
+     * @see StreamWritinator::setIntegerEncoding
+     *
+     * @param encoding the encoding
+     */
+    void setIntegerEncoding(IntegerEncoding encoding) {
+        mIntegerEncoding = encoding;
+    }
+
+    /**
+     * @brief returns how integers and lengths are read
+     *
+     * @return IntegerEncoding the encoding
+     */
+    IntegerEncoding getIntegerEncoding() const {
+        return mIntegerEncoding;
+    }
+
+    /**
+     * @brief returns weather the stream is good
+     * 
+     * @return true the stream is good
+     * @return false the stream is bad
+     */
+    operator bool() const {
+        return isStreamGood();
+    }
 };
 
+extern template class ReadinatorHelpers<StreamReadinator>;
+
 } // namespace JSONJay
\ No newline at end of file
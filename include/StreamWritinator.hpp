@@ -10,7 +10,12 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <cstring>
+#include <span>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -18,103 +23,257 @@
 #include <unordered_map>
 
 #include "Common.hpp"
+#include "Varint.hpp"
 
 namespace JSONJay {
 
 /**
  * @ingroup Serialization
- * @brief abstract StreamWritinator base class
- * @details The StreamWritinator class is an abstract base class for writing
- *          data to a stream. The stream can be a file, a network socket
- *          or any other destination for data.
+ * @brief the helpers of a StreamWritinator
+ * @details The helpers write through Self::writeData. StreamWritinator
+ *          instantiates them for itself, so they go through the virtual
+ *          writeData. Final backends such as BufferStreamWritinator also
+ *          instantiate them for their own type. Calls on the concrete type
+ *          are then bound statically, and the compiler can inline them down
+ *          to the copy.
+ *
+ * @tparam Self the class writeData is called on
  */
-class StreamWritinator {
-public:
+template<typename Self>
+class WritinatorHelpers {
+private:
     /**
-     * @brief Destroy the StreamWritinator object
+     * @brief the size of the buffer elements are encoded in before writing
      */
-    virtual ~StreamWritinator() = default;
+    static constexpr size_t kChunkSize = 4096;
 
     /**
-     * @brief checks if the stream is good
+     * @brief the most bytes a value of a type is written as
+     */
+    template<typename T>
+    static constexpr size_t kMaxSize = IsVarintEncodable<T> ? std::max(sizeof(T), kMaxVarintSize) : sizeof(T);
+
+    /**
+     * @brief the zeros writeZero writes from
+     */
+    static constexpr char kZeros[kChunkSize] = {};
+
+    Self& self() {
+        return static_cast<Self&>(*this);
+    }
+
+    /**
+     * @brief check if values of a type have to be swapped before writing
      *
-     * @return true stream is good
-     * @return false stream is bad
+     * @tparam T the type of the values
      */
-    virtual bool isStreamGood() const = 0;
+    template<typename T>
+    bool swapsBytes() {
+        if constexpr ( sizeof(T) > 1 && IsByteSwappable<T> )
+            return self().getByteOrder() != std::endian::native;
+        else
+            return false;
+    }
 
     /**
-     * @brief returns the current stream position
+     * @brief check if values of a type are written as varints
      *
-     * @return uint64_t the current stream position
+     * @tparam T the type of the values
      */
-    virtual uint64_t getStreamPosition() = 0;
+    template<typename T>
+    bool usesVarints() {
+        if constexpr ( IsVarintEncodable<T> )
+            return self().getIntegerEncoding() == IntegerEncoding::VARINT;
+        else
+            return false;
+    }
 
     /**
-     * @brief sets the stream position
+     * @brief copy a value to a buffer in the encoding of the stream
      *
-     * @param position the position to set
+     * @param out where to copy to, at least kMaxSize<T> bytes, moved
+     *        behind the value
+     * @param value the value
      */
-    virtual void setStreamPosition(uint64_t position) = 0;
+    template<typename T>
+    void put(char*& out, const T& value) {
+        if constexpr ( IsVarintEncodable<T> ) {
+            if ( usesVarints<T>() ) {
+                out += encode_varint(to_varint(value), out);
+                return;
+            }
+        }
+        if constexpr ( IsByteSwappable<T> ) {
+            T swapped = swapsBytes<T>() ? swap_bytes(value) : value;
+            std::memcpy(out, &swapped, sizeof(T));
+        } else {
+            std::memcpy(out, &value, sizeof(T));
+        }
+        out += sizeof(T);
+    }
 
     /**
-     * @brief writes data to the stream
+     * @brief writes bytes behind an optional size prefix
      *
-     * @param data the data to write
-     * @param size the size of the data
+     * @param data the bytes
+     * @param size the number of bytes
+     * @param writeSize whether to write the size first
+     */
+    void writeBytes(const char* data, size_t size, bool writeSize) {
+        if ( writeSize )
+            writeRaw(size);
+        self().writeData(data, size);
+    }
+
+    /**
+     * @brief writes trivially copyable elements
+     * @details Without swapping or varints the elements are written with a
+     *          single writeData, else they are encoded in chunks on the stack.
+     *
+     * @param data the elements
+     * @param count the number of elements
      * @return true write successful
      * @return false write failed
      */
-    virtual bool writeData(const char* data, uint64_t size) = 0;
+    template<typename T>
+    bool writeElements(const T* data, size_t count) {
+        if ( !swapsBytes<T>() && !usesVarints<T>() )
+            return self().writeData(reinterpret_cast<const char*>(data), count * sizeof(T));
+
+        char chunk[kChunkSize];
+        constexpr size_t perChunk = kChunkSize / kMaxSize<T>;
+        for ( size_t i = 0; i < count; i += perChunk ) {
+            size_t n = std::min(perChunk, count - i);
+            char* out = chunk;
+            for ( size_t j = 0; j < n; j++ ) put(out, data[i + j]);
+            if ( !self().writeData(chunk, out - chunk) ) return false;
+        }
+        return true;
+    }
 
     /**
-     * @brief check if the stream is good
-     *
-     * @return true stream is good
-     * @return false stream is bad
+     * @brief writes the entries of a map
+     * @details Trivial keys and values are packed into chunks on the stack,
+     *          so a map costs a writeData per chunk instead of two per entry.
      */
-    operator bool() const {
-        return isStreamGood();
+    template<typename Map>
+    void writeEntries(const Map& map, bool writeSize) {
+        using K = typename Map::key_type;
+        using V = typename Map::mapped_type;
+        if ( writeSize )
+            writeRaw<uint32_t>(map.size());
+
+        if constexpr ( std::is_trivial_v<K> && std::is_trivial_v<V> && kMaxSize<K> + kMaxSize<V> <= kChunkSize ) {
+            char chunk[kChunkSize];
+            constexpr size_t perChunk = kChunkSize / (kMaxSize<K> + kMaxSize<V>);
+            char* out = chunk;
+            size_t entries = 0;
+            for ( const auto& [key, value] : map ) {
+                if ( entries == perChunk ) {
+                    self().writeData(chunk, out - chunk);
+                    out = chunk;
+                    entries = 0;
+                }
+                put(out, key);
+                put(out, value);
+                entries++;
+            }
+            if ( entries != 0 ) self().writeData(chunk, out - chunk);
+        } else {
+            for ( const auto& [key, value] : map ) {
+                if constexpr ( std::is_trivial<K>() )
+                    writeRaw(key);
+                else if constexpr ( std::is_same_v<K, std::string> )
+                    writeString(key);
+                else
+                    writeSerializable(key);
+
+                if constexpr ( std::is_trivial<V>() )
+                    writeRaw(value);
+                else if constexpr ( std::is_same_v<V, std::string> )
+                    writeString(value);
+                else
+                    writeSerializable(value);
+            }
+        }
     }
 
+public:
     /**
      * @brief writes a buffer to the stream
      *
      * @param buffer the buffer to write
      * @param writeSize whether to write the size of the buffer
      */
-    void writeBuffer(const std::vector<char>& buffer, bool writeSize = true);
+    void writeBuffer(const std::vector<char>& buffer, bool writeSize = true) {
+        writeBytes(buffer.data(), buffer.size(), writeSize);
+    }
 
     /**
      * @brief writes a zero to the stream
+     * @details The zeros come from a static block, nothing is allocated.
      *
      * @param size the size of the zero
      */
-    void writeZero(uint64_t size);
+    void writeZero(uint64_t size) {
+        while ( size > 0 ) {
+            uint64_t count = std::min<uint64_t>(size, kChunkSize);
+            self().writeData(kZeros, count);
+            size -= count;
+        }
+    }
 
     /**
      * @brief writes a string to the stream
+     * @details The characters are written straight from the string.
      *
      * @param str the string to write
      */
-    void writeString(const std::string& str);
+    void writeString(const std::string& str) {
+        writeBytes(str.data(), str.size(), true);
+    }
 
     /**
      * @brief writes a string to the stream
+     * @details The characters are written straight from the string.
      *
      * @param str the string to write
      */
-    void writeString(std::string_view str);
+    void writeString(std::string_view str) {
+        writeBytes(str.data(), str.size(), true);
+    }
 
     /**
      * @brief writes a raw data to the stream
+     * @details Numbers and enums are written in the byte order of the
+     *          stream, integers as varints if the stream uses them.
      *
      * @tparam T the type of the data
      * @param data the data to write
      */
     template<typename T>
     void writeRaw(const T& data) {
-        writeData(reinterpret_cast<const char*>(&data), sizeof(T));
+        if constexpr ( IsByteSwappable<T> ) {
+            if ( swapsBytes<T>() || usesVarints<T>() ) {
+                char bytes[kMaxSize<T>];
+                char* out = bytes;
+                put(out, data);
+                self().writeData(bytes, out - bytes);
+                return;
+            }
+        }
+        self().writeData(reinterpret_cast<const char*>(&data), sizeof(T));
+    }
+
+    /**
+     * @brief writes an unsigned LEB128 varint to the stream
+     * @details Written as varint whatever the integer encoding of the stream.
+     *
+     * @param value the number to write
+     */
+    void writeVarint(uint64_t value) {
+        char bytes[kMaxVarintSize];
+        self().writeData(bytes, encode_varint(value, bytes));
     }
 
     /**
@@ -126,7 +285,7 @@ public:
     template<typename T>
         requires IsSerializable<T>
     void writeSerializable(const T& data) {
-        T::serialize(*this, data);
+        T::serialize(&self(), data);
     }
 
     /**
@@ -140,25 +299,9 @@ public:
      */
     template<typename K, typename V>
         requires (std::is_trivial_v<K> || IsSerializable<K> || std::is_same_v<K, std::string>) &&
-                 (std::is_trivial_v<V> || IsSerializable<V> || std::is_same_v<K, std::string>)
-        void writeMap(const std::map<K, V>& map, bool writeSize = true) {
-        if ( writeSize )
-            writeRaw<uint32_t>(map.size());
-        for ( const auto& [key, value] : map ) {
-            if constexpr ( std::is_trivial<K>() )
-                writeRaw(key);
-            else if constexpr ( std::is_same_v<K, std::string> )
-                writeString(key);
-            else
-                writeSerializable(key);
-
-            if constexpr ( std::is_trivial<V>() )
-                writeRaw(value);
-            else if constexpr ( std::is_same_v<V, std::string> )
-                writeString(value);
-            else
-                writeSerializable(value);
-        }
+                 (std::is_trivial_v<V> || IsSerializable<V> || std::is_same_v<V, std::string>)
+    void writeMap(const std::map<K, V>& map, bool writeSize = true) {
+        writeEntries(map, writeSize);
     }
 
     /**
@@ -172,49 +315,181 @@ public:
      */
     template<typename K, typename V>
         requires (std::is_trivial_v<K> || IsSerializable<K> || std::is_same_v<K, std::string>) &&
-                 (std::is_trivial_v<V> || IsSerializable<V> || std::is_same_v<K, std::string>)
+                 (std::is_trivial_v<V> || IsSerializable<V> || std::is_same_v<V, std::string>)
     void writeMap(const std::unordered_map<K, V>& map, bool writeSize = true) {
-        if ( writeSize )
-            writeRaw<uint32_t>(map.size());
-        for ( const auto& [key, value] : map ) {
-            if constexpr ( std::is_trivial<K>() )
-                writeRaw(key);
-            else if constexpr ( std::is_same_v<K, std::string> )
-                writeString(key);
-            else
-                writeSerializable(key);
-
-            if constexpr ( std::is_trivial<V>() )
-                writeRaw(value);
-            else if constexpr ( std::is_same_v<V, std::string> )
-                writeString(value);
-            else
-                writeSerializable(value);
-        }
+        writeEntries(map, writeSize);
     }
 
     /**
      * @brief writes a vector to the stream
-     * @note the type must be trivial, serializable or a string
+     * @details Trivially copyable elements are written in one piece.
+     * @note the type must be trivially copyable, serializable or a string
      *
      * @tparam T the type of the vector
      * @param vector the vector to write
      * @param writeSize whether to write the size of the vector
      */
     template<typename T>
-        requires (std::is_trivial_v<T> || IsSerializable<T> || std::is_same_v<T, std::string>)
+        requires (std::is_trivially_copyable_v<T> || IsSerializable<T> || std::is_same_v<T, std::string>)
     void writeVector(const std::vector<T>& vector, bool writeSize = true) {
         if ( writeSize )
             writeRaw<uint32_t>(vector.size());
-        for ( const auto& element : vector ) {
-            if constexpr ( std::is_trivial<T>() )
-                writeRaw(element);
-            else if constexpr ( std::is_same_v<T, std::string> )
-                writeString(element);
-            else
-                writeSerializable(element);
+        if constexpr ( std::is_trivially_copyable_v<T> ) {
+            writeElements(vector.data(), vector.size());
+        } else {
+            for ( const auto& element : vector ) {
+                if constexpr ( std::is_same_v<T, std::string> )
+                    writeString(element);
+                else
+                    writeSerializable(element);
+            }
         }
     }
+
+    /**
+     * @brief writes the elements of a span to the stream
+     * @details The elements are written in one piece without a size, the
+     *          reader has to know it, see ReadinatorHelpers::readArray.
+     *
+     * @tparam T the type of the elements, trivially copyable
+     * @param data the elements
+     * @return true write successful
+     * @return false write failed
+     */
+    template<typename T, size_t Extent>
+        requires std::is_trivially_copyable_v<std::remove_cv_t<T>>
+    bool writeArray(std::span<T, Extent> data) {
+        return writeElements<std::remove_cv_t<T>>(data.data(), data.size());
+    }
+
+    /**
+     * @brief writes the elements of an array to the stream
+     * @see writeArray(std::span<T, Extent>)
+     */
+    template<typename T, size_t N>
+        requires std::is_trivially_copyable_v<T>
+    bool writeArray(const std::array<T, N>& data) {
+        return writeElements(data.data(), N);
+    }
+
+    /**
+     * @brief writes the elements of an array to the stream
+     * @see writeArray(std::span<T, Extent>)
+     */
+    template<typename T, size_t N>
+        requires std::is_trivially_copyable_v<T>
+    bool writeArray(const T (&data)[N]) {
+        return writeElements(data, N);
+    }
 };
 
+/**
+ * @ingroup Serialization
+ * @brief abstract StreamWritinator base class
+ * @details The StreamWritinator class is an abstract base class for writing
+ *          data to a stream. The stream can be a file, a network socket
+ *          or any other destination for data.
+ */
+class StreamWritinator : public WritinatorHelpers<StreamWritinator> {
+private:
+    std::endian mByteOrder = std::endian::native;
+    IntegerEncoding mIntegerEncoding = IntegerEncoding::FIXED;
+
+public:
+    /**
+     * @brief Destroy the StreamWritinator object
+     */
+    virtual ~StreamWritinator() = default;
+
+    /**
+     * @brief checks if the stream is good
+     *
+     * @return true stream is good
+     * @return false stream is bad
+     */
+    virtual bool isStreamGood() const = 0;
+
+    /**
+     * @brief returns the current stream position
+     *
+     * @return uint64_t the current stream position
+     */
+    virtual uint64_t getStreamPosition() = 0;
+
+    /**
+     * @brief sets the stream position
+     *
+     * @param position the position to set
+     */
+    virtual void setStreamPosition(uint64_t position) = 0;
+
+    /**
+     * @brief writes data to the stream
+     *
+     * @param data the data to write
+     * @param size the size of the data
+     * @return true write successful
+     * @return false write failed
+     */
+    virtual bool writeData(const char* data, uint64_t size) = 0;
+
+    /**
+     * @brief sets the byte order numbers are written in
+     * @details Numbers written with writeRaw, writeVector, writeArray and
+     *          writeMap are swapped if the order differs from the one of the
+     *          host, so data can be exchanged between hosts of different byte
+     *          order. The default is the order of the host.
+     *
+     * @param order the byte order
+     */
+    void setByteOrder(std::endian order) {
+        mByteOrder = order;
+    }
+
+    /**
+     * @brief returns the byte order numbers are written in
+     *
+     * @return std::endian the byte order
+     */
+    std::endian getByteOrder() const {
+        return mByteOrder;
+    }
+
+    /**
+     * @brief sets how integers and lengths are written
+     * @details With IntegerEncoding::VARINT the size prefixes of strings,
+     *          buffers, vectors and maps and integers wider than a byte
+     *          written with writeRaw, writeVector, writeArray and writeMap
+     *          become LEB128 varints, signed integers zigzag encoded, so
+     *          small numbers take a single byte. Readers have to use the
+     *          same encoding. The default is IntegerEncoding::FIXED.
+     *
+     * @param encoding the encoding
+     */
+    void setIntegerEncoding(IntegerEncoding encoding) {
+        mIntegerEncoding = encoding;
+    }
+
+    /**
+     * @brief returns how integers and lengths are written
+     *
+     * @return IntegerEncoding the encoding
+     */
+    IntegerEncoding getIntegerEncoding() const {
+        return mIntegerEncoding;
+    }
+
+    /**
+     * @brief check if the stream is good
+     *
+     * @return true stream is good
+     * @return false stream is bad
+     */
+    operator bool() const {
+        return isStreamGood();
+    }
+};
+
+extern template class WritinatorHelpers<StreamWritinator>;
+
 } // namespace JSONJay
\ No newline at end of file
@@ -0,0 +1,103 @@
+/**
+ * @file StructuralIndex.hpp
+ * @author TL044CN
+ * @brief StructuralIndex class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Isa.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Parsing
+ * @brief positions of the structural characters of a JSON text
+ * @details Stage one of the JSON parser. The text is classified in blocks of
+ *          64 bytes with vector compares, the resulting bitmasks are used to
+ *          skip escaped characters and string contents. What remains are the
+ *          positions of
+ *          - the operators { } [ ] : , outside of strings
+ *          - the opening and closing quotes of every string
+ *          - the first character of every number and literal
+ * @see JSONParser
+ */
+class StructuralIndex {
+public:
+    /**
+     * @brief the smallest part of a text indexed by one task
+     */
+    static constexpr size_t kMinChunkSize = 64 * 1024;
+
+private:
+    std::vector<uint32_t> mPositions;
+
+public:
+    /**
+     * @brief index a JSON text
+     * @throws InvalidFormatException if a string is not terminated or contains
+     *         a control character, or if the text is 4 GiB or larger
+     *
+     * @param text the JSON text
+     * @param isa the instruction set to classify the text with
+     */
+    void build(std::string_view text, Isa isa = detected_isa());
+
+    /**
+     * @brief index a JSON text on a ThreadPool
+     * @details The text is cut into chunks that are indexed in parallel,
+     *          each guessed to start outside of a string. Escapes at the
+     *          chunk boundaries are read off the text directly. Once all
+     *          chunks are done the real string state at every boundary is
+     *          known, and the chunks that were guessed wrong are indexed
+     *          again. Texts too small to split are indexed on the calling
+     *          thread.
+     * @throws InvalidFormatException like build
+     *
+     * @param text the JSON text
+     * @param pool the pool to run the chunks on
+     * @param isa the instruction set to classify the text with
+     */
+    void build(std::string_view text, ThreadPool& pool, Isa isa = detected_isa());
+
+    /**
+     * @brief Get the positions of the structural characters
+     *
+     * @return std::span<const uint32_t> the positions, ascending
+     */
+    std::span<const uint32_t> positions() const noexcept {
+        return mPositions;
+    }
+
+    /**
+     * @brief Get the number of structural characters
+     *
+     * @return size_t the number of structural characters
+     */
+    size_t size() const noexcept {
+        return mPositions.size();
+    }
+
+    /**
+     * @brief Get the position of a structural character
+     *
+     * @param index the index of the structural character
+     * @return uint32_t the position in the text
+     */
+    uint32_t operator[](size_t index) const noexcept {
+        return mPositions[index];
+    }
+};
+
+} // namespace JSONJay
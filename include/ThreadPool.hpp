@@ -0,0 +1,114 @@
+/**
+ * @file ThreadPool.hpp
+ * @author TL044CN
+ * @brief ThreadPool class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Parsing
+ * @brief ThreadPool class
+ * @details A fixed set of worker threads with one task queue each. Workers
+ *          take tasks from the back of their own queue and steal from the
+ *          front of the others when it runs dry. Tasks submitted from inside
+ *          a worker go to that worker's queue, others are spread round robin.
+ *          Tasks receive the index of the worker running them, which lets
+ *          callers keep per-worker state without locking.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief a task, called with the index of the worker running it
+     */
+    using task_t = std::function<void(size_t)>;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<task_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> mQueues;
+    std::vector<std::thread> mThreads;
+
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mIdle;
+    size_t mQueued = 0;     ///< tasks waiting in a queue
+    size_t mPending = 0;    ///< tasks waiting or running
+    size_t mNextQueue = 0;
+    bool mStop = false;
+    std::exception_ptr mError;
+
+    /**
+     * @brief take a task, stealing from other workers if needed
+     *
+     * @param worker the index of the worker
+     * @param task the task taken
+     * @return true a task was taken
+     * @return false all queues are empty
+     */
+    bool take(size_t worker, task_t& task);
+
+    void run(size_t worker);
+
+public:
+    /**
+     * @brief Construct a new ThreadPool
+     *
+     * @param threads the number of workers, at least one is started
+     */
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Destroy the ThreadPool
+     * @details Runs the remaining tasks and joins the workers.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Get the number of workers
+     *
+     * @return size_t the number of workers
+     */
+    size_t size() const noexcept {
+        return mThreads.size();
+    }
+
+    /**
+     * @brief queue a task
+     *
+     * @param task the task
+     */
+    void submit(task_t task);
+
+    /**
+     * @brief wait until all tasks have run
+     * @details Rethrows the first exception thrown by a task since the last
+     *          call.
+     */
+    void wait();
+};
+
+} // namespace JSONJay
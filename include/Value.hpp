@@ -0,0 +1,341 @@
+/**
+ * @file Value.hpp
+ * @author TL044CN
+ * @brief Value class header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+#include "Exceptions.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace JSONJay {
+
+/**
+ * @ingroup StorageClasses
+ * @brief the type returned when accessing an element of type T
+ * @details Strings are handed out as views because short strings live
+ *          inside the Value itself.
+ *
+ * @tparam T the element type
+ */
+template<typename T>
+struct value_reference {
+    using type = T&;
+};
+
+template<>
+struct value_reference<std::string> {
+    using type = std::string_view;
+};
+
+template<>
+struct value_reference<std::monostate> {
+    using type = std::monostate;
+};
+
+template<typename T>
+using value_reference_t = typename value_reference<T>::type;
+
+/**
+ * @ingroup StorageClasses
+ * @brief the type returned when reading an element of type T by value
+ *
+ * @tparam T the element type
+ */
+template<typename T>
+using value_copy_t = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
+/**
+ * @ingroup StorageClasses
+ * @brief Compact tagged value of the Storage Classes
+ * @details A Value is 16 bytes: a one byte type tag followed by the payload.
+ *          Strings of up to kInlineCapacity bytes are stored inline, longer
+ *          strings live out of line in memory of the owning container's
+ *          allocator.
+ *          Values do not free anything on their own. The owning Object or
+ *          List releases strings and nested nodes through destroy().
+ * @see BaseDataType
+ */
+class Value {
+public:
+    /**
+     * @brief the longest string that is stored inline
+     */
+    static constexpr size_t kInlineCapacity = 14;
+
+private:
+    /**
+     * @brief marks a string as stored out of line
+     */
+    static constexpr uint8_t kHeapString = 0xFF;
+
+    // All members share the tag and size bytes as their common initial
+    // sequence, so the tag can be read no matter which member is active.
+
+    struct Scalar {
+        BaseDataType type;
+        uint8_t      size;
+        union {
+            int     i;
+            double  d;
+            bool    b;
+            Object* object;
+            List*   list;
+        };
+    };
+
+    struct InlineString {
+        BaseDataType type;
+        uint8_t      size;
+        char         data[kInlineCapacity];
+    };
+
+    struct HeapString {
+        BaseDataType type;
+        uint8_t      size;
+        uint32_t     length;
+        char*        data;
+    };
+
+    union {
+        Scalar       mScalar;
+        InlineString mInline;
+        HeapString   mHeap;
+    };
+
+public:
+    /**
+     * @brief get the BaseDataType matching a C++ type
+     *
+     * @tparam T the type
+     * @return BaseDataType the matching data type
+     */
+    template<typename T>
+        requires IsValidDataType<T>
+    static constexpr BaseDataType type_of() {
+        if      constexpr ( std::is_same_v<T, std::string> )    return BaseDataType::STRING;
+        else if constexpr ( std::is_same_v<T, int> )            return BaseDataType::INT;
+        else if constexpr ( std::is_same_v<T, double> )         return BaseDataType::DOUBLE;
+        else if constexpr ( std::is_same_v<T, bool> )           return BaseDataType::BOOL;
+        else if constexpr ( std::is_same_v<T, Object*> )        return BaseDataType::OBJECT;
+        else if constexpr ( std::is_same_v<T, List*> )          return BaseDataType::LIST;
+        else                                                    return BaseDataType::NONE;
+    }
+
+    /**
+     * @brief Construct an empty Value
+     */
+    Value() noexcept : mScalar() {
+        mScalar.type = BaseDataType::NONE;
+    }
+
+    /**
+     * @brief Construct an integer Value
+     *
+     * @param value the integer
+     */
+    explicit Value(int value) noexcept : mScalar() {
+        mScalar.type = BaseDataType::INT;
+        mScalar.i = value;
+    }
+
+    /**
+     * @brief Construct a double Value
+     *
+     * @param value the double
+     */
+    explicit Value(double value) noexcept : mScalar() {
+        mScalar.type = BaseDataType::DOUBLE;
+        mScalar.d = value;
+    }
+
+    /**
+     * @brief Construct a boolean Value
+     *
+     * @param value the boolean
+     */
+    explicit Value(bool value) noexcept : mScalar() {
+        mScalar.type = BaseDataType::BOOL;
+        mScalar.b = value;
+    }
+
+    /**
+     * @brief Construct an Object Value
+     *
+     * @param value the Object, owned by the container of the Value
+     */
+    explicit Value(Object* value) noexcept : mScalar() {
+        mScalar.type = BaseDataType::OBJECT;
+        mScalar.object = value;
+    }
+
+    /**
+     * @brief Construct a List Value
+     *
+     * @param value the List, owned by the container of the Value
+     */
+    explicit Value(List* value) noexcept : mScalar() {
+        mScalar.type = BaseDataType::LIST;
+        mScalar.list = value;
+    }
+
+    /**
+     * @brief Construct a string Value
+     * @throws InvalidValueException if the string is 4 GiB or longer
+     *
+     * @param value the string
+     * @param allocator the allocator for strings that do not fit inline
+     */
+    Value(std::string_view value, const node_allocator_t& allocator);
+
+    /**
+     * @brief Construct a Value from any valid data type
+     * @note Object and List pointers are stored as they are, the caller is
+     *       responsible for handing over ownership.
+     *
+     * @tparam T the type of the value
+     * @param value the value
+     * @param allocator the allocator for strings that do not fit inline
+     * @return Value the new Value
+     */
+    template<typename T>
+        requires IsValidDataType<T>
+    static Value make(const T& value, const node_allocator_t& allocator) {
+        if      constexpr ( std::is_same_v<T, std::string> )    return Value(std::string_view(value), allocator);
+        else if constexpr ( std::is_same_v<T, std::monostate> ) return Value();
+        else                                                    return Value(value);
+    }
+
+    /**
+     * @brief Get the type of the Value
+     *
+     * @return BaseDataType the type
+     */
+    BaseDataType type() const noexcept {
+        return mScalar.type;
+    }
+
+    /**
+     * @brief check if the Value holds a type
+     *
+     * @tparam T the type to check
+     * @return true the Value holds T
+     * @return false the Value holds another type
+     */
+    template<typename T>
+        requires IsValidDataType<T>
+    bool holds() const noexcept {
+        return type() == type_of<T>();
+    }
+
+    /**
+     * @brief Get the string of a string Value
+     * @warning Views of short strings point into the Value and are
+     *          invalidated when the Value is moved or modified.
+     *
+     * @return std::string_view the string
+     */
+    std::string_view as_string() const noexcept {
+        if ( mScalar.size == kHeapString ) return std::string_view(mHeap.data, mHeap.length);
+        return std::string_view(mInline.data, mInline.size);
+    }
+
+    /**
+     * @brief Get the content of the Value
+     * @throws InvalidTypeException if the Value does not hold T
+     *
+     * @tparam T the type of the content
+     * @return value_reference_t<T> the content
+     */
+    template<typename T>
+        requires IsValidDataType<T>
+    value_reference_t<T> get() {
+        if ( !holds<T>() ) throw InvalidTypeException("Invalid type");
+        if      constexpr ( std::is_same_v<T, std::string> )    return as_string();
+        else if constexpr ( std::is_same_v<T, int> )            return mScalar.i;
+        else if constexpr ( std::is_same_v<T, double> )         return mScalar.d;
+        else if constexpr ( std::is_same_v<T, bool> )           return mScalar.b;
+        else if constexpr ( std::is_same_v<T, Object*> )        return mScalar.object;
+        else if constexpr ( std::is_same_v<T, List*> )          return mScalar.list;
+        else                                                    return std::monostate();
+    }
+
+    /**
+     * @brief Get a copy of the content of the Value
+     * @throws InvalidTypeException if the Value does not hold T
+     *
+     * @tparam T the type of the content
+     * @return value_copy_t<T> the content
+     */
+    template<typename T>
+        requires IsValidDataType<T>
+    value_copy_t<T> get() const {
+        return const_cast<Value*>(this)->get<T>();
+    }
+
+    /**
+     * @brief Get a pointer to the content of the Value
+     * @details Strings have no pointer to hand out, see as_string.
+     *
+     * @tparam T the type of the content
+     * @return T* the content or nullptr if the Value does not hold T
+     */
+    template<typename T>
+        requires IsValidDataType<T> && (!std::is_same_v<T, std::string>) && (!std::is_same_v<T, std::monostate>)
+    T* get_if() noexcept {
+        if ( !holds<T>() ) return nullptr;
+        if      constexpr ( std::is_same_v<T, int> )            return &mScalar.i;
+        else if constexpr ( std::is_same_v<T, double> )         return &mScalar.d;
+        else if constexpr ( std::is_same_v<T, bool> )           return &mScalar.b;
+        else if constexpr ( std::is_same_v<T, Object*> )        return &mScalar.object;
+        else                                                    return &mScalar.list;
+    }
+
+    /**
+     * @brief release the string or nested node held by the Value
+     * @details The Value is empty afterwards.
+     *
+     * @param allocator the allocator of the owning container
+     */
+    void destroy(const node_allocator_t& allocator) noexcept;
+
+    /**
+     * @brief move the Value into the memory of another allocator
+     * @details Out of line strings and nested nodes are recreated with the
+     *          new allocator and released from the old one.
+     *
+     * @param from the allocator of the current owner
+     * @param to the allocator of the new owner
+     * @return Value the relocated Value
+     */
+    Value relocate(const node_allocator_t& from, const node_allocator_t& to);
+
+};
+
+static_assert(sizeof(Value) == 16, "Value must stay 16 bytes");
+static_assert(std::is_trivially_copyable_v<Value>, "Value must stay trivially copyable");
+
+/**
+ * @brief Get the type of the data
+ *
+ * @param data the data to get the type of
+ * @return BaseDataType the type of the data
+ */
+inline BaseDataType get_type(const storage_t& data) noexcept {
+    return data.type();
+}
+
+} // namespace JSONJay
@@ -0,0 +1,183 @@
+/**
+ * @file Varint.hpp
+ * @author TL044CN
+ * @brief LEB128 varints and zigzag encoding
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace JSONJay {
+
+/**
+ * @ingroup Serialization
+ * @brief how the stream helpers write integers and lengths
+ */
+enum class IntegerEncoding : uint8_t {
+    FIXED,      ///< at their native width
+    VARINT      ///< as LEB128 varints, signed integers zigzag encoded first
+};
+
+/**
+ * @interface IsVarintEncodable
+ * @ingroup Serialization
+ * @brief checks if a type is written as varint in IntegerEncoding::VARINT
+ * @details Single bytes would not get any shorter and stay as they are.
+ *
+ * @tparam T the type to check
+ */
+template<typename T>
+concept IsVarintEncodable = std::integral<T> && sizeof(T) > 1;
+
+/**
+ * @ingroup Serialization
+ * @brief the longest varint of a 64 bit number
+ */
+constexpr size_t kMaxVarintSize = 10;
+
+/**
+ * @ingroup Serialization
+ * @brief write an unsigned LEB128 varint
+ *
+ * @param value the number
+ * @param out where to write, at least kMaxVarintSize bytes
+ * @return size_t the number of bytes written
+ */
+inline size_t encode_varint(uint64_t value, char* out) noexcept {
+    size_t size = 0;
+    while ( value >= 0x80 ) {
+        out[size++] = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<char>(value);
+    return size;
+}
+
+/**
+ * @ingroup Serialization
+ * @brief read an unsigned LEB128 varint
+ * @details Single bytes are returned right away. With 8 bytes at hand
+ *          varints of up to 8 bytes are decoded from one load without a
+ *          loop: the end is found from the continuation bits and the 7 bit
+ *          groups are packed together with three shift and mask steps.
+ *          Longer varints and the last bytes of the input take the loop.
+ *
+ * @param in the bytes
+ * @param size the number of bytes at hand
+ * @param value the number
+ * @return size_t the number of bytes used, 0 if the varint is cut off or
+ *         longer than a 64 bit number
+ */
+inline size_t decode_varint(const char* in, size_t size, uint64_t& value) noexcept {
+    if ( size != 0 && static_cast<uint8_t>(in[0]) < 0x80 ) {
+        value = static_cast<uint8_t>(in[0]);
+        return 1;
+    }
+
+    if ( size >= 8 ) {
+        uint64_t word;
+        std::memcpy(&word, in, sizeof(word));
+        if constexpr ( std::endian::native == std::endian::big ) word = swap_bytes(word);
+        uint64_t stops = ~word & 0x8080808080808080ull;
+        if ( stops != 0 ) {
+            size_t length = std::countr_zero(stops) / 8 + 1;
+            word &= 0x7F7F7F7F7F7F7F7Full >> (64 - 8 * length);
+            word = ((word & 0x7F007F007F007F00ull) >> 1) | (word & 0x007F007F007F007Full);
+            word = ((word & 0x3FFF00003FFF0000ull) >> 2) | (word & 0x00003FFF00003FFFull);
+            word = ((word & 0x0FFFFFFF00000000ull) >> 4) | (word & 0x000000000FFFFFFFull);
+            value = word;
+            return length;
+        }
+    }
+
+    uint64_t result = 0;
+    for ( size_t i = 0; i < size && i < kMaxVarintSize; i++ ) {
+        uint8_t byte = static_cast<uint8_t>(in[i]);
+        result |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if ( (byte & 0x80) == 0 ) {
+            // the tenth byte only holds the highest bit
+            if ( i == kMaxVarintSize - 1 && byte > 1 ) return 0;
+            value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @ingroup Serialization
+ * @brief map a signed number to an unsigned one with small magnitudes first
+ * @details 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+ *
+ * @param value the signed number
+ * @return uint64_t the unsigned number
+ */
+constexpr uint64_t zigzag_encode(int64_t value) noexcept {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+/**
+ * @ingroup Serialization
+ * @brief undo zigzag_encode
+ *
+ * @param value the unsigned number
+ * @return int64_t the signed number
+ */
+constexpr int64_t zigzag_decode(uint64_t value) noexcept {
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+/**
+ * @ingroup Serialization
+ * @brief get the varint of an integer
+ *
+ * @tparam T the type of the integer
+ * @param value the integer
+ * @return uint64_t the number to write as varint
+ */
+template<typename T>
+    requires IsVarintEncodable<T>
+constexpr uint64_t to_varint(T value) noexcept {
+    if constexpr ( std::is_signed_v<T> )
+        return zigzag_encode(value);
+    else
+        return value;
+}
+
+/**
+ * @ingroup Serialization
+ * @brief get an integer from its varint
+ *
+ * @tparam T the type of the integer
+ * @param varint the number read as varint
+ * @param value the integer
+ * @return true the number fits into the type
+ * @return false the number is out of range, value is unchanged
+ */
+template<typename T>
+    requires IsVarintEncodable<T>
+constexpr bool from_varint(uint64_t varint, T& value) noexcept {
+    if constexpr ( std::is_signed_v<T> ) {
+        int64_t number = zigzag_decode(varint);
+        if ( number < std::numeric_limits<T>::min() || number > std::numeric_limits<T>::max() ) return false;
+        value = static_cast<T>(number);
+    } else {
+        if ( varint > std::numeric_limits<T>::max() ) return false;
+        value = static_cast<T>(varint);
+    }
+    return true;
+}
+
+} // namespace JSONJay
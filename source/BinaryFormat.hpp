@@ -0,0 +1,71 @@
+/**
+ * @file BinaryFormat.hpp
+ * @author TL044CN
+ * @brief layout of the tagged binary encoding
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Varint.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace JSONJay {
+
+// A binary document is the magic, a varint with the size of the payload and
+// the payload: the root Object or List as a tagged value.
+//
+// value   := tag payload
+// Object  := varint count, count * (varint size, key bytes, value)
+// List    := varint count, count * value
+// *_LIST  := varint count, count * little endian scalar, bools one byte each
+// STRING  := varint size, bytes
+// INT     := 4 bytes little endian, DOUBLE := 8 bytes little endian
+
+/**
+ * @brief the first bytes of every binary document, the last one is the version
+ */
+constexpr char kBinaryMagic[4] = { 'J', 'J', 'B', 1 };
+
+/**
+ * @brief the type tag in front of every encoded value
+ */
+enum class BinaryTag : uint8_t {
+    NONE,
+    FALSE,
+    TRUE,
+    INT,
+    DOUBLE,
+    STRING,
+    OBJECT,
+    LIST,
+    INT_LIST,       ///< a List in typed int storage
+    DOUBLE_LIST,    ///< a List in typed double storage
+    BOOL_LIST       ///< a List in typed bool storage
+};
+
+/**
+ * @brief copy a number to or from its little endian bytes
+ *
+ * @tparam T the type of the number
+ * @param to where to copy to
+ * @param from where to copy from
+ */
+template<typename T>
+void copy_little_endian(void* to, const void* from) noexcept {
+    std::memcpy(to, from, sizeof(T));
+    if constexpr ( std::endian::native == std::endian::big ) {
+        char* bytes = static_cast<char*>(to);
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+}
+
+} // namespace JSONJay
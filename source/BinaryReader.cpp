@@ -0,0 +1,194 @@
+#include "BinaryReader.hpp"
+#include "BinaryFormat.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace JSONJay {
+
+BaseDataType BinaryReader::load(StreamReadinator& reader) {
+    char magic[sizeof(kBinaryMagic)];
+    if ( !reader.readData(magic, sizeof(magic)) ) throw InvalidFormatException("Unexpected end of binary data");
+    if ( std::memcmp(magic, kBinaryMagic, sizeof(magic)) != 0 ) throw InvalidFormatException("Not a binary document");
+
+    uint64_t size = 0;
+    if ( !reader.readVarint(size) ) throw InvalidFormatException("Invalid varint");
+
+    // the size is not trusted: read in chunks that double with what has
+    // arrived, so a short stream fails before much memory is committed
+    mInput.clear();
+    while ( mInput.size() < size ) {
+        size_t offset = mInput.size();
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(size - offset, std::max(offset, kLoadChunkSize)));
+        mInput.resize(offset + chunk);
+        uint64_t count = reader.readSome(mInput.data() + offset, chunk);
+        mInput.resize(offset + count);
+        if ( count == 0 ) throw InvalidFormatException("Unexpected end of binary data");
+    }
+    mCursor = mInput.data();
+    mEnd = mCursor + mInput.size();
+
+    switch ( static_cast<BinaryTag>(*take(1)) ) {
+        case BinaryTag::OBJECT:
+            return BaseDataType::OBJECT;
+        case BinaryTag::LIST:
+        case BinaryTag::INT_LIST:
+        case BinaryTag::DOUBLE_LIST:
+        case BinaryTag::BOOL_LIST:
+            mCursor--;
+            return BaseDataType::LIST;
+        default:
+            throw InvalidFormatException("Binary root must be an Object or a List");
+    }
+}
+
+const char* BinaryReader::take(size_t count) {
+    if ( static_cast<size_t>(mEnd - mCursor) < count ) throw InvalidFormatException("Unexpected end of binary data");
+    const char* data = mCursor;
+    mCursor += count;
+    return data;
+}
+
+uint64_t BinaryReader::read_varint() {
+    uint64_t value = 0;
+    size_t size = decode_varint(mCursor, mEnd - mCursor, value);
+    if ( size == 0 ) throw InvalidFormatException("Invalid varint");
+    mCursor += size;
+    return value;
+}
+
+std::string_view BinaryReader::read_string() {
+    uint64_t size = read_varint();
+    if ( size > static_cast<size_t>(mEnd - mCursor) ) throw InvalidFormatException("Unexpected end of binary data");
+    return std::string_view(take(size), size);
+}
+
+template<typename Insert>
+void BinaryReader::read_value(size_t depth, Insert&& insert) {
+    uint8_t tag = static_cast<uint8_t>(*take(1));
+    switch ( static_cast<BinaryTag>(tag) ) {
+        case BinaryTag::NONE:
+            insert(std::type_identity<std::monostate>());
+            break;
+        case BinaryTag::FALSE:
+            insert(std::type_identity<bool>(), false);
+            break;
+        case BinaryTag::TRUE:
+            insert(std::type_identity<bool>(), true);
+            break;
+        case BinaryTag::INT: {
+            int value;
+            copy_little_endian<int>(&value, take(sizeof(int)));
+            insert(std::type_identity<int>(), value);
+            break;
+        }
+        case BinaryTag::DOUBLE: {
+            double value;
+            copy_little_endian<double>(&value, take(sizeof(double)));
+            insert(std::type_identity<double>(), value);
+            break;
+        }
+        case BinaryTag::STRING:
+            insert(std::type_identity<std::string>(), read_string());
+            break;
+        case BinaryTag::OBJECT:
+            read_object(insert(std::type_identity<Object>()), depth + 1);
+            break;
+        case BinaryTag::LIST:
+        case BinaryTag::INT_LIST:
+        case BinaryTag::DOUBLE_LIST:
+        case BinaryTag::BOOL_LIST:
+            read_list(insert(std::type_identity<List>()), tag, depth + 1);
+            break;
+        default:
+            throw InvalidFormatException("Invalid binary tag");
+    }
+}
+
+void BinaryReader::read_object(Object& object, size_t depth) {
+    if ( depth > kMaxDepth ) throw InvalidFormatException("Binary nesting too deep");
+
+    uint64_t count = read_varint();
+    for ( uint64_t i = 0; i < count; i++ ) {
+        std::string_view key = read_string();
+        read_value(depth, [&](auto type, auto&&... args) -> decltype(auto) {
+            using T = typename decltype(type)::type;
+            return object.emplace_member<T>(key, std::forward<decltype(args)>(args)...);
+        });
+    }
+}
+
+template<typename T>
+void BinaryReader::read_scalars(List& list) {
+    uint64_t count = read_varint();
+    if ( count > static_cast<size_t>(mEnd - mCursor) / sizeof(T) ) throw InvalidFormatException("Unexpected end of binary data");
+    const char* data = take(count * sizeof(T));
+
+    list.reserve(list.size() + count);
+    for ( uint64_t i = 0; i < count; i++ ) {
+        if constexpr ( std::is_same_v<T, bool> ) {
+            // any other byte would be an invalid bool
+            if ( static_cast<uint8_t>(data[i]) > 1 ) throw InvalidFormatException("Invalid bool");
+            list.emplace_back<bool>(data[i] != 0);
+        } else {
+            T value;
+            copy_little_endian<T>(&value, data + i * sizeof(T));
+            list.emplace_back<T>(value);
+        }
+    }
+}
+
+void BinaryReader::read_list(List& list, uint8_t tag, size_t depth) {
+    if ( depth > kMaxDepth ) throw InvalidFormatException("Binary nesting too deep");
+
+    switch ( static_cast<BinaryTag>(tag) ) {
+        case BinaryTag::INT_LIST:    read_scalars<int>(list); return;
+        case BinaryTag::DOUBLE_LIST: read_scalars<double>(list); return;
+        case BinaryTag::BOOL_LIST:   read_scalars<bool>(list); return;
+        default: break;
+    }
+
+    // every element takes at least its tag
+    uint64_t count = read_varint();
+    if ( count > static_cast<size_t>(mEnd - mCursor) ) throw InvalidFormatException("Unexpected end of binary data");
+    list.reserve(list.size() + count);
+    for ( uint64_t i = 0; i < count; i++ ) {
+        read_value(depth, [&](auto type, auto&&... args) -> decltype(auto) {
+            using T = typename decltype(type)::type;
+            return list.emplace_back<T>(std::forward<decltype(args)>(args)...);
+        });
+    }
+}
+
+void BinaryReader::finish() {
+    mInput.clear();
+    bool complete = mCursor == mEnd;
+    mCursor = mEnd = nullptr;
+    if ( !complete ) throw InvalidFormatException("Unexpected data after the binary value");
+}
+
+Document BinaryReader::read(StreamReadinator& reader, std::pmr::memory_resource* upstream) {
+    BaseDataType rootType = load(reader);
+
+    // the tree takes about as much memory as its encoding
+    Document document(rootType, std::max(Document::kDefaultBlockSize, mInput.size()), upstream);
+    if ( rootType == BaseDataType::OBJECT ) read_object(document.object(), 1);
+    else read_list(document.list(), static_cast<uint8_t>(*take(1)), 1);
+    finish();
+    return document;
+}
+
+void BinaryReader::read(StreamReadinator& reader, Object& object) {
+    if ( load(reader) != BaseDataType::OBJECT ) throw InvalidFormatException("Expected an Object");
+    read_object(object, 1);
+    finish();
+}
+
+void BinaryReader::read(StreamReadinator& reader, List& list) {
+    if ( load(reader) != BaseDataType::LIST ) throw InvalidFormatException("Expected a List");
+    read_list(list, static_cast<uint8_t>(*take(1)), 1);
+    finish();
+}
+
+} // namespace JSONJay
@@ -0,0 +1,134 @@
+#include "BinaryWriter.hpp"
+#include "BinaryFormat.hpp"
+
+namespace JSONJay {
+
+void BinaryWriter::write_varint(uint64_t value) {
+    mUsed += encode_varint(value, room(kMaxVarintSize));
+}
+
+void BinaryWriter::write_string(std::string_view string) {
+    write_varint(string.size());
+    std::memcpy(room(string.size()), string.data(), string.size());
+    mUsed += string.size();
+}
+
+void BinaryWriter::write_value(const Value& value) {
+    switch ( value.type() ) {
+        case BaseDataType::STRING:
+            put(static_cast<char>(BinaryTag::STRING));
+            write_string(value.as_string());
+            break;
+        case BaseDataType::INT: {
+            int number = value.get<int>();
+            char* out = room(1 + sizeof(int));
+            out[0] = static_cast<char>(BinaryTag::INT);
+            copy_little_endian<int>(out + 1, &number);
+            mUsed += 1 + sizeof(int);
+            break;
+        }
+        case BaseDataType::DOUBLE: {
+            double number = value.get<double>();
+            char* out = room(1 + sizeof(double));
+            out[0] = static_cast<char>(BinaryTag::DOUBLE);
+            copy_little_endian<double>(out + 1, &number);
+            mUsed += 1 + sizeof(double);
+            break;
+        }
+        case BaseDataType::BOOL:
+            put(static_cast<char>(value.get<bool>() ? BinaryTag::TRUE : BinaryTag::FALSE));
+            break;
+        case BaseDataType::OBJECT:
+            write_object(*value.get<Object*>());
+            break;
+        case BaseDataType::LIST:
+            write_list(*value.get<List*>());
+            break;
+        default:
+            put(static_cast<char>(BinaryTag::NONE));
+            break;
+    }
+}
+
+void BinaryWriter::write_object(const Object& object) {
+    put(static_cast<char>(BinaryTag::OBJECT));
+    write_varint(object.members().size());
+    for ( const MemberStore::Member& member : object.members() ) {
+        write_string(member.key());
+        write_value(member.value);
+    }
+}
+
+template<typename T>
+void BinaryWriter::write_scalars(std::span<const T> values) {
+    write_varint(values.size());
+    char* out = room(values.size() * sizeof(T));
+    if constexpr ( std::endian::native == std::endian::little || sizeof(T) == 1 ) {
+        std::memcpy(out, values.data(), values.size_bytes());
+    } else {
+        for ( size_t i = 0; i < values.size(); i++ ) copy_little_endian<T>(out + i * sizeof(T), &values[i]);
+    }
+    mUsed += values.size_bytes();
+}
+
+void BinaryWriter::write_list(const List& list) {
+    switch ( list.element_type() ) {
+        case BaseDataType::INT:
+            put(static_cast<char>(BinaryTag::INT_LIST));
+            write_scalars(list.ints());
+            break;
+        case BaseDataType::DOUBLE:
+            put(static_cast<char>(BinaryTag::DOUBLE_LIST));
+            write_scalars(list.doubles());
+            break;
+        case BaseDataType::BOOL:
+            put(static_cast<char>(BinaryTag::BOOL_LIST));
+            write_scalars(list.bools());
+            break;
+        default:
+            put(static_cast<char>(BinaryTag::LIST));
+            write_varint(list.values().size());
+            for ( const Value& value : list.values() ) write_value(value);
+            break;
+    }
+}
+
+template<typename Write>
+bool BinaryWriter::run(StreamWritinator& stream, Write&& write) {
+    // leave room for the header in front of the payload
+    constexpr size_t kHeaderSize = sizeof(kBinaryMagic) + kMaxVarintSize;
+    mUsed = 0;
+    room(kHeaderSize);
+    mUsed = kHeaderSize;
+    try {
+        write();
+    } catch ( ... ) {
+        mUsed = 0;
+        throw;
+    }
+
+    char header[kHeaderSize];
+    std::memcpy(header, kBinaryMagic, sizeof(kBinaryMagic));
+    size_t headerSize = sizeof(kBinaryMagic) + encode_varint(mUsed - kHeaderSize, header + sizeof(kBinaryMagic));
+    char* begin = mBuffer.data() + kHeaderSize - headerSize;
+    std::memcpy(begin, header, headerSize);
+
+    bool good = stream.writeData(begin, mUsed - (kHeaderSize - headerSize));
+    mUsed = 0;
+    return good && stream.isStreamGood();
+}
+
+bool BinaryWriter::write(StreamWritinator& stream, const Object& object) {
+    return run(stream, [&] { write_object(object); });
+}
+
+bool BinaryWriter::write(StreamWritinator& stream, const List& list) {
+    return run(stream, [&] { write_list(list); });
+}
+
+bool BinaryWriter::write(StreamWritinator& stream, const Document& document) {
+    if ( document.root_type() == BaseDataType::OBJECT ) return write(stream, document.object());
+    return write(stream, document.list());
+}
+
+} // namespace JSONJay
@@ -1,9 +1,14 @@
 #include "BufferStreamReadinator.hpp"
+#include "DelimiterSearch.hpp"
+
+#include <algorithm>
+#include <cstring>
 
 namespace JSONJay {
 
 BufferStreamReadinator::BufferStreamReadinator() : position(0) {}
 BufferStreamReadinator::BufferStreamReadinator(const std::vector<char>& buffer) : buffer(buffer), position(0) {}
+BufferStreamReadinator::BufferStreamReadinator(std::vector<char>&& buffer) : buffer(std::move(buffer)), position(0) {}
 
 BufferStreamReadinator::~BufferStreamReadinator() {}
 
@@ -20,17 +25,36 @@ void BufferStreamReadinator::setStreamPosition(uint64_t position) {
     this->position = position;
 }
 
-bool BufferStreamReadinator::readData(char* data, uint64_t size) {
-    if (position + size > buffer.size()) {
-        return false;
-    }
+uint64_t BufferStreamReadinator::readSome(char* data, uint64_t size) {
+    if ( position >= buffer.size() ) return 0;
+    uint64_t count = std::min<uint64_t>(size, buffer.size() - position);
+    std::memcpy(data, buffer.data() + position, count);
+    position += count;
+    return count;
+}
 
-    for (uint64_t i = 0; i < size; i++) {
-        data[i] = buffer[position + i];
-    }
+bool BufferStreamReadinator::readUntil(std::vector<char>& data, char delim) {
+    std::string_view view;
+    bool found = readViewUntil(view, std::string_view(&delim, 1));
+    data.insert(data.end(), view.begin(), view.end());
+    return found;
+}
+
+bool BufferStreamReadinator::readUntil(std::vector<char>& data, std::string delim) {
+    std::string_view view;
+    bool found = readViewUntil(view, delim);
+    data.insert(data.end(), view.begin(), view.end());
+    return found;
+}
 
-    position += size;
-    return true;
+bool BufferStreamReadinator::readViewUntil(std::string_view& view, std::string_view delim) {
+    std::string_view rest;
+    if ( position < buffer.size() ) rest = std::string_view(buffer.data() + position, buffer.size() - position);
+    size_t at = find_delimiter(rest, delim);
+    bool found = at != std::string_view::npos;
+    view = rest.substr(0, found ? at + delim.size() : rest.size());
+    position += view.size();
+    return found;
 }
 
 } // namespace JSONJay
\ No newline at end of file
@@ -1,9 +1,17 @@
 #include "BufferStreamWritinator.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 namespace JSONJay {
 
 BufferStreamWritinator::BufferStreamWritinator() : position(0) {}
 
+BufferStreamWritinator::BufferStreamWritinator(uint64_t capacity) : position(0) {
+    buffer.reserve(capacity);
+}
+
 BufferStreamWritinator::~BufferStreamWritinator() {}
 
 
@@ -19,12 +27,21 @@ void BufferStreamWritinator::setStreamPosition(uint64_t position) {
     this->position = position;
 }
 
-bool BufferStreamWritinator::writeData(const char* data, uint64_t size) {
-    for (uint64_t i = 0; i < size; i++) {
-        buffer.push_back(data[i]);
+bool BufferStreamWritinator::overwriteData(const char* data, uint64_t size) {
+    uint64_t end = position + size;
+    if (end > buffer.capacity()) {
+        buffer.reserve(std::max<uint64_t>(end, buffer.capacity() * 2));
     }
+    if (position > buffer.size()) {
+        buffer.resize(position);
+    }
+
+    // overwrite what is there, append the rest
+    uint64_t overlap = std::min<uint64_t>(size, buffer.size() - position);
+    if (overlap != 0) std::memcpy(buffer.data() + position, data, overlap);
+    buffer.insert(buffer.end(), data + overlap, data + size);
 
-    position += size;
+    position = end;
     return true;
 }
 
@@ -32,4 +49,17 @@ const std::vector<char>& BufferStreamWritinator::getBuffer() const {
     return buffer;
 }
 
+void BufferStreamWritinator::reserve(uint64_t capacity) {
+    buffer.reserve(capacity);
+}
+
+uint64_t BufferStreamWritinator::capacity() const {
+    return buffer.capacity();
+}
+
+std::vector<char> BufferStreamWritinator::release() {
+    position = 0;
+    return std::exchange(buffer, std::vector<char>());
+}
+
 } // namespace JSONJay
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "DelimiterSearch.hpp"
+#include "Simd.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace JSONJay {
+
+namespace {
+
+size_t find_scalar(std::string_view data, std::string_view delim) {
+    return data.find(delim);
+}
+
+/**
+ * @brief check the candidates of one vector
+ *
+ * @param data the bytes, the candidates start at data[0]
+ * @param mask a bit for each candidate whose first and last byte match
+ * @param delim the delimiter, at least two bytes
+ * @return size_t the offset of the first match, npos if there is none
+ */
+size_t check_candidates(const char* data, uint32_t mask, std::string_view delim) {
+    while ( mask != 0 ) {
+        size_t at = std::countr_zero(mask);
+        if ( std::memcmp(data + at + 1, delim.data() + 1, delim.size() - 2) == 0 ) return at;
+        mask &= mask - 1;
+    }
+    return std::string_view::npos;
+}
+
+/**
+ * @brief search the rest that is too short for a vector
+ */
+size_t find_tail(std::string_view data, size_t from, std::string_view delim) {
+    size_t at = find_scalar(data.substr(from), delim);
+    return at == std::string_view::npos ? at : from + at;
+}
+
+#if JSONJAY_SIMD_X86
+
+size_t find_sse2(std::string_view data, std::string_view delim) {
+    const __m128i first = _mm_set1_epi8(delim.front());
+    const __m128i last = _mm_set1_epi8(delim.back());
+    const size_t lastOffset = delim.size() - 1;
+    size_t i = 0;
+    for ( ; i + lastOffset + 16 <= data.size(); i += 16 ) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + i + lastOffset));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+        size_t at = check_candidates(data.data() + i, mask, delim);
+        if ( at != std::string_view::npos ) return i + at;
+    }
+    return find_tail(data, i, delim);
+}
+
+#endif
+
+#if JSONJAY_HAS_AVX2
+
+JSONJAY_TARGET_AVX2 size_t find_avx2(std::string_view data, std::string_view delim) {
+    const __m256i first = _mm256_set1_epi8(delim.front());
+    const __m256i last = _mm256_set1_epi8(delim.back());
+    const size_t lastOffset = delim.size() - 1;
+    size_t i = 0;
+    for ( ; i + lastOffset + 32 <= data.size(); i += 32 ) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data.data() + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data.data() + i + lastOffset));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+        size_t at = check_candidates(data.data() + i, mask, delim);
+        if ( at != std::string_view::npos ) return i + at;
+    }
+    return find_tail(data, i, delim);
+}
+
+#endif
+
+} // namespace
+
+size_t find_delimiter(std::string_view data, std::string_view delim, Isa isa) noexcept {
+    if ( delim.size() <= 1 ) {
+        if ( delim.empty() ) return 0;
+        const void* hit = data.empty() ? nullptr : std::memchr(data.data(), delim.front(), data.size());
+        return hit ? static_cast<const char*>(hit) - data.data() : std::string_view::npos;
+    }
+
+    switch ( isa ) {
+#if JSONJAY_HAS_AVX2
+        case Isa::AVX2: return find_avx2(data, delim);
+#endif
+#if JSONJAY_SIMD_X86
+        case Isa::SSE2: return find_sse2(data, delim);
+#endif
+        default: return find_scalar(data, delim);
+    }
+}
+
+} // namespace JSONJay
@@ -0,0 +1,35 @@
+/**
+ * @file DelimiterSearch.hpp
+ * @author TL044CN
+ * @brief delimiter search of the readinators that hold their data in memory
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Isa.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace JSONJay {
+
+/**
+ * @brief find the first occurrence of a delimiter
+ * @details Single bytes are searched with memchr. Longer delimiters are
+ *          searched for their first and last byte a vector at a time, only
+ *          the positions where both match are compared in full.
+ *
+ * @param data the bytes to search
+ * @param delim the delimiter
+ * @param isa the instruction set to use
+ * @return size_t the offset of the delimiter, std::string_view::npos if
+ *         there is none
+ */
+size_t find_delimiter(std::string_view data, std::string_view delim, Isa isa = detected_isa()) noexcept;
+
+} // namespace JSONJay
@@ -0,0 +1,97 @@
+#include "Document.hpp"
+
+namespace JSONJay {
+
+Document::Document(BaseDataType rootType, size_t initialBlockSize, std::pmr::memory_resource* upstream)
+    : mArena(std::make_unique<std::pmr::monotonic_buffer_resource>(initialBlockSize, upstream)),
+      mRootType(rootType) {
+    allocator_type allocator(mArena.get());
+    if ( rootType == BaseDataType::OBJECT ) mObject = allocator.new_object<Object>();
+    else if ( rootType == BaseDataType::LIST ) mList = allocator.new_object<List>();
+    else throw InvalidTypeException("Document root must be an Object or a List");
+}
+
+Document::Document(Document&& other) noexcept
+    : mArena(std::move(other.mArena)),
+      mAdopted(std::move(other.mAdopted)),
+      mRootType(other.mRootType),
+      mObject(std::exchange(other.mObject, nullptr)),
+      mList(std::exchange(other.mList, nullptr)) {}
+
+Document& Document::operator=(Document&& other) noexcept {
+    if ( this == &other ) return *this;
+    release();
+    mArena = std::move(other.mArena);
+    mAdopted = std::move(other.mAdopted);
+    mRootType = other.mRootType;
+    mObject = std::exchange(other.mObject, nullptr);
+    mList = std::exchange(other.mList, nullptr);
+    return *this;
+}
+
+Document::~Document() {
+    release();
+}
+
+
+void Document::release() {
+    // Every node, container and string of the tree lives in the arena and
+    // nothing in it holds other resources, so the tree does not have to be
+    // walked: dropping the arena releases all of it at once.
+    mObject = nullptr;
+    mList = nullptr;
+    mArena.reset();
+    mAdopted.clear();
+}
+
+BaseDataType Document::root_type() const {
+    return mRootType;
+}
+
+Object& Document::object() {
+    if ( mObject == nullptr ) throw InvalidTypeException("Document root is not an Object");
+    return *mObject;
+}
+
+List& Document::list() {
+    if ( mList == nullptr ) throw InvalidTypeException("Document root is not a List");
+    return *mList;
+}
+
+void Document::append(Document&& other) {
+    if ( this == &other ) throw InvalidTypeException("Document cannot be appended to itself");
+    List& target = list();
+    target.absorb(other.list());
+
+    mAdopted.push_back(std::move(other.mArena));
+    for ( auto& arena : other.mAdopted ) mAdopted.push_back(std::move(arena));
+    other.mAdopted.clear();
+    other.mObject = nullptr;
+    other.mList = nullptr;
+}
+
+const Object& Document::object() const {
+    return const_cast<Document*>(this)->object();
+}
+
+const List& Document::list() const {
+    return const_cast<Document*>(this)->list();
+}
+
+Object Document::make_object() {
+    return Object(get_allocator());
+}
+
+List Document::make_list() {
+    return List(get_allocator());
+}
+
+Document::allocator_type Document::get_allocator() const {
+    return allocator_type(mArena.get());
+}
+
+std::pmr::memory_resource* Document::resource() const {
+    return mArena.get();
+}
+
+} // namespace JSONJay
@@ -26,7 +26,15 @@ void FileStreamReadinator::setStreamPosition(uint64_t position) {
 
 bool FileStreamReadinator::readData(char* data, uint64_t size) {
     mFile.read(data, size);
-    return true;
+    return static_cast<bool>(mFile);
+}
+
+uint64_t FileStreamReadinator::readSome(char* data, uint64_t size) {
+    mFile.read(data, size);
+    uint64_t count = static_cast<uint64_t>(mFile.gcount());
+    // running into the end of the file is expected here
+    if ( count < size && mFile.eof() ) mFile.clear(std::ios::eofbit);
+    return count;
 }
 
 } // namespace JSONJay
@@ -0,0 +1,18 @@
+#include "Isa.hpp"
+#include "Simd.hpp"
+
+namespace JSONJay {
+
+Isa detected_isa() noexcept {
+#if JSONJAY_HAS_AVX2
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if ( avx2 ) return Isa::AVX2;
+#endif
+#if JSONJAY_SIMD_X86
+    return Isa::SSE2;
+#else
+    return Isa::SCALAR;
+#endif
+}
+
+} // namespace JSONJay
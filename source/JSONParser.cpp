@@ -0,0 +1,166 @@
+#include "JSONParser.hpp"
+#include "Exceptions.hpp"
+#include "JSONText.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace JSONJay {
+
+Isa JSONParser::set_isa(Isa isa) noexcept {
+    Isa previous = mIsa;
+    mIsa = std::min(isa, detected_isa());
+    return previous;
+}
+
+size_t JSONParser::next_structural() {
+    if ( mNext >= mPositions.size() ) throw InvalidFormatException("Unexpected end of JSON text");
+    return mPositions[mNext++];
+}
+
+std::string_view JSONParser::read_string(size_t open, std::string& buffer) {
+    // stage one only indexes quotes in pairs, the next one closes the string
+    size_t close = next_structural();
+    std::string_view content = mText.substr(open + 1, close - open - 1);
+    if ( std::memchr(content.data(), '\\', content.size()) == nullptr ) return content;
+
+    unescape_json(content, buffer);
+    return buffer;
+}
+
+template<typename Insert>
+void JSONParser::parse_scalar(size_t position, Insert&& insert) {
+    size_t end = position;
+    while ( end < mText.size() && !is_json_delimiter(mText[end]) ) end++;
+
+    JSONScalar scalar = parse_json_scalar(mText.substr(position, end - position));
+    switch ( scalar.type ) {
+        case BaseDataType::INT:    insert(std::type_identity<int>(), scalar.i); break;
+        case BaseDataType::DOUBLE: insert(std::type_identity<double>(), scalar.d); break;
+        case BaseDataType::BOOL:   insert(std::type_identity<bool>(), scalar.b); break;
+        default:                   insert(std::type_identity<std::monostate>()); break;
+    }
+}
+
+template<typename Insert>
+void JSONParser::parse_value(size_t depth, Insert&& insert) {
+    size_t position = next_structural();
+    switch ( mText[position] ) {
+        case '{':
+            parse_object(insert(std::type_identity<Object>()), depth + 1);
+            break;
+        case '[':
+            parse_list(insert(std::type_identity<List>()), depth + 1);
+            break;
+        case '"':
+            insert(std::type_identity<std::string>(), read_string(position, mStringBuffer));
+            break;
+        case '}':
+        case ']':
+        case ':':
+        case ',':
+            throw InvalidFormatException("Expected a value");
+        default:
+            parse_scalar(position, insert);
+            break;
+    }
+}
+
+void JSONParser::parse_object(Object& object, size_t depth) {
+    if ( depth > kMaxDepth ) throw InvalidFormatException("JSON nesting too deep");
+
+    size_t position = next_structural();
+    if ( mText[position] == '}' ) return;
+
+    while ( true ) {
+        if ( mText[position] != '"' ) throw InvalidFormatException("Expected a key");
+        std::string_view key = read_string(position, mKeyBuffer);
+        if ( mText[next_structural()] != ':' ) throw InvalidFormatException("Expected ':'");
+
+        parse_value(depth, [&](auto type, auto&&... args) -> decltype(auto) {
+            using T = typename decltype(type)::type;
+            return object.emplace_member<T>(key, std::forward<decltype(args)>(args)...);
+        });
+
+        position = next_structural();
+        if ( mText[position] == '}' ) return;
+        if ( mText[position] != ',' ) throw InvalidFormatException("Expected ',' or '}'");
+        position = next_structural();
+    }
+}
+
+void JSONParser::parse_list(List& list, size_t depth) {
+    if ( depth > kMaxDepth ) throw InvalidFormatException("JSON nesting too deep");
+
+    if ( mNext < mPositions.size() && mText[mPositions[mNext]] == ']' ) {
+        mNext++;
+        return;
+    }
+
+    while ( true ) {
+        parse_value(depth, [&](auto type, auto&&... args) -> decltype(auto) {
+            using T = typename decltype(type)::type;
+            return list.emplace_back<T>(std::forward<decltype(args)>(args)...);
+        });
+
+        size_t position = next_structural();
+        if ( mText[position] == ']' ) return;
+        if ( mText[position] != ',' ) throw InvalidFormatException("Expected ',' or ']'");
+    }
+}
+
+Document JSONParser::parse(std::string_view text, std::pmr::memory_resource* upstream) {
+    mIndex.build(text, mIsa);
+    return parse_indexed(text, mIndex.positions(), upstream);
+}
+
+Document JSONParser::parse_indexed(std::string_view text, std::span<const uint32_t> positions,
+    std::pmr::memory_resource* upstream) {
+    mText = text;
+    mPositions = positions;
+    mNext = 0;
+
+    size_t position = next_structural();
+    BaseDataType rootType;
+    if ( text[position] == '{' ) rootType = BaseDataType::OBJECT;
+    else if ( text[position] == '[' ) rootType = BaseDataType::LIST;
+    else throw InvalidFormatException("JSON root must be an Object or a List");
+
+    // the tree is rarely larger than the text, so one block mostly suffices
+    Document document(rootType, std::max(Document::kDefaultBlockSize, text.size()), upstream);
+    if ( rootType == BaseDataType::OBJECT ) parse_object(document.object(), 1);
+    else parse_list(document.list(), 1);
+
+    if ( mNext != mPositions.size() ) throw InvalidFormatException("Unexpected characters after the JSON value");
+    return document;
+}
+
+void JSONParser::parse_elements(std::string_view text, std::span<const uint32_t> positions, List& list) {
+    mText = text;
+    mPositions = positions;
+    mNext = 0;
+
+    while ( true ) {
+        parse_value(1, [&](auto type, auto&&... args) -> decltype(auto) {
+            using T = typename decltype(type)::type;
+            return list.emplace_back<T>(std::forward<decltype(args)>(args)...);
+        });
+        if ( mNext == mPositions.size() ) return;
+        if ( mText[next_structural()] != ',' ) throw InvalidFormatException("Expected ',' or ']'");
+    }
+}
+
+Document JSONParser::parse(StreamReadinator& reader, std::pmr::memory_resource* upstream) {
+    mInput.clear();
+    while ( true ) {
+        size_t size = mInput.size();
+        mInput.resize(size + kReadChunkSize);
+        uint64_t count = reader.readSome(mInput.data() + size, kReadChunkSize);
+        mInput.resize(size + count);
+        if ( count == 0 ) break;
+    }
+    return parse(std::string_view(mInput), upstream);
+}
+
+} // namespace JSONJay
@@ -0,0 +1,216 @@
+#include "JSONText.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace JSONJay {
+
+namespace {
+
+constexpr bool is_digit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+int hex_value(char c) noexcept {
+    if ( c >= '0' && c <= '9' ) return c - '0';
+    if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+    if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief read the four hex digits of a \\u escape
+ * @throws InvalidFormatException if the digits are missing or invalid
+ */
+uint32_t read_hex4(std::string_view text, size_t position) {
+    if ( position + 4 > text.size() ) throw InvalidFormatException("Invalid unicode escape");
+    uint32_t value = 0;
+    for ( size_t i = 0; i < 4; i++ ) {
+        int digit = hex_value(text[position + i]);
+        if ( digit < 0 ) throw InvalidFormatException("Invalid unicode escape");
+        value = value << 4 | static_cast<uint32_t>(digit);
+    }
+    return value;
+}
+
+void append_utf8(std::string& out, uint32_t codePoint) {
+    if ( codePoint < 0x80 ) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if ( codePoint < 0x800 ) {
+        out.push_back(static_cast<char>(0xC0 | codePoint >> 6));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if ( codePoint < 0x10000 ) {
+        out.push_back(static_cast<char>(0xE0 | codePoint >> 12));
+        out.push_back(static_cast<char>(0x80 | (codePoint >> 6 & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | codePoint >> 18));
+        out.push_back(static_cast<char>(0x80 | (codePoint >> 12 & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint >> 6 & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+/**
+ * @brief check a number against the JSON grammar
+ * @throws InvalidFormatException if the number is malformed
+ *
+ * @param number the number
+ * @return true the number has neither fraction nor exponent
+ * @return false the number has a fraction or an exponent
+ */
+bool check_number(std::string_view number) {
+    const char* p = number.data();
+    const char* end = p + number.size();
+    bool integral = true;
+
+    if ( p != end && *p == '-' ) p++;
+    if ( p == end ) throw InvalidFormatException("Invalid number");
+    if ( *p == '0' ) p++;
+    else if ( is_digit(*p) ) while ( p != end && is_digit(*p) ) p++;
+    else throw InvalidFormatException("Invalid number");
+
+    if ( p != end && *p == '.' ) {
+        p++;
+        if ( p == end || !is_digit(*p) ) throw InvalidFormatException("Invalid number");
+        while ( p != end && is_digit(*p) ) p++;
+        integral = false;
+    }
+    if ( p != end && (*p == 'e' || *p == 'E') ) {
+        p++;
+        if ( p != end && (*p == '+' || *p == '-') ) p++;
+        if ( p == end || !is_digit(*p) ) throw InvalidFormatException("Invalid number");
+        while ( p != end && is_digit(*p) ) p++;
+        integral = false;
+    }
+    if ( p != end ) throw InvalidFormatException("Invalid number");
+    return integral;
+}
+
+// whether a valid number that does not fit into a double is too close to
+// zero rather than too large: its first nonzero digit lies behind the point
+bool is_underflow(std::string_view number) {
+    size_t exponentStart = number.find_first_of("eE");
+    std::string_view mantissa = number.substr(0, exponentStart);
+    if ( mantissa.front() == '-' ) mantissa.remove_prefix(1);
+
+    size_t point = mantissa.find('.');
+    int64_t order;
+    if ( mantissa.front() != '0' ) {
+        order = static_cast<int64_t>(std::min(point, mantissa.size()));
+    } else {
+        size_t first = mantissa.find_first_not_of('0', point + 1);
+        if ( point == std::string_view::npos || first == std::string_view::npos ) return false;
+        order = -static_cast<int64_t>(first - point - 1);
+    }
+
+    if ( exponentStart == std::string_view::npos ) return order < 0;
+    std::string_view exponent = number.substr(exponentStart + 1);
+    bool negative = exponent.front() == '-';
+    if ( negative || exponent.front() == '+' ) exponent.remove_prefix(1);
+    // saturate, only the sign of the sum matters
+    int64_t value = 0;
+    for ( char c : exponent ) value = std::min<int64_t>(value * 10 + (c - '0'), int64_t(1) << 40);
+    return order + (negative ? -value : value) < 0;
+}
+
+} // namespace
+
+
+void unescape_json(std::string_view content, std::string& out) {
+    out.clear();
+    size_t position = 0;
+    while ( position < content.size() ) {
+        const void* found = std::memchr(content.data() + position, '\\', content.size() - position);
+        size_t backslash = found == nullptr
+            ? content.size()
+            : static_cast<size_t>(static_cast<const char*>(found) - content.data());
+        out.append(content.data() + position, backslash - position);
+        if ( backslash == content.size() ) break;
+
+        if ( backslash + 1 == content.size() ) throw InvalidFormatException("Invalid escape sequence");
+        char escape = content[backslash + 1];
+        position = backslash + 2;
+        switch ( escape ) {
+            case '"':  out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '/':  out.push_back('/'); break;
+            case 'b':  out.push_back('\b'); break;
+            case 'f':  out.push_back('\f'); break;
+            case 'n':  out.push_back('\n'); break;
+            case 'r':  out.push_back('\r'); break;
+            case 't':  out.push_back('\t'); break;
+            case 'u': {
+                uint32_t codePoint = read_hex4(content, position);
+                position += 4;
+                if ( codePoint >= 0xDC00 && codePoint <= 0xDFFF )
+                    throw InvalidFormatException("Unpaired surrogate in unicode escape");
+                if ( codePoint >= 0xD800 && codePoint <= 0xDBFF ) {
+                    if ( content.substr(position, 2) != "\\u" )
+                        throw InvalidFormatException("Unpaired surrogate in unicode escape");
+                    uint32_t low = read_hex4(content, position + 2);
+                    if ( low < 0xDC00 || low > 0xDFFF )
+                        throw InvalidFormatException("Unpaired surrogate in unicode escape");
+                    position += 6;
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                append_utf8(out, codePoint);
+                break;
+            }
+            default:
+                throw InvalidFormatException("Invalid escape sequence");
+        }
+    }
+}
+
+JSONScalar parse_json_scalar(std::string_view atom) {
+    JSONScalar scalar{ BaseDataType::NONE, 0, 0.0, false };
+    if ( atom.empty() ) throw InvalidFormatException("Expected a value");
+
+    switch ( atom.front() ) {
+        case 't':
+            if ( atom != "true" ) throw InvalidFormatException("Invalid literal");
+            scalar.type = BaseDataType::BOOL;
+            scalar.b = true;
+            return scalar;
+        case 'f':
+            if ( atom != "false" ) throw InvalidFormatException("Invalid literal");
+            scalar.type = BaseDataType::BOOL;
+            return scalar;
+        case 'n':
+            if ( atom != "null" ) throw InvalidFormatException("Invalid literal");
+            return scalar;
+        default:
+            break;
+    }
+
+    // -0 keeps its sign as double
+    if ( check_number(atom) && atom != "-0" ) {
+        // sign and ten digits always fit into 64 bits
+        size_t digits = atom.size() - (atom.front() == '-');
+        if ( digits <= 10 ) {
+            int64_t value = 0;
+            for ( char c : atom.substr(atom.size() - digits) ) value = value * 10 + (c - '0');
+            if ( atom.front() == '-' ) value = -value;
+            if ( value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max() ) {
+                scalar.type = BaseDataType::INT;
+                scalar.i = static_cast<int>(value);
+                return scalar;
+            }
+        }
+    }
+
+    auto [last, error] = std::from_chars(atom.data(), atom.data() + atom.size(), scalar.d);
+    if ( error == std::errc::result_out_of_range && is_underflow(atom) )
+        scalar.d = atom.front() == '-' ? -0.0 : 0.0;
+    else if ( error != std::errc() || last != atom.data() + atom.size() )
+        throw InvalidFormatException("Number out of range");
+    scalar.type = BaseDataType::DOUBLE;
+    return scalar;
+}
+
+} // namespace JSONJay
@@ -0,0 +1,77 @@
+/**
+ * @file JSONText.hpp
+ * @author TL044CN
+ * @brief helpers for reading the tokens of JSON text
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace JSONJay {
+
+/**
+ * @brief characters that end a number or literal
+ */
+constexpr bool is_json_delimiter(char c) noexcept {
+    switch ( c ) {
+        case ' ': case '\t': case '\n': case '\r':
+        case '{': case '}': case '[': case ']':
+        case ':': case ',': case '"':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief whitespace between the tokens of JSON text
+ */
+constexpr bool is_json_whitespace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * @brief the value of a number or literal
+ * @details type is INT, DOUBLE, BOOL or NONE for null.
+ */
+struct JSONScalar {
+    BaseDataType type;
+    int          i;
+    double       d;
+    bool         b;
+};
+
+/**
+ * @brief read a number or literal
+ * @details Integers that fit into an int are read as INT, all other numbers
+ *          as DOUBLE, also -0 to keep its sign. Numbers too close to zero
+ *          for a double become zero.
+ * @throws InvalidFormatException if the text is no valid number or literal
+ *         or too large for a double
+ *
+ * @param atom the text of the number or literal
+ * @return JSONScalar the value
+ */
+JSONScalar parse_json_scalar(std::string_view atom);
+
+/**
+ * @brief unescape the content of a string
+ * @details The content must not end in the middle of an escape, which
+ *          holds for everything between two unescaped quotes.
+ * @throws InvalidFormatException on invalid escapes
+ *
+ * @param content the string between its quotes
+ * @param out the buffer to write to
+ */
+void unescape_json(std::string_view content, std::string& out);
+
+} // namespace JSONJay
@@ -0,0 +1,287 @@
+#include "JSONWriter.hpp"
+#include "Exceptions.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace JSONJay {
+
+namespace {
+
+constexpr bool needs_escape(unsigned char c) noexcept {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+size_t find_escape_scalar(const char* data, size_t size) {
+    size_t i = 0;
+    while ( i < size && !needs_escape(static_cast<unsigned char>(data[i])) ) i++;
+    return i;
+}
+
+#if JSONJAY_SIMD_X86
+
+size_t find_escape_sse2(const char* data, size_t size) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lastControl = _mm_set1_epi8(0x1F);
+    size_t i = 0;
+    for ( ; i + 16 <= size; i += 16 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(v, lastControl), lastControl));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if ( mask != 0 ) return i + static_cast<size_t>(std::countr_zero(mask));
+    }
+    return i + find_escape_scalar(data + i, size - i);
+}
+
+#endif
+
+#if JSONJAY_HAS_AVX2
+
+JSONJAY_TARGET_AVX2 size_t find_escape_avx2(const char* data, size_t size) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i lastControl = _mm256_set1_epi8(0x1F);
+    size_t i = 0;
+    for ( ; i + 32 <= size; i += 32 ) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(v, lastControl), lastControl));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if ( mask != 0 ) return i + static_cast<size_t>(std::countr_zero(mask));
+    }
+    return i + find_escape_scalar(data + i, size - i);
+}
+
+#endif
+
+using find_escape_t = size_t (*)(const char*, size_t);
+
+find_escape_t find_escape_for(Isa isa) noexcept {
+    switch ( isa ) {
+#if JSONJAY_HAS_AVX2
+        case Isa::AVX2: return find_escape_avx2;
+#endif
+#if JSONJAY_SIMD_X86
+        case Isa::SSE2: return find_escape_sse2;
+#endif
+        default: return find_escape_scalar;
+    }
+}
+
+/**
+ * @brief the longest shortest round-trip form of a double
+ */
+constexpr size_t kMaxDoubleChars = 32;
+
+} // namespace
+
+
+JSONWriter::JSONWriter(JSONStyle style, size_t indent)
+    : mStyle(style), mIndent(indent), mFindEscape(find_escape_for(mIsa)) {}
+
+Isa JSONWriter::set_isa(Isa isa) noexcept {
+    Isa previous = mIsa;
+    mIsa = std::min(isa, detected_isa());
+    mFindEscape = find_escape_for(mIsa);
+    return previous;
+}
+
+void JSONWriter::flush() {
+    if ( mUsed != 0 && !mStream->writeData(mBuffer.data(), mUsed) ) mGood = false;
+    mUsed = 0;
+}
+
+void JSONWriter::append(const char* data, size_t size) {
+    if ( mBuffer.size() - mUsed >= size ) {
+        std::memcpy(mBuffer.data() + mUsed, data, size);
+        mUsed += size;
+        return;
+    }
+
+    flush();
+    if ( size >= mBuffer.size() ) {
+        // too large to be worth copying
+        if ( !mStream->writeData(data, size) ) mGood = false;
+        return;
+    }
+    std::memcpy(mBuffer.data(), data, size);
+    mUsed = size;
+}
+
+void JSONWriter::newline() {
+    size_t indent = mDepth * mIndent;
+    put('\n');
+    while ( indent > 0 ) {
+        size_t count = std::min(indent, mBuffer.size());
+        char* out = room(count);
+        std::memset(out, ' ', count);
+        mUsed += count;
+        indent -= count;
+    }
+}
+
+void JSONWriter::separate(bool first) {
+    if ( !first ) put(',');
+    if ( mStyle == JSONStyle::PRETTY ) newline();
+}
+
+void JSONWriter::close(char close, bool empty) {
+    mDepth--;
+    if ( mStyle == JSONStyle::PRETTY && !empty ) newline();
+    put(close);
+}
+
+void JSONWriter::write_string(std::string_view string) {
+    static constexpr char kHex[] = "0123456789abcdef";
+
+    put('"');
+    const char* data = string.data();
+    size_t size = string.size();
+    while ( true ) {
+        size_t run = mFindEscape(data, size);
+        append(data, run);
+        if ( run == size ) break;
+
+        unsigned char c = static_cast<unsigned char>(data[run]);
+        char* out = room(6);
+        out[0] = '\\';
+        size_t length = 2;
+        switch ( c ) {
+            case '"':  out[1] = '"'; break;
+            case '\\': out[1] = '\\'; break;
+            case '\b': out[1] = 'b'; break;
+            case '\f': out[1] = 'f'; break;
+            case '\n': out[1] = 'n'; break;
+            case '\r': out[1] = 'r'; break;
+            case '\t': out[1] = 't'; break;
+            default:
+                std::memcpy(out + 1, "u00", 3);
+                out[4] = kHex[c >> 4];
+                out[5] = kHex[c & 0xF];
+                length = 6;
+                break;
+        }
+        mUsed += length;
+        data += run + 1;
+        size -= run + 1;
+    }
+    put('"');
+}
+
+void JSONWriter::write_int(int value) {
+    // libstdc++ formats integers two digits at a time from a lookup table
+    char* out = room(11);
+    mUsed = static_cast<size_t>(std::to_chars(out, out + 11, value).ptr - mBuffer.data());
+}
+
+void JSONWriter::write_double(double value) {
+    if ( !std::isfinite(value) ) throw InvalidValueException("JSON cannot represent NaN or infinity");
+
+    char* out = room(kMaxDoubleChars);
+    char* end = std::to_chars(out, out + kMaxDoubleChars, value).ptr;
+    if ( std::find_if(out, end, [](char c) { return c == '.' || c == 'e'; }) == end ) {
+        std::memcpy(end, ".0", 2);
+        end += 2;
+    }
+    mUsed = static_cast<size_t>(end - mBuffer.data());
+}
+
+void JSONWriter::write_bool(bool value) {
+    if ( value ) append("true", 4);
+    else append("false", 5);
+}
+
+void JSONWriter::write_value(const Value& value) {
+    switch ( value.type() ) {
+        case BaseDataType::STRING: write_string(value.as_string()); break;
+        case BaseDataType::INT:    write_int(value.get<int>()); break;
+        case BaseDataType::DOUBLE: write_double(value.get<double>()); break;
+        case BaseDataType::BOOL:   write_bool(value.get<bool>()); break;
+        case BaseDataType::OBJECT: write_object(*value.get<Object*>()); break;
+        case BaseDataType::LIST:   write_list(*value.get<List*>()); break;
+        default:                   append("null", 4); break;
+    }
+}
+
+void JSONWriter::write_object(const Object& object) {
+    put('{');
+    mDepth++;
+    bool first = true;
+    for ( const MemberStore::Member& member : object.members() ) {
+        separate(first);
+        first = false;
+        write_string(member.key());
+        put(':');
+        if ( mStyle == JSONStyle::PRETTY ) put(' ');
+        write_value(member.value);
+    }
+    close('}', first);
+}
+
+void JSONWriter::write_list(const List& list) {
+    put('[');
+    mDepth++;
+    bool first = true;
+    auto each = [&](auto values, auto write) {
+        for ( auto value : values ) {
+            separate(first);
+            first = false;
+            (this->*write)(value);
+        }
+    };
+    switch ( list.element_type() ) {
+        case BaseDataType::INT:    each(list.ints(), &JSONWriter::write_int); break;
+        case BaseDataType::DOUBLE: each(list.doubles(), &JSONWriter::write_double); break;
+        case BaseDataType::BOOL:   each(list.bools(), &JSONWriter::write_bool); break;
+        default:
+            for ( const Value& value : list.values() ) {
+                separate(first);
+                first = false;
+                write_value(value);
+            }
+            break;
+    }
+    close(']', first);
+}
+
+template<typename Write>
+bool JSONWriter::run(StreamWritinator& stream, Write&& write) {
+    mStream = &stream;
+    mGood = true;
+    mUsed = 0;
+    mDepth = 0;
+    mBuffer.resize(kBufferSize);
+    try {
+        write();
+        flush();
+    } catch ( ... ) {
+        mUsed = 0;
+        mStream = nullptr;
+        throw;
+    }
+    mStream = nullptr;
+    return mGood && stream.isStreamGood();
+}
+
+bool JSONWriter::write(StreamWritinator& stream, const Object& object) {
+    return run(stream, [&] { write_object(object); });
+}
+
+bool JSONWriter::write(StreamWritinator& stream, const List& list) {
+    return run(stream, [&] { write_list(list); });
+}
+
+bool JSONWriter::write(StreamWritinator& stream, const Document& document) {
+    if ( document.root_type() == BaseDataType::OBJECT ) return write(stream, document.object());
+    return write(stream, document.list());
+}
+
+} // namespace JSONJay
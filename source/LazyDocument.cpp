@@ -0,0 +1,163 @@
+#include "LazyDocument.hpp"
+#include "Exceptions.hpp"
+#include "JSONText.hpp"
+
+#include <cstring>
+
+namespace JSONJay {
+
+LazyDocument::LazyDocument(std::string_view text, Isa isa) : mText(text) {
+    mIndex.build(text, isa);
+}
+
+size_t LazyDocument::position(size_t index) const {
+    if ( index >= mIndex.size() ) throw InvalidFormatException("Unexpected end of JSON text");
+    return mIndex[index];
+}
+
+size_t LazyDocument::skip(size_t index) const {
+    char c = structural(index);
+    if ( c == '"' ) return index + 2;
+    if ( c != '{' && c != '[' ) return index + 1;
+
+    // quotes are indexed in pairs, so brackets inside strings never show up
+    size_t depth = 1;
+    index++;
+    while ( depth != 0 ) {
+        c = structural(index++);
+        if ( c == '{' || c == '[' ) depth++;
+        else if ( c == '}' || c == ']' ) depth--;
+    }
+    return index;
+}
+
+std::string_view LazyDocument::string_at(size_t index, bool keep) const {
+    size_t open = position(index);
+    size_t close = position(index + 1);
+    std::string_view content = mText.substr(open + 1, close - open - 1);
+    if ( std::memchr(content.data(), '\\', content.size()) == nullptr ) return content;
+
+    unescape_json(content, mScratch);
+    if ( !keep ) return mScratch;
+    char* data = static_cast<char*>(mStrings.allocate(mScratch.size(), alignof(char)));
+    std::memcpy(data, mScratch.data(), mScratch.size());
+    return std::string_view(data, mScratch.size());
+}
+
+LazyValue LazyDocument::root() const {
+    position(0);
+    return LazyValue(this, 0);
+}
+
+
+std::string_view LazyValue::atom() const {
+    std::string_view text = mDocument->mText;
+    size_t begin = mDocument->position(mIndex);
+    if ( text[begin] == '{' || text[begin] == '[' || text[begin] == '"' )
+        throw InvalidTypeException("Value is not a number or literal");
+    size_t end = begin;
+    while ( end < text.size() && !is_json_delimiter(text[end]) ) end++;
+    return text.substr(begin, end - begin);
+}
+
+size_t LazyValue::find_member(std::string_view key) const {
+    if ( mDocument->structural(mIndex) != '{' ) throw InvalidTypeException("Value is not an Object");
+
+    size_t index = mIndex + 1;
+    if ( mDocument->structural(index) == '}' ) return 0;
+    while ( true ) {
+        if ( mDocument->structural(index) != '"' ) throw InvalidFormatException("Expected a key");
+        bool found = mDocument->string_at(index, false) == key;
+        if ( mDocument->structural(index + 2) != ':' ) throw InvalidFormatException("Expected ':'");
+        if ( found ) return index + 3;
+
+        index = mDocument->skip(index + 3);
+        char c = mDocument->structural(index);
+        if ( c == '}' ) return 0;
+        if ( c != ',' ) throw InvalidFormatException("Expected ',' or '}'");
+        index++;
+    }
+}
+
+BaseDataType LazyValue::type() const {
+    switch ( mDocument->structural(mIndex) ) {
+        case '{': return BaseDataType::OBJECT;
+        case '[': return BaseDataType::LIST;
+        case '"': return BaseDataType::STRING;
+        default:  return parse_json_scalar(atom()).type;
+    }
+}
+
+size_t LazyValue::size() const {
+    char open = mDocument->structural(mIndex);
+    if ( open != '{' && open != '[' ) throw InvalidTypeException("Value is not an Object or a List");
+    char close = open == '{' ? '}' : ']';
+
+    size_t index = mIndex + 1;
+    if ( mDocument->structural(index) == close ) return 0;
+    size_t count = 0;
+    while ( true ) {
+        // members are skipped as key, colon and value
+        if ( open == '{' ) index += 3;
+        index = mDocument->skip(index);
+        count++;
+        char c = mDocument->structural(index);
+        if ( c == close ) return count;
+        if ( c != ',' ) throw InvalidFormatException("Expected ',' or a closing bracket");
+        index++;
+    }
+}
+
+bool LazyValue::contains(std::string_view key) const {
+    return find_member(key) != 0;
+}
+
+LazyValue LazyValue::operator[](std::string_view key) const {
+    size_t index = find_member(key);
+    if ( index == 0 ) throw InvalidKeyException("Key does not exist");
+    return LazyValue(mDocument, index);
+}
+
+LazyValue LazyValue::operator[](size_t index) const {
+    if ( mDocument->structural(mIndex) != '[' ) throw InvalidTypeException("Value is not a List");
+
+    size_t current = mIndex + 1;
+    if ( mDocument->structural(current) == ']' ) throw InvalidIndexException("Index out of bounds");
+    for ( size_t i = 0; i < index; i++ ) {
+        current = mDocument->skip(current);
+        char c = mDocument->structural(current);
+        if ( c == ']' ) throw InvalidIndexException("Index out of bounds");
+        if ( c != ',' ) throw InvalidFormatException("Expected ',' or ']'");
+        current++;
+    }
+    return LazyValue(mDocument, current);
+}
+
+std::string_view LazyValue::get_string() const {
+    if ( mDocument->structural(mIndex) != '"' ) throw InvalidTypeException("Value is not a string");
+    return mDocument->string_at(mIndex, true);
+}
+
+int LazyValue::get_int() const {
+    JSONScalar scalar = parse_json_scalar(atom());
+    if ( scalar.type != BaseDataType::INT ) throw InvalidTypeException("Value is not an integer");
+    return scalar.i;
+}
+
+double LazyValue::get_double() const {
+    JSONScalar scalar = parse_json_scalar(atom());
+    if ( scalar.type != BaseDataType::DOUBLE ) throw InvalidTypeException("Value is not a double");
+    return scalar.d;
+}
+
+bool LazyValue::get_bool() const {
+    JSONScalar scalar = parse_json_scalar(atom());
+    if ( scalar.type != BaseDataType::BOOL ) throw InvalidTypeException("Value is not a boolean");
+    return scalar.b;
+}
+
+bool LazyValue::is_null() const {
+    return mDocument->structural(mIndex) == 'n' && atom() == "null";
+}
+
+} // namespace JSONJay
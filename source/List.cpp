@@ -1,67 +1,277 @@
 #include "List.hpp"
 #include "Object.hpp"
+#include "Numeric.hpp"
+#include "BinaryReader.hpp"
+#include "BinaryWriter.hpp"
 
 namespace JSONJay {
 
-List::~List() {
-    for ( auto& element : mData ) {
-        if ( std::holds_alternative<Object*>(element) ) delete std::get<Object*>(element);
-        if ( std::holds_alternative<List*>(element) ) delete std::get<List*>(element);
+List::List(const allocator_type& allocator) : mData(allocator), mScalars(allocator) {}
+
+List::List(List&& other) noexcept
+    : mData(std::move(other.mData)),
+      mScalars(std::move(other.mScalars)),
+      mElementType(std::exchange(other.mElementType, BaseDataType::NONE)),
+      mMixed(std::exchange(other.mMixed, false)) {
+    other.mData.clear();
+}
+
+List::List(List&& other, const allocator_type& allocator)
+    : mData(allocator),
+      mScalars(std::move(other.mScalars), allocator),
+      mElementType(std::exchange(other.mElementType, BaseDataType::NONE)),
+      mMixed(std::exchange(other.mMixed, false)) {
+    if ( allocator == other.get_allocator() ) {
+        mData = std::move(other.mData);
+        other.mData.clear();
+        return;
     }
 
+    // different arena: every string and nested node has to move over as well
+    mData.reserve(other.mData.size());
+    for ( auto& element : other.mData )
+        mData.push_back(element.relocate(other.get_allocator(), get_allocator()));
+    other.mData.clear();
+}
+
+List::~List() {
+    for ( auto& element : mData ) element.destroy(get_allocator());
 }
 
 
 void List::check_index(size_t index) const {
-    if ( index >= mData.size() ) throw InvalidIndexException("Index out of bounds");
+    if ( index >= size() ) throw InvalidIndexException("Index out of bounds");
+}
+
+void List::to_values() {
+    if ( !typed() ) return;
+
+    size_t count = size();
+    mData.reserve(count);
+    for ( size_t i = 0; i < count; i++ ) {
+        switch ( mElementType ) {
+            case BaseDataType::INT:    mData.push_back(data_t(mScalars.data<int>()[i])); break;
+            case BaseDataType::DOUBLE: mData.push_back(data_t(mScalars.data<double>()[i])); break;
+            default:                   mData.push_back(data_t(mScalars.data<bool>()[i])); break;
+        }
+    }
+    mScalars.reset();
+}
+
+void List::note_value(BaseDataType type) {
+    if ( size() == 0 ) {
+        mElementType = type;
+        return;
+    }
+    if ( mMixed || type == mElementType ) return;
+    to_values();
+    mMixed = true;
+}
+
+void List::insert_value(size_t index, data_t element) {
+    try {
+        note_value(element.type());
+        mData.insert(mData.begin() + index, element);
+    } catch ( ... ) {
+        element.destroy(get_allocator());
+        throw;
+    }
+}
+
+void List::forget_type_if_empty() noexcept {
+    if ( size() != 0 ) return;
+    mScalars.clear();
+    mElementType = BaseDataType::NONE;
+    mMixed = false;
+}
+
+void List::absorb(List& other) {
+    if ( other.typed() ) {
+        size_t count = other.size();
+        for ( size_t i = 0; i < count; i++ ) {
+            switch ( other.mElementType ) {
+                case BaseDataType::INT:    insert_element(size(), other.mScalars.data<int>()[i]); break;
+                case BaseDataType::DOUBLE: insert_element(size(), other.mScalars.data<double>()[i]); break;
+                default:                   insert_element(size(), other.mScalars.data<bool>()[i]); break;
+            }
+        }
+    } else {
+        mData.reserve(mData.size() + other.mData.size());
+        for ( const data_t& element : other.mData ) {
+            switch ( element.type() ) {
+                case BaseDataType::INT:    insert_element(size(), element.get<int>()); break;
+                case BaseDataType::DOUBLE: insert_element(size(), element.get<double>()); break;
+                case BaseDataType::BOOL:   insert_element(size(), element.get<bool>()); break;
+                default:
+                    note_value(element.type());
+                    mData.push_back(element);
+                    break;
+            }
+        }
+    }
+    other.mData.clear();
+    other.mScalars.clear();
+    other.forget_type_if_empty();
 }
 
-List::Iterator::Iterator(std::vector<data_t>::iterator it) : mIt(it) {}
+List::Iterator::Iterator(List& list, size_t index) : mList(&list), mIndex(index) {}
 
 List::Iterator& List::Iterator::operator++() {
-    ++mIt;
+    ++mIndex;
     return *this;
 }
 
 bool List::Iterator::operator!=(const Iterator& other) const {
-    return mIt != other.mIt;
+    return mIndex != other.mIndex;
 }
 
 List::Iterator::value_type List::Iterator::operator*() {
-    return {*mIt, JSONJay::get_type(*mIt)};
+    return {Element(*mList, mIndex), mList->get_type(mIndex)};
 }
 
 
+List::allocator_type List::get_allocator() const {
+    return mData.get_allocator();
+}
+
 List::Iterator List::begin() {
-    return Iterator(mData.begin());
+    return Iterator(*this, 0);
 }
 
 List::Iterator List::end() {
-    return Iterator(mData.end());
+    return Iterator(*this, size());
 }
 
 size_t List::size() const {
-    return mData.size();
+    if ( !typed() ) return mData.size();
+    switch ( mElementType ) {
+        case BaseDataType::INT:    return mScalars.size<int>();
+        case BaseDataType::DOUBLE: return mScalars.size<double>();
+        default:                   return mScalars.size<bool>();
+    }
+}
+
+void List::reserve(size_t count) {
+    if ( !typed() ) {
+        mData.reserve(count);
+        return;
+    }
+    switch ( mElementType ) {
+        case BaseDataType::INT:    mScalars.reserve<int>(count); break;
+        case BaseDataType::DOUBLE: mScalars.reserve<double>(count); break;
+        default:                   mScalars.reserve<bool>(count); break;
+    }
+}
+
+List::ConstElement List::operator[](size_t index) const {
+    check_index(index);
+    return ConstElement(*this, index);
+}
+
+List::data_t List::value_at(size_t index) const {
+    check_index(index);
+    if ( !typed() ) return mData[index];
+    switch ( mElementType ) {
+        case BaseDataType::INT:    return data_t(mScalars.span<int>()[index]);
+        case BaseDataType::DOUBLE: return data_t(mScalars.span<double>()[index]);
+        default:                   return data_t(mScalars.span<bool>()[index]);
+    }
+}
+
+std::optional<List::Element> List::find(size_t index) {
+    if ( index >= size() ) return std::nullopt;
+    return Element(*this, index);
+}
+
+std::span<const int> List::ints() const {
+    if ( element_type() != BaseDataType::INT && !empty() ) throw InvalidTypeException("List does not only hold integers");
+    return mScalars.span<int>();
+}
+
+std::span<const double> List::doubles() const {
+    if ( element_type() != BaseDataType::DOUBLE && !empty() ) throw InvalidTypeException("List does not only hold doubles");
+    return mScalars.span<double>();
+}
+
+std::span<const bool> List::bools() const {
+    if ( element_type() != BaseDataType::BOOL && !empty() ) throw InvalidTypeException("List does not only hold booleans");
+    return mScalars.span<bool>();
+}
+
+std::span<const List::data_t> List::strings() const {
+    if ( element_type() != BaseDataType::STRING && !empty() ) throw InvalidTypeException("List does not only hold strings");
+    return std::span<const data_t>(mData.data(), mData.size());
+}
+
+std::span<int> List::ints() {
+    std::span<const int> values = std::as_const(*this).ints();
+    return std::span<int>(mScalars.data<int>(), values.size());
+}
+
+std::span<double> List::doubles() {
+    std::span<const double> values = std::as_const(*this).doubles();
+    return std::span<double>(mScalars.data<double>(), values.size());
+}
+
+std::span<bool> List::bools() {
+    std::span<const bool> values = std::as_const(*this).bools();
+    return std::span<bool>(mScalars.data<bool>(), values.size());
+}
+
+void List::convert_to_doubles() {
+    if ( empty() || element_type() == BaseDataType::DOUBLE ) return;
+
+    ScalarArray converted(get_allocator());
+    converted.resize<double>(size());
+    std::span<double> out(converted.data<double>(), size());
+
+    if ( element_type() == BaseDataType::INT ) {
+        numeric::convert(mScalars.span<int>(), out);
+    } else {
+        for ( size_t i = 0; i < mData.size(); i++ ) {
+            switch ( mData[i].type() ) {
+                case BaseDataType::INT:    out[i] = mData[i].get<int>(); break;
+                case BaseDataType::DOUBLE: out[i] = mData[i].get<double>(); break;
+                default: throw InvalidTypeException("List does not only hold numbers");
+            }
+        }
+        // numbers own nothing, the Values can just be dropped
+        mData.clear();
+    }
+
+    mScalars.swap(converted);
+    mElementType = BaseDataType::DOUBLE;
+    mMixed = false;
 }
 
 void List::clear() {
+    for ( auto& element : mData ) element.destroy(get_allocator());
     mData.clear();
+    mScalars.clear();
+    forget_type_if_empty();
 }
 
 bool List::empty() const {
-    return mData.empty();
+    return size() == 0;
 }
 
 void List::erase(size_t index) {
     check_index(index);
 
-    if(std::holds_alternative<Object*>(mData[index])) delete std::get<Object*>(mData[index]);
-    if(std::holds_alternative<List*>(mData[index])) delete std::get<List*>(mData[index]);
-
-    mData.erase(mData.begin() + index);
+    if ( typed() ) {
+        switch ( mElementType ) {
+            case BaseDataType::INT:    mScalars.erase<int>(index); break;
+            case BaseDataType::DOUBLE: mScalars.erase<double>(index); break;
+            default:                   mScalars.erase<bool>(index); break;
+        }
+    } else {
+        mData[index].destroy(get_allocator());
+        mData.erase(mData.begin() + index);
+    }
+    forget_type_if_empty();
 }
 
-std::string& List::get_string(size_t index) {
+std::string_view List::get_string(size_t index) {
     check_index(index);
     return at<std::string>(index);
 }
@@ -91,4 +301,12 @@ List& List::get_list(size_t index) {
     return *at<List*>(index);
 }
 
+void List::serialize(StreamWritinator* writer, const List& list) {
+    BinaryWriter().write(*writer, list);
+}
+
+void List::deserialize(StreamReadinator* reader, List& list) {
+    BinaryReader().read(*reader, list);
+}
+
 } // namespace JSONJay
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "MappedDocument.hpp"
+#include "MappedFormat.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace JSONJay {
+
+template<typename T>
+const T* MappedDocument::at(uint64_t offset, uint64_t count) const {
+    if ( offset > mImage.size() || count > (mImage.size() - offset) / sizeof(T) )
+        throw InvalidFormatException("Offset outside of the mapped document");
+    if ( offset % alignof(T) != 0 ) throw InvalidFormatException("Misaligned node in the mapped document");
+    return reinterpret_cast<const T*>(mImage.data() + offset);
+}
+
+MappedDocument::MappedDocument(std::span<const char> image) : mImage(image) {
+    if ( reinterpret_cast<uintptr_t>(image.data()) % kMappedAlignment != 0 )
+        throw InvalidFormatException("Mapped document must be aligned to 8 bytes");
+
+    const MappedHeader& header = *at<MappedHeader>(0);
+    if ( std::memcmp(header.magic, kMappedMagic, sizeof(kMappedMagic)) != 0 )
+        throw InvalidFormatException("Not a mapped document");
+    if ( header.byteOrder != kMappedByteOrder ) throw InvalidFormatException("Mapped document of other byte order");
+    if ( header.size < sizeof(MappedHeader) || header.size > image.size() )
+        throw InvalidFormatException("Mapped document is truncated");
+    mImage = image.first(header.size);
+
+    mRootType = static_cast<BaseDataType>(header.root.type);
+    if ( mRootType != BaseDataType::OBJECT && mRootType != BaseDataType::LIST )
+        throw InvalidFormatException("Mapped root must be an Object or a List");
+    mRoot = header.root.data;
+}
+
+
+std::string_view MappedValue::get_string() const {
+    if ( mType != BaseDataType::STRING ) throw InvalidTypeException("Value is not a string");
+    uint32_t size = *mDocument->at<uint32_t>(mData);
+    return std::string_view(mDocument->at<char>(uint64_t(mData) + sizeof(uint32_t), size), size);
+}
+
+int MappedValue::get_int() const {
+    if ( mType != BaseDataType::INT ) throw InvalidTypeException("Value is not an integer");
+    return std::bit_cast<int>(mData);
+}
+
+double MappedValue::get_double() const {
+    if ( mType != BaseDataType::DOUBLE ) throw InvalidTypeException("Value is not a double");
+    return *mDocument->at<double>(mData);
+}
+
+bool MappedValue::get_bool() const {
+    if ( mType != BaseDataType::BOOL ) throw InvalidTypeException("Value is not a boolean");
+    return mData != 0;
+}
+
+MappedObject MappedValue::as_object() const {
+    if ( mType != BaseDataType::OBJECT ) throw InvalidTypeException("Value is not an Object");
+    return MappedObject(mDocument, mData);
+}
+
+MappedList MappedValue::as_list() const {
+    if ( mType != BaseDataType::LIST ) throw InvalidTypeException("Value is not a List");
+    return MappedList(mDocument, mData);
+}
+
+MappedValue MappedValue::operator[](std::string_view key) const {
+    return as_object()[key];
+}
+
+MappedValue MappedValue::operator[](size_t index) const {
+    return as_list()[index];
+}
+
+
+MappedObject::MappedObject(const MappedDocument* document, uint32_t offset) : mDocument(document) {
+    const MappedBlock& block = *document->at<MappedBlock>(offset);
+    mOffset = offset + sizeof(MappedBlock);
+    mCount = block.count;
+    // check the whole key table once, entries are not checked again
+    document->at<MappedEntry>(mOffset, mCount);
+}
+
+std::string_view MappedObject::key_at(size_t index) const {
+    const MappedEntry& entry = mDocument->at<MappedEntry>(mOffset)[index];
+    return std::string_view(mDocument->at<char>(entry.keyOffset, entry.keySize), entry.keySize);
+}
+
+bool MappedObject::contains(std::string_view key) const {
+    size_t low = 0;
+    size_t high = mCount;
+    while ( low < high ) {
+        size_t middle = low + (high - low) / 2;
+        int order = key_at(middle).compare(key);
+        if ( order == 0 ) return true;
+        if ( order < 0 ) low = middle + 1;
+        else high = middle;
+    }
+    return false;
+}
+
+MappedValue MappedObject::operator[](std::string_view key) const {
+    size_t low = 0;
+    size_t high = mCount;
+    while ( low < high ) {
+        size_t middle = low + (high - low) / 2;
+        int order = key_at(middle).compare(key);
+        if ( order == 0 ) return value(middle);
+        if ( order < 0 ) low = middle + 1;
+        else high = middle;
+    }
+    throw InvalidKeyException("Key does not exist");
+}
+
+std::string_view MappedObject::key(size_t index) const {
+    if ( index >= mCount ) throw InvalidIndexException("Index out of bounds");
+    return key_at(index);
+}
+
+MappedValue MappedObject::value(size_t index) const {
+    if ( index >= mCount ) throw InvalidIndexException("Index out of bounds");
+    const MappedSlot& slot = mDocument->at<MappedEntry>(mOffset)[index].value;
+    return MappedValue(mDocument, static_cast<BaseDataType>(slot.type), slot.data);
+}
+
+
+MappedList::MappedList(const MappedDocument* document, uint32_t offset) : mDocument(document) {
+    const MappedBlock& block = *document->at<MappedBlock>(offset);
+    mOffset = offset + sizeof(MappedBlock);
+    mCount = block.count;
+    mElementType = static_cast<BaseDataType>(block.elementType);
+
+    // check the whole element array once
+    switch ( mElementType ) {
+        case BaseDataType::INT:    document->at<int>(mOffset, mCount); break;
+        case BaseDataType::DOUBLE: document->at<double>(mOffset, mCount); break;
+        case BaseDataType::BOOL:   document->at<bool>(mOffset, mCount); break;
+        case BaseDataType::NONE:   document->at<MappedSlot>(mOffset, mCount); break;
+        default: throw InvalidFormatException("Invalid element type in the mapped document");
+    }
+}
+
+MappedValue MappedList::operator[](size_t index) const {
+    if ( index >= mCount ) throw InvalidIndexException("Index out of bounds");
+    switch ( mElementType ) {
+        case BaseDataType::INT:
+            return MappedValue(mDocument, BaseDataType::INT, std::bit_cast<uint32_t>(ints()[index]));
+        case BaseDataType::DOUBLE:
+            return MappedValue(mDocument, BaseDataType::DOUBLE, static_cast<uint32_t>(mOffset + index * sizeof(double)));
+        case BaseDataType::BOOL:
+            return MappedValue(mDocument, BaseDataType::BOOL, static_cast<uint8_t>(mDocument->mImage[mOffset + index]));
+        default: {
+            const MappedSlot& slot = mDocument->at<MappedSlot>(mOffset)[index];
+            return MappedValue(mDocument, static_cast<BaseDataType>(slot.type), slot.data);
+        }
+    }
+}
+
+std::span<const int> MappedList::ints() const {
+    if ( mElementType != BaseDataType::INT && !empty() ) throw InvalidTypeException("List does not only hold integers");
+    if ( empty() ) return {};
+    return std::span<const int>(mDocument->at<int>(mOffset), mCount);
+}
+
+std::span<const double> MappedList::doubles() const {
+    if ( mElementType != BaseDataType::DOUBLE && !empty() ) throw InvalidTypeException("List does not only hold doubles");
+    if ( empty() ) return {};
+    return std::span<const double>(mDocument->at<double>(mOffset), mCount);
+}
+
+std::span<const bool> MappedList::bools() const {
+    if ( mElementType != BaseDataType::BOOL && !empty() ) throw InvalidTypeException("List does not only hold booleans");
+    if ( empty() ) return {};
+    // any other byte would be an invalid bool
+    const char* bytes = mDocument->at<char>(mOffset, mCount);
+    if ( std::any_of(bytes, bytes + mCount, [](char c) { return static_cast<uint8_t>(c) > 1; }) )
+        throw InvalidFormatException("Invalid bool in the mapped document");
+    return std::span<const bool>(reinterpret_cast<const bool*>(bytes), mCount);
+}
+
+} // namespace JSONJay
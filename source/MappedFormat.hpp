@@ -0,0 +1,88 @@
+/**
+ * @file MappedFormat.hpp
+ * @author TL044CN
+ * @brief layout of the memory mappable document format
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <cstdint>
+
+namespace JSONJay {
+
+// A mapped document is one block of memory in host byte order that is read
+// in place. Nodes refer to each other by offsets from the start of the image,
+// every node is aligned to its largest field.
+//
+// header   := MappedHeader, the root value is an Object or a List
+// Object   := MappedBlock, count * MappedEntry sorted by key bytes
+// List     := MappedBlock, then count * MappedSlot if the element type is
+//             NONE, else count packed ints, doubles or one byte bools
+// string   := uint32 size, bytes
+// double   := 8 bytes
+// key      := bytes, the size is in the entry
+
+/**
+ * @brief the first bytes of every mapped document, the last one is the version
+ */
+constexpr char kMappedMagic[4] = { 'J', 'J', 'M', 1 };
+
+/**
+ * @brief written in host byte order to detect images of other hosts
+ */
+constexpr uint32_t kMappedByteOrder = 0x01020304;
+
+/**
+ * @brief the alignment of the image and of every Object and List
+ */
+constexpr size_t kMappedAlignment = 8;
+
+/**
+ * @brief a value as stored in an Object or List
+ * @details Ints and bools are stored in data, strings, doubles, Objects and
+ *          Lists are stored elsewhere and data is their offset.
+ */
+struct MappedSlot {
+    uint32_t type;      ///< the BaseDataType of the value
+    uint32_t data;
+};
+
+/**
+ * @brief the start of every Object and List
+ */
+struct MappedBlock {
+    uint32_t count;
+    uint32_t elementType;   ///< the BaseDataType of packed List elements, NONE otherwise
+};
+
+/**
+ * @brief a member of an Object
+ */
+struct MappedEntry {
+    uint32_t keyOffset;
+    uint32_t keySize;
+    MappedSlot value;
+};
+
+/**
+ * @brief the start of the image
+ */
+struct MappedHeader {
+    char magic[4];
+    uint32_t byteOrder;
+    uint32_t size;          ///< the size of the whole image
+    uint32_t reserved;
+    MappedSlot root;
+};
+
+static_assert(sizeof(MappedSlot) == 8 && sizeof(MappedBlock) == 8 && sizeof(MappedEntry) == 16);
+static_assert(sizeof(MappedHeader) % kMappedAlignment == 0);
+
+} // namespace JSONJay
@@ -0,0 +1,130 @@
+#include "MappedWriter.hpp"
+#include "MappedFormat.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace JSONJay {
+
+uint32_t MappedWriter::reserve(size_t size, size_t alignment) {
+    size_t offset = (mImage.size() + alignment - 1) / alignment * alignment;
+    if ( offset + size >= std::numeric_limits<uint32_t>::max() ) throw InvalidValueException("Mapped document too large");
+    mImage.resize(offset + size);
+    return static_cast<uint32_t>(offset);
+}
+
+uint32_t MappedWriter::write_string(std::string_view string) {
+    uint32_t offset = reserve(sizeof(uint32_t) + string.size(), alignof(uint32_t));
+    uint32_t size = static_cast<uint32_t>(string.size());
+    store(offset, &size, sizeof(size));
+    store(offset + sizeof(uint32_t), string.data(), string.size());
+    return offset;
+}
+
+void MappedWriter::write_value(const Value& value, uint32_t& type, uint32_t& data) {
+    type = static_cast<uint32_t>(value.type());
+    switch ( value.type() ) {
+        case BaseDataType::STRING: data = write_string(value.as_string()); break;
+        case BaseDataType::INT:    data = std::bit_cast<uint32_t>(value.get<int>()); break;
+        case BaseDataType::BOOL:   data = value.get<bool>() ? 1 : 0; break;
+        case BaseDataType::OBJECT: data = write_object(*value.get<Object*>()); break;
+        case BaseDataType::LIST:   data = write_list(*value.get<List*>()); break;
+        case BaseDataType::DOUBLE: {
+            double number = value.get<double>();
+            data = reserve(sizeof(double), alignof(double));
+            store(data, &number, sizeof(number));
+            break;
+        }
+        default:
+            data = 0;
+            break;
+    }
+}
+
+uint32_t MappedWriter::write_object(const Object& object) {
+    // large stores are hashed, the key table has to be sorted
+    std::vector<const MemberStore::Member*> members;
+    members.reserve(object.members().size());
+    for ( const MemberStore::Member& member : object.members() ) members.push_back(&member);
+    std::sort(members.begin(), members.end(),
+        [](const MemberStore::Member* lhs, const MemberStore::Member* rhs) { return lhs->key() < rhs->key(); });
+
+    uint32_t offset = reserve(sizeof(MappedBlock) + members.size() * sizeof(MappedEntry), kMappedAlignment);
+    MappedBlock block{ static_cast<uint32_t>(members.size()), static_cast<uint32_t>(BaseDataType::NONE) };
+    store(offset, &block, sizeof(block));
+
+    // children go behind the key table, offsets into it stay valid as the image grows
+    for ( size_t i = 0; i < members.size(); i++ ) {
+        std::string_view key = members[i]->key();
+        MappedEntry entry{ reserve(key.size(), 1), static_cast<uint32_t>(key.size()), {} };
+        store(entry.keyOffset, key.data(), key.size());
+        write_value(members[i]->value, entry.value.type, entry.value.data);
+        store(static_cast<uint32_t>(offset + sizeof(MappedBlock) + i * sizeof(MappedEntry)), &entry, sizeof(entry));
+    }
+    return offset;
+}
+
+template<typename T>
+uint32_t MappedWriter::write_scalars(std::span<const T> values) {
+    uint32_t offset = reserve(sizeof(MappedBlock) + values.size_bytes(), kMappedAlignment);
+    MappedBlock block{ static_cast<uint32_t>(values.size()), static_cast<uint32_t>(Value::type_of<T>()) };
+    store(offset, &block, sizeof(block));
+    store(offset + sizeof(MappedBlock), values.data(), values.size_bytes());
+    return offset;
+}
+
+uint32_t MappedWriter::write_list(const List& list) {
+    switch ( list.element_type() ) {
+        case BaseDataType::INT:    return write_scalars(list.ints());
+        case BaseDataType::DOUBLE: return write_scalars(list.doubles());
+        case BaseDataType::BOOL:   return write_scalars(list.bools());
+        default: break;
+    }
+
+    std::span<const Value> values = list.values();
+    uint32_t offset = reserve(sizeof(MappedBlock) + values.size() * sizeof(MappedSlot), kMappedAlignment);
+    MappedBlock block{ static_cast<uint32_t>(values.size()), static_cast<uint32_t>(BaseDataType::NONE) };
+    store(offset, &block, sizeof(block));
+
+    for ( size_t i = 0; i < values.size(); i++ ) {
+        MappedSlot slot;
+        write_value(values[i], slot.type, slot.data);
+        store(static_cast<uint32_t>(offset + sizeof(MappedBlock) + i * sizeof(MappedSlot)), &slot, sizeof(slot));
+    }
+    return offset;
+}
+
+template<typename Write>
+bool MappedWriter::run(StreamWritinator& stream, BaseDataType rootType, Write&& write) {
+    mImage.clear();
+    reserve(sizeof(MappedHeader), kMappedAlignment);
+    uint32_t root = write();
+
+    // pad the image so images can be stored back to back
+    reserve(0, kMappedAlignment);
+    MappedHeader header{};
+    std::memcpy(header.magic, kMappedMagic, sizeof(kMappedMagic));
+    header.byteOrder = kMappedByteOrder;
+    header.size = static_cast<uint32_t>(mImage.size());
+    header.root = MappedSlot{ static_cast<uint32_t>(rootType), root };
+    store(0, &header, sizeof(header));
+
+    return stream.writeData(mImage.data(), mImage.size()) && stream.isStreamGood();
+}
+
+bool MappedWriter::write(StreamWritinator& stream, const Object& object) {
+    return run(stream, BaseDataType::OBJECT, [&] { return write_object(object); });
+}
+
+bool MappedWriter::write(StreamWritinator& stream, const List& list) {
+    return run(stream, BaseDataType::LIST, [&] { return write_list(list); });
+}
+
+bool MappedWriter::write(StreamWritinator& stream, const Document& document) {
+    if ( document.root_type() == BaseDataType::OBJECT ) return write(stream, document.object());
+    return write(stream, document.list());
+}
+
+} // namespace JSONJay
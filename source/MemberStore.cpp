@@ -0,0 +1,194 @@
+#include "MemberStore.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace JSONJay {
+
+MemberStore::MemberStore(const allocator_type& allocator) : mMembers(allocator), mSlots(allocator) {}
+
+MemberStore::MemberStore(MemberStore&& other, const allocator_type& allocator)
+    : mMembers(allocator), mSlots(allocator) {
+    if ( allocator == other.get_allocator() ) {
+        mMembers = std::move(other.mMembers);
+        mSlots = std::move(other.mSlots);
+        other.mMembers.clear();
+        other.mSlots.clear();
+        return;
+    }
+
+    // different arena: keys and values have to move over
+    mMembers.reserve(other.size());
+    for ( Member& member : other.mMembers ) {
+        Member moved = make_member(member.key(), member.hash);
+        moved.value = member.value.relocate(other.get_allocator(), get_allocator());
+        mMembers.push_back(moved);
+    }
+    if ( other.hashed() ) rehash(other.mSlots.size());
+    other.clear();
+}
+
+MemberStore::~MemberStore() {
+    for ( Member& member : mMembers ) release_key(member);
+}
+
+
+size_t MemberStore::lower_bound(std::string_view key) const noexcept {
+    auto it = std::lower_bound(mMembers.begin(), mMembers.end(), key,
+        [](const Member& member, std::string_view k) { return member.key() < k; });
+    return static_cast<size_t>(it - mMembers.begin());
+}
+
+size_t MemberStore::probe(std::string_view key, uint32_t hash) const noexcept {
+    size_t mask = mSlots.size() - 1;
+    size_t slot = hash & mask;
+    while ( mSlots[slot].index != 0 ) {
+        if ( mSlots[slot].hash == hash && mMembers[mSlots[slot].index - 1].key() == key )
+            return slot;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+size_t MemberStore::slot_of(size_t index) const noexcept {
+    size_t mask = mSlots.size() - 1;
+    size_t slot = mMembers[index].hash & mask;
+    while ( mSlots[slot].index != index + 1 ) slot = (slot + 1) & mask;
+    return slot;
+}
+
+void MemberStore::rehash(size_t capacity) {
+    mSlots.assign(capacity, Slot{ 0, 0 });
+    size_t mask = capacity - 1;
+    for ( size_t i = 0; i < mMembers.size(); i++ ) {
+        size_t slot = mMembers[i].hash & mask;
+        while ( mSlots[slot].index != 0 ) slot = (slot + 1) & mask;
+        mSlots[slot] = Slot{ mMembers[i].hash, static_cast<uint32_t>(i + 1) };
+    }
+}
+
+void MemberStore::unhash() {
+    mSlots.clear();
+    mSlots.shrink_to_fit();
+}
+
+MemberStore::Member MemberStore::make_member(std::string_view key, uint32_t hash) {
+    if ( key.size() > std::numeric_limits<uint32_t>::max() )
+        throw InvalidKeyException("Key too long");
+
+    char* data = nullptr;
+    if ( !key.empty() ) {
+        allocator_type allocator = get_allocator();
+        data = static_cast<char*>(allocator.allocate_bytes(key.size(), alignof(char)));
+        std::memcpy(data, key.data(), key.size());
+    }
+    return Member{ data, static_cast<uint32_t>(key.size()), hash, Value() };
+}
+
+void MemberStore::release_key(Member& member) noexcept {
+    if ( member.keyData == nullptr ) return;
+    allocator_type allocator = get_allocator();
+    allocator.deallocate_bytes(const_cast<char*>(member.keyData), member.keySize, alignof(char));
+    member.keyData = nullptr;
+}
+
+
+MemberStore::allocator_type MemberStore::get_allocator() const {
+    return mMembers.get_allocator();
+}
+
+MemberStore::Member* MemberStore::find(std::string_view key) noexcept {
+    // the sorted vector does not need the hash
+    if ( hashed() ) return find(key, hash_key(key));
+    return find(key, 0);
+}
+
+MemberStore::Member* MemberStore::find(std::string_view key, uint32_t hash) noexcept {
+    if ( hashed() ) {
+        uint32_t index = mSlots[probe(key, hash)].index;
+        return index == 0 ? nullptr : &mMembers[index - 1];
+    }
+
+    size_t position = lower_bound(key);
+    if ( position < mMembers.size() && mMembers[position].key() == key ) return &mMembers[position];
+    return nullptr;
+}
+
+std::pair<MemberStore::Member*, bool> MemberStore::try_emplace(std::string_view key, uint32_t hash) {
+    size_t slot = 0;
+    if ( hashed() ) {
+        slot = probe(key, hash);
+        if ( mSlots[slot].index != 0 ) return { &mMembers[mSlots[slot].index - 1], false };
+
+        // keep the load factor at or below one half
+        if ( (mMembers.size() + 1) * 2 > mSlots.size() ) {
+            rehash(mSlots.size() * 2);
+            slot = probe(key, hash);
+        }
+    }
+
+    size_t position = lower_bound(key);
+    if ( !hashed() && position < mMembers.size() && mMembers[position].key() == key )
+        return { &mMembers[position], false };
+
+    // the key is copied once the member has its place, so it cannot leak
+    mMembers.insert(mMembers.begin() + position, Member{ nullptr, 0, hash, Value() });
+    try {
+        mMembers[position] = make_member(key, hash);
+    } catch ( ... ) {
+        mMembers.erase(mMembers.begin() + position);
+        throw;
+    }
+
+    if ( hashed() ) {
+        // the members behind the new one moved up by one
+        for ( Slot& entry : mSlots )
+            if ( entry.index > position ) entry.index++;
+        mSlots[slot] = Slot{ hash, static_cast<uint32_t>(position + 1) };
+    } else if ( mMembers.size() >= kHashThreshold ) {
+        rehash(std::bit_ceil(mMembers.size() * 2));
+    }
+    return { &mMembers[position], true };
+}
+
+void MemberStore::erase(Member* member) {
+    size_t index = static_cast<size_t>(member - mMembers.data());
+    release_key(*member);
+
+    if ( !hashed() ) {
+        mMembers.erase(mMembers.begin() + index);
+        return;
+    }
+
+    // backward shift deletion keeps every probe sequence intact
+    size_t mask = mSlots.size() - 1;
+    size_t hole = slot_of(index);
+    size_t next = hole;
+    while ( true ) {
+        next = (next + 1) & mask;
+        if ( mSlots[next].index == 0 ) break;
+        size_t home = mSlots[next].hash & mask;
+        bool inRange = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if ( inRange ) continue;
+        mSlots[hole] = mSlots[next];
+        hole = next;
+    }
+    mSlots[hole] = Slot{ 0, 0 };
+
+    // the members behind the erased one move down by one
+    mMembers.erase(mMembers.begin() + index);
+    for ( Slot& entry : mSlots )
+        if ( entry.index > index + 1 ) entry.index--;
+
+    if ( mMembers.size() < kHashThreshold / 2 ) unhash();
+}
+
+void MemberStore::clear() noexcept {
+    for ( Member& member : mMembers ) release_key(member);
+    mMembers.clear();
+    mSlots.clear();
+}
+
+} // namespace JSONJay
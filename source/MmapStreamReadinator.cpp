@@ -0,0 +1,145 @@
+#include "MmapStreamReadinator.hpp"
+#include "DelimiterSearch.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace JSONJay {
+
+#ifdef _WIN32
+
+MmapStreamReadinator::MmapStreamReadinator(const std::string& filename, MmapAdvice advice) {
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        advice == MmapAdvice::SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+    if ( file == INVALID_HANDLE_VALUE ) return;
+    mFile = file;
+
+    LARGE_INTEGER size;
+    if ( !GetFileSizeEx(file, &size) ) return;
+    mSize = static_cast<uint64_t>(size.QuadPart);
+    if ( mSize == 0 ) {
+        mGood = true;
+        return;
+    }
+
+    mMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if ( mMapping == nullptr ) return;
+    mData = static_cast<const char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+    if ( mData == nullptr ) return;
+    mGood = true;
+    advise(advice);
+}
+
+MmapStreamReadinator::~MmapStreamReadinator() {
+    if ( mData != nullptr ) UnmapViewOfFile(mData);
+    if ( mMapping != nullptr ) CloseHandle(mMapping);
+    if ( mFile != nullptr ) CloseHandle(mFile);
+}
+
+void MmapStreamReadinator::advise(MmapAdvice advice) {
+    if ( mData == nullptr || advice != MmapAdvice::WILLNEED ) return;
+    WIN32_MEMORY_RANGE_ENTRY range{ const_cast<char*>(mData), static_cast<SIZE_T>(mSize) };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+MmapStreamReadinator::MmapStreamReadinator(const std::string& filename, MmapAdvice advice) {
+    int file = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if ( file < 0 ) return;
+
+    struct stat status;
+    if ( ::fstat(file, &status) == 0 ) {
+        mSize = static_cast<uint64_t>(status.st_size);
+        if ( mSize == 0 ) {
+            mGood = true;
+        } else {
+            void* mapping = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+            if ( mapping != MAP_FAILED ) {
+                mData = static_cast<const char*>(mapping);
+                mGood = true;
+            }
+        }
+    }
+    // the mapping keeps the file alive
+    ::close(file);
+    if ( mData == nullptr ) mSize = 0;
+    else advise(advice);
+}
+
+MmapStreamReadinator::~MmapStreamReadinator() {
+    if ( mData != nullptr ) ::munmap(const_cast<char*>(mData), mSize);
+}
+
+void MmapStreamReadinator::advise(MmapAdvice advice) {
+    if ( mData == nullptr ) return;
+    int hint = MADV_NORMAL;
+    switch ( advice ) {
+        case MmapAdvice::SEQUENTIAL: hint = MADV_SEQUENTIAL; break;
+        case MmapAdvice::RANDOM:     hint = MADV_RANDOM; break;
+        case MmapAdvice::WILLNEED:   hint = MADV_WILLNEED; break;
+        default: break;
+    }
+    ::madvise(const_cast<char*>(mData), mSize, hint);
+}
+
+#endif
+
+
+bool MmapStreamReadinator::isStreamGood() const {
+    return mGood;
+}
+
+uint64_t MmapStreamReadinator::getStreamPosition() {
+    return mPosition;
+}
+
+void MmapStreamReadinator::setStreamPosition(uint64_t position) {
+    mPosition = position;
+}
+
+uint64_t MmapStreamReadinator::readSome(char* data, uint64_t size) {
+    if ( mPosition >= mSize ) return 0;
+    uint64_t count = std::min(size, mSize - mPosition);
+    std::memcpy(data, mData + mPosition, count);
+    mPosition += count;
+    return count;
+}
+
+bool MmapStreamReadinator::readUntil(std::vector<char>& data, char delim) {
+    std::string_view view;
+    bool found = readViewUntil(view, std::string_view(&delim, 1));
+    data.insert(data.end(), view.begin(), view.end());
+    return found;
+}
+
+bool MmapStreamReadinator::readUntil(std::vector<char>& data, std::string delim) {
+    std::string_view view;
+    bool found = readViewUntil(view, delim);
+    data.insert(data.end(), view.begin(), view.end());
+    return found;
+}
+
+bool MmapStreamReadinator::readViewUntil(std::string_view& view, std::string_view delim) {
+    std::string_view rest;
+    if ( mPosition < mSize ) rest = std::string_view(mData + mPosition, mSize - mPosition);
+    size_t at = find_delimiter(rest, delim);
+    bool found = at != std::string_view::npos;
+    view = rest.substr(0, found ? at + delim.size() : rest.size());
+    mPosition += view.size();
+    if ( !found ) mGood = false;
+    return found;
+}
+
+} // namespace JSONJay
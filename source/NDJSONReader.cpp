@@ -0,0 +1,169 @@
+#include "NDJSONReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace JSONJay {
+
+NDJSONReader::NDJSONReader(size_t threads, size_t chunkSize)
+    : mPool(threads), mChunkSize(chunkSize == 0 ? 1 : chunkSize), mParsers(mPool.size()) {}
+
+void NDJSONReader::start() {
+    mDone.clear();
+    mInFlight = 0;
+    mNextBatch = 0;
+    mDelivered = 0;
+    mFailed = false;
+}
+
+void NDJSONReader::submit(std::string_view text, std::shared_ptr<const std::string> owner, size_t index) {
+    {
+        std::lock_guard lock(mMutex);
+        mInFlight++;
+    }
+    mPool.submit([this, text, owner = std::move(owner), index](size_t worker) {
+        NDJSONBatch batch;
+        batch.index = index;
+        try {
+            JSONParser& parser = mParsers[worker];
+            size_t begin = 0;
+            while ( begin < text.size() ) {
+                size_t end = text.find('\n', begin);
+                if ( end == std::string_view::npos ) end = text.size();
+                std::string_view line = text.substr(begin, end - begin);
+                if ( line.find_first_not_of(" \t\r") != std::string_view::npos )
+                    batch.documents.push_back(parser.parse(line));
+                begin = end + 1;
+            }
+        } catch ( ... ) {
+            {
+                std::lock_guard lock(mMutex);
+                mFailed = true;
+            }
+            mReady.notify_all();
+            throw;
+        }
+
+        {
+            std::lock_guard lock(mMutex);
+            mDone.emplace(index, std::move(batch));
+        }
+        mReady.notify_all();
+    });
+}
+
+void NDJSONReader::deliver(const consumer_t& consumer, BatchOrder order, size_t limit) {
+    std::unique_lock lock(mMutex);
+    while ( true ) {
+        if ( mFailed ) {
+            lock.unlock();
+            // let the other chunks finish, then rethrow the error
+            mPool.wait();
+            return;
+        }
+
+        auto ready = order == BatchOrder::ORDERED ? mDone.find(mNextBatch) : mDone.begin();
+        if ( ready != mDone.end() ) {
+            NDJSONBatch batch = std::move(ready->second);
+            mDone.erase(ready);
+            mInFlight--;
+            mNextBatch++;
+            mDelivered += batch.documents.size();
+            lock.unlock();
+            consumer(batch);
+            lock.lock();
+            continue;
+        }
+
+        if ( mInFlight <= limit ) return;
+        mReady.wait(lock);
+    }
+}
+
+void NDJSONReader::settle() noexcept {
+    // the chunks in flight refer to the input, they have to finish first
+    try {
+        mPool.wait();
+    } catch ( ... ) {
+    }
+}
+
+size_t NDJSONReader::read(std::string_view text, const consumer_t& consumer, BatchOrder order) {
+    start();
+    try {
+        read_chunks(text, consumer, order);
+    } catch ( ... ) {
+        settle();
+        throw;
+    }
+    return mDelivered;
+}
+
+void NDJSONReader::read_chunks(std::string_view text, const consumer_t& consumer, BatchOrder order) {
+    size_t limit = 2 * mPool.size();
+    size_t index = 0;
+    size_t begin = 0;
+    while ( begin < text.size() ) {
+        size_t end = begin + mChunkSize;
+        if ( end >= text.size() ) {
+            end = text.size();
+        } else {
+            // extend the chunk to the end of its last line
+            const void* newline = std::memchr(text.data() + end, '\n', text.size() - end);
+            end = newline == nullptr ? text.size() : static_cast<size_t>(static_cast<const char*>(newline) - text.data()) + 1;
+        }
+        submit(text.substr(begin, end - begin), nullptr, index++);
+        begin = end;
+        deliver(consumer, order, limit);
+    }
+    deliver(consumer, order, 0);
+    mPool.wait();
+}
+
+size_t NDJSONReader::read(StreamReadinator& reader, const consumer_t& consumer, BatchOrder order) {
+    start();
+    try {
+        read_chunks(reader, consumer, order);
+    } catch ( ... ) {
+        settle();
+        throw;
+    }
+    return mDelivered;
+}
+
+void NDJSONReader::read_chunks(StreamReadinator& reader, const consumer_t& consumer, BatchOrder order) {
+    size_t limit = 2 * mPool.size();
+    size_t index = 0;
+    std::string carry;
+    bool end = false;
+    while ( !end ) {
+        auto chunk = std::make_shared<std::string>(std::move(carry));
+        carry = std::string();
+
+        // fill the chunk, it has to hold at least one line end
+        size_t lastNewline = std::string::npos;
+        while ( !end && (chunk->size() < mChunkSize || lastNewline == std::string::npos) ) {
+            size_t size = chunk->size();
+            size_t want = std::max(mChunkSize - std::min(size, mChunkSize), mChunkSize / 4 + 1);
+            chunk->resize(size + want);
+            uint64_t count = reader.readSome(chunk->data() + size, want);
+            chunk->resize(size + count);
+            if ( count == 0 ) end = true;
+            lastNewline = chunk->rfind('\n');
+        }
+
+        if ( !end && lastNewline != std::string::npos ) {
+            carry.assign(*chunk, lastNewline + 1);
+            chunk->resize(lastNewline + 1);
+        }
+        if ( chunk->empty() ) continue;
+
+        std::string_view text(*chunk);
+        submit(text, std::move(chunk), index++);
+        deliver(consumer, order, limit);
+    }
+    deliver(consumer, order, 0);
+    mPool.wait();
+}
+
+} // namespace JSONJay
@@ -0,0 +1,507 @@
+#include "Numeric.hpp"
+#include "List.hpp"
+#include "Exceptions.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+
+namespace JSONJay::numeric {
+
+namespace {
+
+/**
+ * @brief one implementation of every kernel
+ */
+struct Kernels {
+    double        (*sumDouble)(const double*, size_t);
+    int64_t       (*sumInt)(const int*, size_t);
+    MinMax<double>(*minmaxDouble)(const double*, size_t);
+    MinMax<int>   (*minmaxInt)(const int*, size_t);
+    size_t        (*countDouble)(const double*, size_t, Compare, double);
+    size_t        (*countInt)(const int*, size_t, Compare, int);
+    void          (*scaleDouble)(double*, size_t, double);
+    void          (*convertInt)(const int*, size_t, double*);
+};
+
+template<typename T>
+bool compare(T value, Compare op, T threshold) {
+    switch ( op ) {
+        case Compare::LESS:          return value < threshold;
+        case Compare::LESS_EQUAL:    return value <= threshold;
+        case Compare::GREATER:       return value > threshold;
+        case Compare::GREATER_EQUAL: return value >= threshold;
+        case Compare::EQUAL:         return value == threshold;
+        default:                     return value != threshold;
+    }
+}
+
+// scalar kernels, also used for the tails of the vector kernels
+
+double sum_scalar(const double* values, size_t count) {
+    double total = 0;
+    for ( size_t i = 0; i < count; i++ ) total += values[i];
+    return total;
+}
+
+int64_t sum_scalar(const int* values, size_t count) {
+    int64_t total = 0;
+    for ( size_t i = 0; i < count; i++ ) total += values[i];
+    return total;
+}
+
+template<typename T>
+MinMax<T> minmax_scalar(const T* values, size_t count) {
+    MinMax<T> result{ values[0], values[0] };
+    for ( size_t i = 1; i < count; i++ ) {
+        result.min = std::min(result.min, values[i]);
+        result.max = std::max(result.max, values[i]);
+    }
+    return result;
+}
+
+template<typename T>
+size_t count_scalar(const T* values, size_t count, Compare op, T threshold) {
+    size_t matches = 0;
+    for ( size_t i = 0; i < count; i++ ) matches += compare(values[i], op, threshold);
+    return matches;
+}
+
+void scale_scalar(double* values, size_t count, double factor) {
+    for ( size_t i = 0; i < count; i++ ) values[i] *= factor;
+}
+
+void convert_scalar(const int* values, size_t count, double* out) {
+    for ( size_t i = 0; i < count; i++ ) out[i] = values[i];
+}
+
+constexpr Kernels kScalarKernels{
+    sum_scalar, sum_scalar, minmax_scalar<double>, minmax_scalar<int>,
+    count_scalar<double>, count_scalar<int>, scale_scalar, convert_scalar
+};
+
+#if JSONJAY_SIMD_X86
+
+// SSE2 kernels
+
+double sum_sse2(const double* values, size_t count) {
+    __m128d a = _mm_setzero_pd(), b = _mm_setzero_pd();
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        a = _mm_add_pd(a, _mm_loadu_pd(values + i));
+        b = _mm_add_pd(b, _mm_loadu_pd(values + i + 2));
+    }
+    a = _mm_add_pd(a, b);
+    double lanes[2];
+    _mm_storeu_pd(lanes, a);
+    return lanes[0] + lanes[1] + sum_scalar(values + i, count - i);
+}
+
+int64_t sum_sse2(const int* values, size_t count) {
+    __m128i total = _mm_setzero_si128();
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        total = _mm_add_epi64(total, _mm_unpacklo_epi32(v, sign));
+        total = _mm_add_epi64(total, _mm_unpackhi_epi32(v, sign));
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), total);
+    return lanes[0] + lanes[1] + sum_scalar(values + i, count - i);
+}
+
+MinMax<double> minmax_sse2(const double* values, size_t count) {
+    if ( count < 2 ) return minmax_scalar(values, count);
+    __m128d low = _mm_loadu_pd(values), high = low;
+    size_t i = 2;
+    for ( ; i + 2 <= count; i += 2 ) {
+        __m128d v = _mm_loadu_pd(values + i);
+        low = _mm_min_pd(low, v);
+        high = _mm_max_pd(high, v);
+    }
+    double lows[2], highs[2];
+    _mm_storeu_pd(lows, low);
+    _mm_storeu_pd(highs, high);
+    MinMax<double> result{ std::min(lows[0], lows[1]), std::max(highs[0], highs[1]) };
+    for ( ; i < count; i++ ) {
+        result.min = std::min(result.min, values[i]);
+        result.max = std::max(result.max, values[i]);
+    }
+    return result;
+}
+
+MinMax<int> minmax_sse2(const int* values, size_t count) {
+    if ( count < 4 ) return minmax_scalar(values, count);
+    // SSE2 has no 32 bit min/max, select with compare masks instead
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values)), high = low;
+    size_t i = 4;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i less = _mm_cmplt_epi32(v, low);
+        __m128i greater = _mm_cmpgt_epi32(v, high);
+        low = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, low));
+        high = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, high));
+    }
+    int lows[4], highs[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lows), low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(highs), high);
+    MinMax<int> result{ *std::min_element(lows, lows + 4), *std::max_element(highs, highs + 4) };
+    for ( ; i < count; i++ ) {
+        result.min = std::min(result.min, values[i]);
+        result.max = std::max(result.max, values[i]);
+    }
+    return result;
+}
+
+__m128d compare_sse2(__m128d v, Compare op, __m128d threshold) {
+    switch ( op ) {
+        case Compare::LESS:          return _mm_cmplt_pd(v, threshold);
+        case Compare::LESS_EQUAL:    return _mm_cmple_pd(v, threshold);
+        case Compare::GREATER:       return _mm_cmpgt_pd(v, threshold);
+        case Compare::GREATER_EQUAL: return _mm_cmpge_pd(v, threshold);
+        case Compare::EQUAL:         return _mm_cmpeq_pd(v, threshold);
+        default:                     return _mm_cmpneq_pd(v, threshold);
+    }
+}
+
+size_t count_sse2(const double* values, size_t count, Compare op, double threshold) {
+    __m128d limit = _mm_set1_pd(threshold);
+    size_t matches = 0;
+    size_t i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+        matches += std::popcount(static_cast<unsigned>(_mm_movemask_pd(compare_sse2(_mm_loadu_pd(values + i), op, limit))));
+    return matches + count_scalar(values + i, count - i, op, threshold);
+}
+
+size_t count_sse2(const int* values, size_t count, Compare op, int threshold) {
+    // only greater and equal exist for integers, the rest are derived
+    bool invert = op == Compare::LESS_EQUAL || op == Compare::GREATER_EQUAL || op == Compare::NOT_EQUAL;
+    __m128i limit = _mm_set1_epi32(threshold);
+    size_t matches = 0;
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i mask;
+        switch ( op ) {
+            case Compare::LESS:
+            case Compare::GREATER_EQUAL: mask = _mm_cmplt_epi32(v, limit); break;
+            case Compare::GREATER:
+            case Compare::LESS_EQUAL:    mask = _mm_cmpgt_epi32(v, limit); break;
+            default:                     mask = _mm_cmpeq_epi32(v, limit); break;
+        }
+        size_t hits = std::popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(mask))));
+        matches += invert ? 4 - hits : hits;
+    }
+    return matches + count_scalar(values + i, count - i, op, threshold);
+}
+
+void scale_sse2(double* values, size_t count, double factor) {
+    __m128d f = _mm_set1_pd(factor);
+    size_t i = 0;
+    for ( ; i + 2 <= count; i += 2 ) _mm_storeu_pd(values + i, _mm_mul_pd(_mm_loadu_pd(values + i), f));
+    scale_scalar(values + i, count - i, factor);
+}
+
+void convert_sse2(const int* values, size_t count, double* out) {
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        _mm_storeu_pd(out + i, _mm_cvtepi32_pd(v));
+        _mm_storeu_pd(out + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+    convert_scalar(values + i, count - i, out + i);
+}
+
+constexpr Kernels kSse2Kernels{
+    sum_sse2, sum_sse2, minmax_sse2, minmax_sse2,
+    count_sse2, count_sse2, scale_sse2, convert_sse2
+};
+
+#endif
+
+#if JSONJAY_HAS_AVX2
+
+// AVX2 kernels
+
+JSONJAY_TARGET_AVX2 double sum_avx2(const double* values, size_t count) {
+    __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 ) {
+        a = _mm256_add_pd(a, _mm256_loadu_pd(values + i));
+        b = _mm256_add_pd(b, _mm256_loadu_pd(values + i + 4));
+    }
+    a = _mm256_add_pd(a, b);
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+    double lanes[2];
+    _mm_storeu_pd(lanes, half);
+    return lanes[0] + lanes[1] + sum_scalar(values + i, count - i);
+}
+
+JSONJAY_TARGET_AVX2 int64_t sum_avx2(const int* values, size_t count) {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(v));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(values + i, count - i);
+}
+
+JSONJAY_TARGET_AVX2 MinMax<double> minmax_avx2(const double* values, size_t count) {
+    if ( count < 4 ) return minmax_scalar(values, count);
+    __m256d low = _mm256_loadu_pd(values), high = low;
+    size_t i = 4;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m256d v = _mm256_loadu_pd(values + i);
+        low = _mm256_min_pd(low, v);
+        high = _mm256_max_pd(high, v);
+    }
+    double lows[4], highs[4];
+    _mm256_storeu_pd(lows, low);
+    _mm256_storeu_pd(highs, high);
+    MinMax<double> result{ *std::min_element(lows, lows + 4), *std::max_element(highs, highs + 4) };
+    for ( ; i < count; i++ ) {
+        result.min = std::min(result.min, values[i]);
+        result.max = std::max(result.max, values[i]);
+    }
+    return result;
+}
+
+JSONJAY_TARGET_AVX2 MinMax<int> minmax_avx2(const int* values, size_t count) {
+    if ( count < 8 ) return minmax_scalar(values, count);
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)), high = low;
+    size_t i = 8;
+    for ( ; i + 8 <= count; i += 8 ) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        low = _mm256_min_epi32(low, v);
+        high = _mm256_max_epi32(high, v);
+    }
+    int lows[8], highs[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lows), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(highs), high);
+    MinMax<int> result{ *std::min_element(lows, lows + 8), *std::max_element(highs, highs + 8) };
+    for ( ; i < count; i++ ) {
+        result.min = std::min(result.min, values[i]);
+        result.max = std::max(result.max, values[i]);
+    }
+    return result;
+}
+
+JSONJAY_TARGET_AVX2 __m256d compare_avx2(__m256d v, Compare op, __m256d threshold) {
+    switch ( op ) {
+        case Compare::LESS:          return _mm256_cmp_pd(v, threshold, _CMP_LT_OQ);
+        case Compare::LESS_EQUAL:    return _mm256_cmp_pd(v, threshold, _CMP_LE_OQ);
+        case Compare::GREATER:       return _mm256_cmp_pd(v, threshold, _CMP_GT_OQ);
+        case Compare::GREATER_EQUAL: return _mm256_cmp_pd(v, threshold, _CMP_GE_OQ);
+        case Compare::EQUAL:         return _mm256_cmp_pd(v, threshold, _CMP_EQ_OQ);
+        default:                     return _mm256_cmp_pd(v, threshold, _CMP_NEQ_UQ);
+    }
+}
+
+JSONJAY_TARGET_AVX2 size_t count_avx2(const double* values, size_t count, Compare op, double threshold) {
+    __m256d limit = _mm256_set1_pd(threshold);
+    size_t matches = 0;
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+        matches += std::popcount(static_cast<unsigned>(_mm256_movemask_pd(compare_avx2(_mm256_loadu_pd(values + i), op, limit))));
+    return matches + count_scalar(values + i, count - i, op, threshold);
+}
+
+JSONJAY_TARGET_AVX2 size_t count_avx2(const int* values, size_t count, Compare op, int threshold) {
+    bool invert = op == Compare::LESS_EQUAL || op == Compare::GREATER_EQUAL || op == Compare::NOT_EQUAL;
+    __m256i limit = _mm256_set1_epi32(threshold);
+    size_t matches = 0;
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 ) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i mask;
+        switch ( op ) {
+            case Compare::LESS:
+            case Compare::GREATER_EQUAL: mask = _mm256_cmpgt_epi32(limit, v); break;
+            case Compare::GREATER:
+            case Compare::LESS_EQUAL:    mask = _mm256_cmpgt_epi32(v, limit); break;
+            default:                     mask = _mm256_cmpeq_epi32(v, limit); break;
+        }
+        size_t hits = std::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask))));
+        matches += invert ? 8 - hits : hits;
+    }
+    return matches + count_scalar(values + i, count - i, op, threshold);
+}
+
+JSONJAY_TARGET_AVX2 void scale_avx2(double* values, size_t count, double factor) {
+    __m256d f = _mm256_set1_pd(factor);
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) _mm256_storeu_pd(values + i, _mm256_mul_pd(_mm256_loadu_pd(values + i), f));
+    scale_scalar(values + i, count - i, factor);
+}
+
+JSONJAY_TARGET_AVX2 void convert_avx2(const int* values, size_t count, double* out) {
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+        _mm256_storeu_pd(out + i, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i))));
+    convert_scalar(values + i, count - i, out + i);
+}
+
+constexpr Kernels kAvx2Kernels{
+    sum_avx2, sum_avx2, minmax_avx2, minmax_avx2,
+    count_avx2, count_avx2, scale_avx2, convert_avx2
+};
+
+#endif
+
+const Kernels& kernels_for(Isa isa) noexcept {
+    switch ( isa ) {
+#if JSONJAY_HAS_AVX2
+        case Isa::AVX2: return kAvx2Kernels;
+#endif
+#if JSONJAY_SIMD_X86
+        case Isa::SSE2: return kSse2Kernels;
+#endif
+        default: return kScalarKernels;
+    }
+}
+
+std::atomic<const Kernels*>& active_kernels() noexcept {
+    static std::atomic<const Kernels*> active{ &kernels_for(detected_isa()) };
+    return active;
+}
+
+const Kernels& kernels() noexcept {
+    return *active_kernels().load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+
+Isa active_isa() noexcept {
+    const Kernels* active = active_kernels().load(std::memory_order_relaxed);
+#if JSONJAY_HAS_AVX2
+    if ( active == &kAvx2Kernels ) return Isa::AVX2;
+#endif
+#if JSONJAY_SIMD_X86
+    if ( active == &kSse2Kernels ) return Isa::SSE2;
+#endif
+    return Isa::SCALAR;
+}
+
+Isa set_isa(Isa isa) noexcept {
+    isa = std::min(isa, detected_isa());
+    active_kernels().store(&kernels_for(isa), std::memory_order_relaxed);
+    return isa;
+}
+
+double sum(std::span<const double> values) noexcept {
+    return kernels().sumDouble(values.data(), values.size());
+}
+
+int64_t sum(std::span<const int> values) noexcept {
+    return kernels().sumInt(values.data(), values.size());
+}
+
+MinMax<double> minmax(std::span<const double> values) {
+    if ( values.empty() ) throw InvalidValueException("No values");
+    return kernels().minmaxDouble(values.data(), values.size());
+}
+
+MinMax<int> minmax(std::span<const int> values) {
+    if ( values.empty() ) throw InvalidValueException("No values");
+    return kernels().minmaxInt(values.data(), values.size());
+}
+
+size_t count_if(std::span<const double> values, Compare compare, double threshold) noexcept {
+    return kernels().countDouble(values.data(), values.size(), compare, threshold);
+}
+
+size_t count_if(std::span<const int> values, Compare compare, int threshold) noexcept {
+    return kernels().countInt(values.data(), values.size(), compare, threshold);
+}
+
+void scale(std::span<double> values, double factor) noexcept {
+    kernels().scaleDouble(values.data(), values.size(), factor);
+}
+
+void convert(std::span<const int> values, std::span<double> out) {
+    if ( values.size() != out.size() ) throw InvalidValueException("Ranges differ in size");
+    kernels().convertInt(values.data(), values.size(), out.data());
+}
+
+
+namespace {
+
+/**
+ * @brief read a number of a mixed List
+ */
+double number_at(const List& list, size_t index) {
+    Value element = list.value_at(index);
+    switch ( element.type() ) {
+        case BaseDataType::INT:    return element.get<int>();
+        case BaseDataType::DOUBLE: return element.get<double>();
+        default: throw InvalidTypeException("List does not only hold numbers");
+    }
+}
+
+} // namespace
+
+double sum(const List& list) {
+    switch ( list.element_type() ) {
+        case BaseDataType::INT:    return static_cast<double>(sum(list.ints()));
+        case BaseDataType::DOUBLE: return sum(list.doubles());
+        default: break;
+    }
+    double total = 0;
+    for ( size_t i = 0; i < list.size(); i++ ) total += number_at(list, i);
+    return total;
+}
+
+double mean(const List& list) {
+    if ( list.empty() ) throw InvalidValueException("No values");
+    return sum(list) / static_cast<double>(list.size());
+}
+
+MinMax<double> minmax(const List& list) {
+    if ( list.element_type() == BaseDataType::INT ) {
+        MinMax<int> result = minmax(list.ints());
+        return { static_cast<double>(result.min), static_cast<double>(result.max) };
+    }
+    if ( list.element_type() == BaseDataType::DOUBLE ) return minmax(list.doubles());
+
+    if ( list.empty() ) throw InvalidValueException("No values");
+    MinMax<double> result{ number_at(list, 0), number_at(list, 0) };
+    for ( size_t i = 1; i < list.size(); i++ ) {
+        double value = number_at(list, i);
+        result.min = std::min(result.min, value);
+        result.max = std::max(result.max, value);
+    }
+    return result;
+}
+
+size_t count_if(const List& list, Compare compare, double threshold) {
+    if ( list.element_type() == BaseDataType::DOUBLE ) return count_if(list.doubles(), compare, threshold);
+
+    if ( list.element_type() == BaseDataType::INT ) {
+        // integral thresholds compare exactly as int, anything else goes through double
+        if ( threshold >= std::numeric_limits<int>::min() && threshold <= std::numeric_limits<int>::max()
+             && threshold == static_cast<double>(static_cast<int>(threshold)) )
+            return count_if(list.ints(), compare, static_cast<int>(threshold));
+
+        size_t matches = 0;
+        for ( int value : list.ints() ) matches += numeric::compare(static_cast<double>(value), compare, threshold);
+        return matches;
+    }
+
+    size_t matches = 0;
+    for ( size_t i = 0; i < list.size(); i++ ) matches += numeric::compare(number_at(list, i), compare, threshold);
+    return matches;
+}
+
+void scale(List& list, double factor) {
+    list.convert_to_doubles();
+    scale(list.doubles(), factor);
+}
+
+} // namespace JSONJay::numeric
@@ -1,38 +1,62 @@
 #include "Object.hpp"
 #include "List.hpp"
+#include "BinaryReader.hpp"
+#include "BinaryWriter.hpp"
 
 namespace JSONJay {
 
+Object::Object(const allocator_type& allocator) : mData(allocator) {}
+
+Object::Object(Object&& other, const allocator_type& allocator) : mData(std::move(other.mData), allocator) {}
+
 Object::~Object() {
-    for ( auto& [key, element] : mData ) {
-        if ( std::holds_alternative<Object*>(element) ) delete std::get<Object*>(element);
-        if ( std::holds_alternative<List*>(element) ) delete std::get<List*>(element);
-    }
+    for ( auto& member : mData ) member.value.destroy(get_allocator());
 }
 
 
-bool Object::check_key_valid(const std::string& key, bool bThrow) const {
+Object::data_t& Object::element_at(std::string_view key) {
+    MemberStore::Member* member = mData.find(key);
+    if ( member == nullptr ) throw InvalidKeyException("Key does not exist");
+    return member->value;
+}
+
+Object::data_t& Object::element_at(const Key& key) {
+    MemberStore::Member* member = mData.find(key.name(), key.hash());
+    if ( member == nullptr ) throw InvalidKeyException("Key does not exist");
+    return member->value;
+}
+
+
+std::pair<MemberStore::Member*, bool> Object::find_or_insert(const Key& key) {
+    return mData.try_emplace(key.name(), key.hash());
+}
+
+bool Object::check_key_valid(std::string_view key, bool bThrow) const {
     if ( bThrow ) {
         if ( check_key_valid(key, false) ) return true;
         throw InvalidKeyException("Invalid key");
     }
 
     if ( key.empty() ) return false;
-    if ( key.find_first_of(" \t\n") != std::string::npos ) return false;
+    if ( key.find_first_of(" \t\n") != std::string_view::npos ) return false;
     return true;
 }
 
-bool Object::check_key_exists(const std::string& key, bool bThrow, bool bThrowCollision) const {
+bool Object::check_key_exists(std::string_view key, bool bThrow, bool bThrowCollision) const {
     if ( bThrow ) {
         bool check = check_key_exists(key);
         if ( check == bThrowCollision )
             throw InvalidKeyException(bThrowCollision?"Key already exists":"Key does not exist");
         return check;
     }
-    return mData.find(key) != mData.end();
+    return mData.find(key) != nullptr;
 }
 
 
+Object::allocator_type Object::get_allocator() const {
+    return mData.get_allocator();
+}
+
 bool Object::empty() const {
     return mData.empty();
 }
@@ -41,35 +65,92 @@ size_t Object::size() const {
     return mData.size();
 }
 
-void Object::erase(const std::string& key) {
-    check_key_exists(key, true);
-    if ( std::holds_alternative<Object*>(mData[key]) ) delete std::get<Object*>(mData[key]);
-    if ( std::holds_alternative<List*>(mData[key]) ) delete std::get<List*>(mData[key]);
-    mData.erase(key);
+Object::data_t* Object::find(std::string_view key) noexcept {
+    MemberStore::Member* member = mData.find(key);
+    return member == nullptr ? nullptr : &member->value;
+}
+
+const Object::data_t* Object::find(std::string_view key) const noexcept {
+    const MemberStore::Member* member = mData.find(key);
+    return member == nullptr ? nullptr : &member->value;
+}
+
+Object::data_t* Object::find(const Key& key) noexcept {
+    MemberStore::Member* member = mData.find(key.name(), key.hash());
+    return member == nullptr ? nullptr : &member->value;
+}
+
+void Object::erase(std::string_view key) {
+    MemberStore::Member* member = mData.find(key);
+    if ( member == nullptr ) throw InvalidKeyException("Key does not exist");
+    member->value.destroy(get_allocator());
+    mData.erase(member);
+}
+
+void Object::set(std::string_view key, std::string_view value) {
+    set(Key(key), value);
+}
+
+void Object::set(const Key& key, std::string_view value) {
+    auto [member, inserted] = find_or_insert(key);
+    if ( !inserted && !member->value.holds<std::string>() ) throw InvalidTypeException("Invalid type");
+    store(member, inserted, [&] { return data_t(value, get_allocator()); });
 }
 
-std::string& Object::get_string(const std::string& key) {
+std::string_view Object::get_string(std::string_view key) {
     return at<std::string>(key);
 }
 
-int& Object::get_int(const std::string& key) {
+std::string_view Object::get_string(const Key& key) {
+    return at<std::string>(key);
+}
+
+int& Object::get_int(std::string_view key) {
+    return at<int>(key);
+}
+
+int& Object::get_int(const Key& key) {
     return at<int>(key);
 }
 
-double& Object::get_double(const std::string& key) {
+double& Object::get_double(std::string_view key) {
     return at<double>(key);
 }
 
-bool& Object::get_bool(const std::string& key) {
+double& Object::get_double(const Key& key) {
+    return at<double>(key);
+}
+
+bool& Object::get_bool(std::string_view key) {
+    return at<bool>(key);
+}
+
+bool& Object::get_bool(const Key& key) {
     return at<bool>(key);
 }
 
-Object& Object::get_object(const std::string& key) {
+Object& Object::get_object(std::string_view key) {
+    return *at<Object*>(key);
+}
+
+Object& Object::get_object(const Key& key) {
     return *at<Object*>(key);
 }
 
-List& Object::get_list(const std::string& key) {
+List& Object::get_list(std::string_view key) {
     return *at<List*>(key);
 }
 
+List& Object::get_list(const Key& key) {
+    return *at<List*>(key);
+}
+
+void Object::serialize(StreamWritinator* writer, const Object& object) {
+    BinaryWriter().write(*writer, object);
+}
+
+void Object::deserialize(StreamReadinator* reader, Object& object) {
+    BinaryReader().read(*reader, object);
+}
+
 }; // namespace JSONJay
\ No newline at end of file
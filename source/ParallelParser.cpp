@@ -0,0 +1,69 @@
+#include "ParallelParser.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+
+namespace JSONJay {
+
+ParallelParser::ParallelParser(size_t threads, size_t minParallelSize)
+    : mPool(threads), mMinParallelSize(minParallelSize), mParsers(mPool.size()) {}
+
+Isa ParallelParser::set_isa(Isa isa) noexcept {
+    Isa previous = mIsa;
+    mIsa = std::min(isa, detected_isa());
+    mParser.set_isa(mIsa);
+    return previous;
+}
+
+Document ParallelParser::parse(std::string_view text, std::pmr::memory_resource* upstream) {
+    if ( text.size() < mMinParallelSize ) return mParser.parse(text, upstream);
+
+    mIndex.build(text, mPool, mIsa);
+    std::span<const uint32_t> positions = mIndex.positions();
+    if ( positions.empty() || text[positions[0]] != '[' ) return mParser.parse_indexed(text, positions, upstream);
+
+    // find the commas between the elements of the root List
+    std::vector<size_t> commas;
+    size_t depth = 0;
+    size_t close = 0;
+    for ( size_t i = 0; i < positions.size() && close == 0; i++ ) {
+        switch ( text[positions[i]] ) {
+            case '{': case '[': depth++; break;
+            case '}': case ']': if ( --depth == 0 ) close = i; break;
+            case ',': if ( depth == 1 ) commas.push_back(i); break;
+            default: break;
+        }
+    }
+    if ( close == 0 ) throw InvalidFormatException("Unexpected end of JSON text");
+    if ( text[positions[close]] != ']' ) throw InvalidFormatException("Expected ',' or ']'");
+    if ( close + 1 != positions.size() ) throw InvalidFormatException("Unexpected characters after the JSON value");
+
+    Document document(BaseDataType::LIST, Document::kDefaultBlockSize, upstream);
+    if ( close == 1 ) return document;
+
+    // runs of whole elements, a few per worker to even out their sizes
+    size_t elements = commas.size() + 1;
+    size_t runCount = std::min(elements, mPool.size() * 4);
+    std::vector<Document> runs;
+    runs.reserve(runCount);
+    for ( size_t run = 0; run < runCount; run++ ) {
+        size_t first = elements * run / runCount;
+        size_t last = elements * (run + 1) / runCount;
+        size_t begin = first == 0 ? 1 : commas[first - 1] + 1;
+        size_t end = last == elements ? close : commas[last - 1];
+        size_t bytes = positions[end] - positions[begin];
+
+        runs.emplace_back(BaseDataType::LIST, std::max(Document::kDefaultBlockSize, bytes), upstream);
+        List& list = runs.back().list();
+        std::span<const uint32_t> slice = positions.subspan(begin, end - begin);
+        mPool.submit([this, text, slice, &list](size_t worker) {
+            mParsers[worker].parse_elements(text, slice, list);
+        });
+    }
+    mPool.wait();
+
+    for ( Document& run : runs ) document.append(std::move(run));
+    return document;
+}
+
+} // namespace JSONJay
@@ -0,0 +1,183 @@
+#include "SaxParser.hpp"
+#include "Exceptions.hpp"
+#include "JSONText.hpp"
+
+namespace JSONJay {
+
+SaxParser::SaxParser(size_t chunkSize) : mChunk(chunkSize == 0 ? 1 : chunkSize) {}
+
+void SaxParser::start(StreamReadinator& reader) {
+    mReader = &reader;
+    mPosition = 0;
+    mEnd = 0;
+    mEndOfStream = false;
+    mState = State::VALUE;
+    mStack.clear();
+}
+
+bool SaxParser::refill() {
+    if ( mEndOfStream ) return false;
+    mPosition = 0;
+    mEnd = static_cast<size_t>(mReader->readSome(mChunk.data(), mChunk.size()));
+    if ( mEnd == 0 ) mEndOfStream = true;
+    return mEnd != 0;
+}
+
+int SaxParser::next_char() {
+    while ( true ) {
+        while ( mPosition < mEnd ) {
+            char c = mChunk[mPosition++];
+            if ( !is_json_whitespace(c) ) return static_cast<unsigned char>(c);
+        }
+        if ( !refill() ) return -1;
+    }
+}
+
+void SaxParser::read_string() {
+    // the opening quote is consumed already
+    mToken.clear();
+    bool escaped = false;
+    size_t begin = mPosition;
+
+    while ( true ) {
+        while ( mPosition < mEnd ) {
+            unsigned char c = static_cast<unsigned char>(mChunk[mPosition]);
+            if ( c == '"' ) {
+                if ( !escaped && mToken.empty() ) {
+                    // the whole string is in the chunk, hand it out in place
+                    mText = std::string_view(mChunk.data() + begin, mPosition - begin);
+                    mPosition++;
+                    return;
+                }
+                mToken.append(mChunk.data() + begin, mPosition - begin);
+                mPosition++;
+                if ( escaped ) {
+                    unescape_json(mToken, mString);
+                    mText = mString;
+                } else {
+                    mText = mToken;
+                }
+                return;
+            }
+            if ( c < 0x20 ) throw InvalidFormatException("Control character in string");
+            mPosition++;
+
+            if ( c == '\\' ) {
+                // keep the escape as it is, the character after the backslash
+                // never ends the string
+                escaped = true;
+                mToken.append(mChunk.data() + begin, mPosition - begin);
+                if ( mPosition == mEnd && !refill() ) throw InvalidFormatException("Unterminated string");
+                char next = mChunk[mPosition++];
+                if ( static_cast<unsigned char>(next) < 0x20 ) throw InvalidFormatException("Control character in string");
+                mToken.push_back(next);
+                begin = mPosition;
+            }
+        }
+        mToken.append(mChunk.data() + begin, mPosition - begin);
+        if ( !refill() ) throw InvalidFormatException("Unterminated string");
+        begin = 0;
+    }
+}
+
+SaxParser::Token SaxParser::read_scalar(char first) {
+    mToken.assign(1, first);
+    while ( true ) {
+        size_t begin = mPosition;
+        while ( mPosition < mEnd && !is_json_delimiter(mChunk[mPosition]) ) mPosition++;
+        mToken.append(mChunk.data() + begin, mPosition - begin);
+        if ( mPosition < mEnd || !refill() ) break;
+    }
+
+    JSONScalar scalar = parse_json_scalar(mToken);
+    after_value();
+    switch ( scalar.type ) {
+        case BaseDataType::INT:    mInt = scalar.i; return Token::INT;
+        case BaseDataType::DOUBLE: mDouble = scalar.d; return Token::DOUBLE;
+        case BaseDataType::BOOL:   mBool = scalar.b; return Token::BOOL;
+        default:                   return Token::NONE;
+    }
+}
+
+SaxParser::Token SaxParser::read_value(int c) {
+    switch ( c ) {
+        case -1:
+            throw InvalidFormatException("Unexpected end of JSON text");
+        case '{':
+            return open(true);
+        case '[':
+            return open(false);
+        case '"':
+            read_string();
+            after_value();
+            return Token::STRING;
+        case '}':
+        case ']':
+        case ':':
+        case ',':
+            throw InvalidFormatException("Expected a value");
+        default:
+            return read_scalar(static_cast<char>(c));
+    }
+}
+
+SaxParser::Token SaxParser::open(bool object) {
+    if ( mStack.size() >= kMaxDepth ) throw InvalidFormatException("JSON nesting too deep");
+    mStack.push_back(object);
+    mState = object ? State::FIRST_KEY : State::FIRST_ELEMENT;
+    return object ? Token::START_OBJECT : Token::START_LIST;
+}
+
+SaxParser::Token SaxParser::close(char c) {
+    bool object = mStack.back();
+    if ( c != (object ? '}' : ']') ) throw InvalidFormatException("Mismatched closing bracket");
+    mStack.pop_back();
+    after_value();
+    return object ? Token::END_OBJECT : Token::END_LIST;
+}
+
+void SaxParser::after_value() noexcept {
+    mState = mStack.empty() ? State::DONE : State::NEXT;
+}
+
+SaxParser::Token SaxParser::next() {
+    while ( true ) {
+        int c = next_char();
+        switch ( mState ) {
+            case State::FIRST_ELEMENT:
+                if ( c == ']' ) return close(']');
+                [[fallthrough]];
+            case State::VALUE:
+                return read_value(c);
+
+            case State::FIRST_KEY:
+                if ( c == '}' ) return close('}');
+                [[fallthrough]];
+            case State::KEY:
+                if ( c != '"' ) throw InvalidFormatException("Expected a key");
+                read_string();
+                mState = State::COLON;
+                return Token::KEY;
+
+            case State::COLON:
+                if ( c != ':' ) throw InvalidFormatException("Expected ':'");
+                mState = State::VALUE;
+                break;
+
+            case State::NEXT:
+                if ( c == ',' ) {
+                    mState = mStack.back() ? State::KEY : State::VALUE;
+                    break;
+                }
+                if ( c == '}' || c == ']' ) return close(static_cast<char>(c));
+                if ( c == -1 ) throw InvalidFormatException("Unexpected end of JSON text");
+                throw InvalidFormatException("Expected ',' or a closing bracket");
+
+            case State::DONE:
+                if ( c != -1 ) throw InvalidFormatException("Unexpected characters after the JSON value");
+                return Token::END;
+        }
+    }
+}
+
+} // namespace JSONJay
@@ -0,0 +1,29 @@
+/**
+ * @file Simd.hpp
+ * @author TL044CN
+ * @brief private helpers of the SIMD kernels
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define JSONJAY_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define JSONJAY_SIMD_X86 0
+#endif
+
+// AVX2 kernels are compiled with a target attribute, so the library itself
+// can still be built for the x86-64 baseline and pick them at runtime.
+#if JSONJAY_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define JSONJAY_TARGET_AVX2 __attribute__((target("avx2")))
+#define JSONJAY_HAS_AVX2 1
+#else
+#define JSONJAY_TARGET_AVX2
+#define JSONJAY_HAS_AVX2 0
+#endif
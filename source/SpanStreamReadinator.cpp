@@ -0,0 +1,73 @@
+#include "SpanStreamReadinator.hpp"
+#include "DelimiterSearch.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace JSONJay {
+
+bool SpanStreamReadinator::isStreamGood() const {
+    return mPosition < mData.size();
+}
+
+uint64_t SpanStreamReadinator::getStreamPosition() {
+    return mPosition;
+}
+
+void SpanStreamReadinator::setStreamPosition(uint64_t position) {
+    mPosition = position;
+}
+
+uint64_t SpanStreamReadinator::readSome(char* data, uint64_t size) {
+    if ( mPosition >= mData.size() ) return 0;
+    uint64_t count = std::min<uint64_t>(size, mData.size() - mPosition);
+    std::memcpy(data, mData.data() + mPosition, count);
+    mPosition += count;
+    return count;
+}
+
+bool SpanStreamReadinator::readSpan(std::span<const char>& span, uint64_t size) {
+    if ( mPosition > mData.size() || size > mData.size() - mPosition ) return false;
+    span = mData.subspan(mPosition, size);
+    mPosition += size;
+    return true;
+}
+
+bool SpanStreamReadinator::readStringView(std::string_view& str) {
+    // the same layout as readString
+    uint64_t start = mPosition;
+    size_t size;
+    std::span<const char> bytes;
+    if ( !readRaw(size) || !readSpan(bytes, size) ) {
+        mPosition = start;
+        return false;
+    }
+    str = std::string_view(bytes.data(), bytes.size());
+    return true;
+}
+
+bool SpanStreamReadinator::readUntil(std::vector<char>& data, char delim) {
+    std::string_view view;
+    bool found = readViewUntil(view, std::string_view(&delim, 1));
+    data.insert(data.end(), view.begin(), view.end());
+    return found;
+}
+
+bool SpanStreamReadinator::readUntil(std::vector<char>& data, std::string delim) {
+    std::string_view view;
+    bool found = readViewUntil(view, delim);
+    data.insert(data.end(), view.begin(), view.end());
+    return found;
+}
+
+bool SpanStreamReadinator::readViewUntil(std::string_view& view, std::string_view delim) {
+    std::string_view rest;
+    if ( mPosition < mData.size() ) rest = std::string_view(mData.data() + mPosition, mData.size() - mPosition);
+    size_t at = find_delimiter(rest, delim);
+    bool found = at != std::string_view::npos;
+    view = rest.substr(0, found ? at + delim.size() : rest.size());
+    mPosition += view.size();
+    return found;
+}
+
+} // namespace JSONJay
@@ -2,6 +2,21 @@
 
 namespace JSONJay {
 
+uint64_t StreamReadinator::readSome(char* data, uint64_t size) {
+    uint64_t count = 0;
+    while ( count < size && readData(data + count, 1) ) count++;
+    return count;
+}
+
+bool StreamReadinator::readVarint(uint64_t& value) {
+    char bytes[kMaxVarintSize];
+    for ( size_t i = 0; i < kMaxVarintSize; i++ ) {
+        if ( !readData(bytes + i, 1) ) return false;
+        if ( (bytes[i] & 0x80) == 0 ) return decode_varint(bytes, i + 1, value) != 0;
+    }
+    return false;
+}
+
 bool StreamReadinator::readUntil(std::vector<char>& data, char delim) {
     char c;
     while (readData(&c, 1)) {
@@ -14,34 +29,23 @@ bool StreamReadinator::readUntil(std::vector<char>& data, char delim) {
 }
 
 bool StreamReadinator::readUntil(std::vector<char>& data, std::string delim) {
-    std::vector<char> buffer(delim.size());
-    while (readData(buffer.data(), buffer.size())) {
-        data.insert(data.end(), buffer.begin(), buffer.end());
-        if (data.size() >= delim.size()) {
-            if (std::equal(delim.begin(), delim.end(), data.end() - delim.size())) {
-                return true;
-            }
-        }
+    if (delim.empty()) {
+        return true;
     }
-    return false;
-}
 
-bool StreamReadinator::readBuffer(std::vector<char>& buffer, uint32_t size) {
-    uint32_t bufferSize = size;
-    if (bufferSize == 0) {
-        readData(reinterpret_cast<char*>(&bufferSize), sizeof(bufferSize));
+    // byte by byte, so a delimiter is found wherever it starts
+    size_t start = data.size();
+    char c;
+    while (readData(&c, 1)) {
+        data.push_back(c);
+        if (data.size() - start >= delim.size() &&
+            std::equal(delim.begin(), delim.end(), data.end() - delim.size())) {
+            return true;
+        }
     }
-    buffer.resize(bufferSize);
-    return readData(buffer.data(), buffer.size());
+    return false;
 }
 
-bool StreamReadinator::readString(std::string& str) {
-    size_t size;
-    if(!readData(reinterpret_cast<char*>(&size), sizeof(size))) 
-        return false;
-
-    str.resize(size);
-    return readData(str.data(), str.size());
-}
+template class ReadinatorHelpers<StreamReadinator>;
 
 } // namespace JSONJay
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include "StructuralIndex.hpp"
+#include "Exceptions.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace JSONJay {
+
+namespace {
+
+constexpr size_t kBlockSize = 64;
+
+/**
+ * @brief one bit per byte of a block for each class of characters
+ */
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t whitespace;
+    uint64_t op;
+    uint64_t control;
+};
+
+using classify_t = void (*)(const uint8_t*, BlockMasks&);
+
+void classify_scalar(const uint8_t* block, BlockMasks& masks) {
+    masks = BlockMasks{};
+    for ( size_t i = 0; i < kBlockSize; i++ ) {
+        uint64_t bit = uint64_t(1) << i;
+        switch ( block[i] ) {
+            case '"':  masks.quote |= bit; break;
+            case '\\': masks.backslash |= bit; break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r': masks.whitespace |= bit; break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':  masks.op |= bit; break;
+            default: break;
+        }
+        if ( block[i] < 0x20 ) masks.control |= bit;
+    }
+}
+
+#if JSONJAY_SIMD_X86
+
+void classify_sse2(const uint8_t* block, BlockMasks& masks) {
+    masks = BlockMasks{};
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i lastControl = _mm_set1_epi8(0x1F);
+    for ( size_t offset = 0; offset < kBlockSize; offset += 16 ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + offset));
+        // [ and ] become { and } when the case bit is set
+        __m128i folded = _mm_or_si128(v, caseBit);
+        __m128i whitespace = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+        __m128i op = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+        __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(v, lastControl), lastControl);
+
+        auto bits = [](__m128i mask) { return uint64_t(uint32_t(_mm_movemask_epi8(mask))); };
+        masks.quote |= bits(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << offset;
+        masks.backslash |= bits(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << offset;
+        masks.whitespace |= bits(whitespace) << offset;
+        masks.op |= bits(op) << offset;
+        masks.control |= bits(control) << offset;
+    }
+}
+
+#endif
+
+#if JSONJAY_HAS_AVX2
+
+JSONJAY_TARGET_AVX2 inline uint64_t bits_avx2(__m256i mask) {
+    return uint64_t(uint32_t(_mm256_movemask_epi8(mask)));
+}
+
+JSONJAY_TARGET_AVX2 void classify_avx2(const uint8_t* block, BlockMasks& masks) {
+    masks = BlockMasks{};
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+    const __m256i lastControl = _mm256_set1_epi8(0x1F);
+    for ( size_t offset = 0; offset < kBlockSize; offset += 32 ) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + offset));
+        __m256i folded = _mm256_or_si256(v, caseBit);
+        __m256i whitespace = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+        __m256i op = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+        __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(v, lastControl), lastControl);
+
+        masks.quote |= bits_avx2(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))) << offset;
+        masks.backslash |= bits_avx2(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))) << offset;
+        masks.whitespace |= bits_avx2(whitespace) << offset;
+        masks.op |= bits_avx2(op) << offset;
+        masks.control |= bits_avx2(control) << offset;
+    }
+}
+
+#endif
+
+classify_t classifier_for(Isa isa) noexcept {
+    switch ( isa ) {
+#if JSONJAY_HAS_AVX2
+        case Isa::AVX2: return classify_avx2;
+#endif
+#if JSONJAY_SIMD_X86
+        case Isa::SSE2: return classify_sse2;
+#endif
+        default: return classify_scalar;
+    }
+}
+
+/**
+ * @brief xor of all lower bits, turns quote bits into string ranges
+ */
+uint64_t prefix_xor(uint64_t bits) noexcept {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+/**
+ * @brief the state carried from one block to the next
+ */
+struct Scanner {
+    uint64_t prevEscaped = 0;      ///< the first byte of the block is escaped
+    uint64_t prevInString = 0;     ///< all ones if the block starts inside a string
+    uint64_t prevScalar = 0;       ///< the last byte of the block was part of a scalar
+    uint64_t control = 0;          ///< control characters found inside strings
+
+    /**
+     * @brief find the characters escaped by a backslash
+     * @details Runs of backslashes escape every second backslash and the
+     *          character after an odd run. Adding the run starts on odd bits
+     *          to the runs carries through each run and leaves a marker behind
+     *          those of odd length.
+     */
+    uint64_t escaped(uint64_t backslash) noexcept {
+        constexpr uint64_t kEvenBits = 0x5555555555555555ull;
+
+        backslash &= ~prevEscaped;
+        uint64_t followsEscape = backslash << 1 | prevEscaped;
+        uint64_t oddStarts = backslash & ~kEvenBits & ~followsEscape;
+        uint64_t evenSequences = oddStarts + backslash;
+        prevEscaped = evenSequences < oddStarts;
+        uint64_t invert = evenSequences << 1;
+        return (kEvenBits ^ invert) & followsEscape;
+    }
+
+    /**
+     * @brief find the structural characters of a block
+     * @details Control characters inside strings are collected in control
+     *          instead of thrown right away, so the string state at the end
+     *          of a range is known even for invalid text.
+     */
+    uint64_t structurals(const BlockMasks& masks) {
+        uint64_t quote = masks.quote & ~escaped(masks.backslash);
+        uint64_t inString = prefix_xor(quote) ^ prevInString;
+        prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+        control |= masks.control & inString;
+
+        uint64_t scalar = ~(masks.whitespace | masks.op | masks.quote) & ~inString;
+        uint64_t followsScalar = scalar << 1 | prevScalar;
+        prevScalar = scalar >> 63;
+
+        return (masks.op & ~inString) | quote | (scalar & ~followsScalar);
+    }
+};
+
+void append(std::vector<uint32_t>& positions, uint64_t bits, uint32_t base) {
+    size_t count = static_cast<size_t>(std::popcount(bits));
+    size_t at = positions.size();
+    positions.resize(at + count);
+    uint32_t* out = positions.data() + at;
+    while ( bits != 0 ) {
+        *out++ = base + static_cast<uint32_t>(std::countr_zero(bits));
+        bits &= bits - 1;
+    }
+}
+
+/**
+ * @brief index the blocks of a range of the text
+ * @details The range starts on a block boundary, only the last block of the
+ *          text may be partial.
+ */
+void scan(std::string_view text, size_t begin, size_t end, classify_t classify, Scanner& scanner,
+    std::vector<uint32_t>& positions) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+    BlockMasks masks;
+
+    size_t offset = begin;
+    for ( ; offset + kBlockSize <= end; offset += kBlockSize ) {
+        classify(data + offset, masks);
+        append(positions, scanner.structurals(masks), static_cast<uint32_t>(offset));
+    }
+
+    if ( offset < end ) {
+        // pad the last block with whitespace
+        uint8_t block[kBlockSize];
+        std::memset(block, ' ', kBlockSize);
+        std::memcpy(block, data + offset, end - offset);
+        classify(block, masks);
+        append(positions, scanner.structurals(masks), static_cast<uint32_t>(offset));
+    }
+}
+
+/**
+ * @brief whether a character belongs to a number or literal
+ */
+bool is_scalar_char(char c) noexcept {
+    switch ( c ) {
+        case ' ': case '\t': case '\n': case '\r':
+        case '{': case '}': case '[': case ']':
+        case ':': case ',': case '"':
+            return false;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief one chunk of a text indexed on its own
+ */
+struct Chunk {
+    size_t begin;
+    size_t end;
+    Scanner start;                  ///< the guessed state at the start
+    uint64_t endInString = 0;       ///< the string state at the end, given the guess
+    uint64_t control = 0;           ///< control characters in strings, given the guess
+    std::vector<uint32_t> positions;
+
+    void run(std::string_view text, classify_t classify) {
+        positions.clear();
+        Scanner scanner = start;
+        scan(text, begin, end, classify, scanner, positions);
+        endInString = scanner.prevInString;
+        control = scanner.control;
+    }
+};
+
+} // namespace
+
+
+void StructuralIndex::build(std::string_view text, Isa isa) {
+    if ( text.size() >= std::numeric_limits<uint32_t>::max() ) throw InvalidFormatException("JSON text too large");
+
+    mPositions.clear();
+    // a JSON text is seldom denser than one structural character in four bytes
+    mPositions.reserve(text.size() / 4 + 16);
+
+    Scanner scanner;
+    scan(text, 0, text.size(), classifier_for(std::min(isa, detected_isa())), scanner, mPositions);
+    if ( scanner.control ) throw InvalidFormatException("Control character in string");
+    if ( scanner.prevInString ) throw InvalidFormatException("Unterminated string");
+}
+
+void StructuralIndex::build(std::string_view text, ThreadPool& pool, Isa isa) {
+    size_t chunkCount = std::min(pool.size() * 4, text.size() / kMinChunkSize);
+    if ( chunkCount < 2 ) return build(text, isa);
+    if ( text.size() >= std::numeric_limits<uint32_t>::max() ) throw InvalidFormatException("JSON text too large");
+
+    classify_t classify = classifier_for(std::min(isa, detected_isa()));
+    size_t chunkSize = (text.size() / chunkCount + kBlockSize - 1) / kBlockSize * kBlockSize;
+    std::vector<Chunk> chunks;
+    for ( size_t begin = 0; begin < text.size(); begin += chunkSize ) {
+        Chunk chunk{ begin, std::min(begin + chunkSize, text.size()), Scanner(), 0, 0, {} };
+
+        // escapes and scalars at the boundary can be read off the text,
+        // the chunk is guessed to start outside of a string
+        size_t backslashes = 0;
+        while ( backslashes < begin && text[begin - 1 - backslashes] == '\\' ) backslashes++;
+        chunk.start.prevEscaped = backslashes % 2;
+        chunk.start.prevScalar = begin > 0 && is_scalar_char(text[begin - 1]);
+        chunks.push_back(std::move(chunk));
+    }
+
+    for ( Chunk& chunk : chunks ) pool.submit([&chunk, text, classify](size_t) { chunk.run(text, classify); });
+    pool.wait();
+
+    // check the guesses, the quotes of a chunk do not depend on them, so a
+    // wrong guess only inverts the string state of the whole chunk
+    uint64_t inString = 0;
+    std::vector<Chunk*> wrong;
+    for ( Chunk& chunk : chunks ) {
+        if ( inString ) {
+            chunk.start.prevInString = inString;
+            chunk.start.prevScalar = 0;
+            wrong.push_back(&chunk);
+        }
+        inString ^= chunk.endInString;
+    }
+    if ( !wrong.empty() ) {
+        for ( Chunk* chunk : wrong ) pool.submit([chunk, text, classify](size_t) { chunk->run(text, classify); });
+        pool.wait();
+    }
+
+    size_t total = 0;
+    for ( Chunk& chunk : chunks ) {
+        if ( chunk.control ) throw InvalidFormatException("Control character in string");
+        total += chunk.positions.size();
+    }
+    if ( inString ) throw InvalidFormatException("Unterminated string");
+
+    mPositions.resize(total);
+    uint32_t* out = mPositions.data();
+    for ( Chunk& chunk : chunks ) {
+        std::memcpy(out, chunk.positions.data(), chunk.positions.size() * sizeof(uint32_t));
+        out += chunk.positions.size();
+    }
+}
+
+} // namespace JSONJay
@@ -0,0 +1,104 @@
+#include "ThreadPool.hpp"
+
+#include <utility>
+
+namespace JSONJay {
+
+namespace {
+
+// the pool and worker index of the current thread, for submissions from tasks
+thread_local const ThreadPool* tCurrentPool = nullptr;
+thread_local size_t tCurrentWorker = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+    if ( threads == 0 ) threads = 1;
+    for ( size_t i = 0; i < threads; i++ ) mQueues.push_back(std::make_unique<Queue>());
+    for ( size_t i = 0; i < threads; i++ ) mThreads.emplace_back([this, i] { run(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    for ( std::thread& thread : mThreads ) thread.join();
+}
+
+bool ThreadPool::take(size_t worker, task_t& task) {
+    for ( size_t i = 0; i < mQueues.size(); i++ ) {
+        Queue& queue = *mQueues[(worker + i) % mQueues.size()];
+        std::lock_guard lock(queue.mutex);
+        if ( queue.tasks.empty() ) continue;
+        // own work newest first for locality, stolen work oldest first
+        if ( i == 0 ) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run(size_t worker) {
+    tCurrentPool = this;
+    tCurrentWorker = worker;
+
+    while ( true ) {
+        task_t task;
+        if ( take(worker, task) ) {
+            {
+                std::lock_guard lock(mMutex);
+                mQueued--;
+            }
+            try {
+                task(worker);
+            } catch ( ... ) {
+                std::lock_guard lock(mMutex);
+                if ( !mError ) mError = std::current_exception();
+            }
+            std::lock_guard lock(mMutex);
+            if ( --mPending == 0 ) mIdle.notify_all();
+            continue;
+        }
+
+        std::unique_lock lock(mMutex);
+        mWake.wait(lock, [this] { return mStop || mQueued > 0; });
+        if ( mStop && mQueued == 0 ) return;
+    }
+}
+
+void ThreadPool::submit(task_t task) {
+    size_t target;
+    if ( tCurrentPool == this ) {
+        target = tCurrentWorker;
+    } else {
+        std::lock_guard lock(mMutex);
+        target = mNextQueue++ % mQueues.size();
+    }
+
+    // count the task first, so it is never finished before it is counted
+    {
+        std::lock_guard lock(mMutex);
+        mQueued++;
+        mPending++;
+    }
+    {
+        std::lock_guard lock(mQueues[target]->mutex);
+        mQueues[target]->tasks.push_back(std::move(task));
+    }
+    mWake.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock(mMutex);
+    mIdle.wait(lock, [this] { return mPending == 0; });
+    if ( mError ) std::rethrow_exception(std::exchange(mError, nullptr));
+}
+
+} // namespace JSONJay
@@ -0,0 +1,70 @@
+#include "Value.hpp"
+#include "Object.hpp"
+#include "List.hpp"
+
+#include <limits>
+
+namespace JSONJay {
+
+Value::Value(std::string_view value, const node_allocator_t& allocator) : mScalar() {
+    if ( value.size() <= kInlineCapacity ) {
+        mInline = InlineString();
+        mInline.type = BaseDataType::STRING;
+        mInline.size = static_cast<uint8_t>(value.size());
+        std::memcpy(mInline.data, value.data(), value.size());
+        return;
+    }
+
+    if ( value.size() > std::numeric_limits<uint32_t>::max() )
+        throw InvalidValueException("String too long");
+
+    node_allocator_t stringAllocator = allocator;
+    char* data = static_cast<char*>(stringAllocator.allocate_bytes(value.size(), alignof(char)));
+    std::memcpy(data, value.data(), value.size());
+
+    mHeap = HeapString();
+    mHeap.type = BaseDataType::STRING;
+    mHeap.size = kHeapString;
+    mHeap.length = static_cast<uint32_t>(value.size());
+    mHeap.data = data;
+}
+
+void Value::destroy(const node_allocator_t& allocator) noexcept {
+    node_allocator_t nodeAllocator = allocator;
+    switch ( type() ) {
+        case BaseDataType::STRING:
+            if ( mScalar.size == kHeapString )
+                nodeAllocator.deallocate_bytes(mHeap.data, mHeap.length, alignof(char));
+            break;
+        case BaseDataType::OBJECT:
+            delete_node(nodeAllocator, mScalar.object);
+            break;
+        case BaseDataType::LIST:
+            delete_node(nodeAllocator, mScalar.list);
+            break;
+        default:
+            break;
+    }
+    *this = Value();
+}
+
+Value Value::relocate(const node_allocator_t& from, const node_allocator_t& to) {
+    Value result = *this;
+    switch ( type() ) {
+        case BaseDataType::STRING:
+            result = Value(as_string(), to);
+            break;
+        case BaseDataType::OBJECT:
+            result = Value(new_node<Object>(to, std::move(*mScalar.object)));
+            break;
+        case BaseDataType::LIST:
+            result = Value(new_node<List>(to, std::move(*mScalar.list)));
+            break;
+        default:
+            break;
+    }
+    destroy(from);
+    return result;
+}
+
+} // namespace JSONJay
@@ -0,0 +1,45 @@
+/**
+ * @file AllocationCounter.hpp
+ * @author TL044CN
+ * @brief counts global heap allocations made by the tests
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace test {
+
+/**
+ * @brief Get the number of global operator new calls since program start
+ *
+ * @return size_t the number of allocations
+ */
+size_t allocation_count() noexcept;
+
+/**
+ * @brief counts the global allocations made during its lifetime
+ */
+class AllocationCounter {
+private:
+    size_t mStart;
+
+public:
+    AllocationCounter() noexcept : mStart(allocation_count()) {}
+
+    /**
+     * @brief Get the number of allocations since construction
+     *
+     * @return size_t the number of allocations
+     */
+    size_t count() const noexcept {
+        return allocation_count() - mStart;
+    }
+};
+
+} // namespace test
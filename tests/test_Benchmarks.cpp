@@ -0,0 +1,311 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include "Object.hpp"
+#include "List.hpp"
+#include "Numeric.hpp"
+#include "JSONParser.hpp"
+#include "JSONWriter.hpp"
+#include "BinaryWriter.hpp"
+#include "BinaryReader.hpp"
+#include "SaxParser.hpp"
+#include "LazyDocument.hpp"
+#include "ParallelParser.hpp"
+#include "BufferStreamReadinator.hpp"
+#include "BufferStreamWritinator.hpp"
+#include "SpanStreamReadinator.hpp"
+
+#include <string>
+#include <vector>
+
+using JSONJay::Object;
+using JSONJay::List;
+
+// Benchmarks are hidden, run them with: JSONJay_tests "[benchmark]"
+
+TEST_CASE("Lookup of optional members", "[.][benchmark]") {
+    std::vector<Object> records(1000);
+    for ( size_t i = 0; i < records.size(); i++ ) {
+        records[i].set("id", static_cast<int>(i));
+        if ( i % 10 == 0 ) records[i].set("score", 1.5);
+    }
+
+    BENCHMARK("throwing at<T>") {
+        double total = 0;
+        for ( Object& record : records ) {
+            try {
+                total += record.at<double>("score");
+            } catch ( const JSONJay::InvalidKeyException& ) {}
+        }
+        return total;
+    };
+
+    BENCHMARK("get_if<T>") {
+        double total = 0;
+        for ( Object& record : records )
+            if ( double* score = record.get_if<double>("score") ) total += *score;
+        return total;
+    };
+
+    BENCHMARK("try_get<T>") {
+        double total = 0;
+        for ( Object& record : records ) total += record.try_get<double>("score").value_or(0.0);
+        return total;
+    };
+}
+
+TEST_CASE("Lookup of mistyped list elements", "[.][benchmark]") {
+    List list;
+    for ( int i = 0; i < 1000; i++ ) {
+        if ( i % 2 == 0 ) list.push_back(i);
+        else list.push_back(static_cast<double>(i));
+    }
+
+    BENCHMARK("throwing at<T>") {
+        long total = 0;
+        for ( size_t i = 0; i < list.size(); i++ ) {
+            try {
+                total += list.at<int>(i);
+            } catch ( const JSONJay::InvalidTypeException& ) {}
+        }
+        return total;
+    };
+
+    BENCHMARK("get_if<T>") {
+        long total = 0;
+        for ( size_t i = 0; i < list.size(); i++ )
+            if ( int* value = list.get_if<int>(i) ) total += *value;
+        return total;
+    };
+}
+
+TEST_CASE("Summing a list of doubles", "[.][benchmark]") {
+    List list;
+    for ( int i = 0; i < 100000; i++ ) list.push_back(i * 0.5);
+
+    BENCHMARK("at<T>") {
+        double total = 0;
+        for ( size_t i = 0; i < list.size(); i++ ) total += list.at<double>(i);
+        return total;
+    };
+
+    BENCHMARK("doubles()") {
+        double total = 0;
+        for ( double value : list.doubles() ) total += value;
+        return total;
+    };
+
+    BENCHMARK("numeric::sum") {
+        return JSONJay::numeric::sum(list);
+    };
+}
+
+TEST_CASE("Parsing a JSON text", "[.][benchmark]") {
+    std::string text = "[";
+    for ( int i = 0; i < 20000; i++ ) {
+        if ( i != 0 ) text += ",";
+        text += R"({"id":)" + std::to_string(i) + R"(,"name":"element number )" + std::to_string(i)
+            + R"(","score":)" + std::to_string(i * 0.25) + R"(,"flags":[true,false,null]})";
+    }
+    text += "]";
+
+    JSONJay::JSONParser parser;
+    for ( JSONJay::Isa isa : { JSONJay::Isa::SCALAR, JSONJay::Isa::SSE2, JSONJay::Isa::AVX2 } ) {
+        if ( isa > JSONJay::detected_isa() ) continue;
+        parser.set_isa(isa);
+        JSONJay::StructuralIndex index;
+
+        BENCHMARK("structural index, isa " + std::to_string(static_cast<int>(isa))) {
+            index.build(text, isa);
+            return index.size();
+        };
+
+        BENCHMARK("parse, isa " + std::to_string(static_cast<int>(isa))) {
+            return parser.parse(text).list().size();
+        };
+    }
+
+    /**
+     * @brief handler that only counts the events
+     */
+    struct CountingHandler {
+        size_t events = 0;
+
+        void start_object() { events++; }
+        void end_object() { events++; }
+        void start_list() { events++; }
+        void end_list() { events++; }
+        void key(std::string_view) { events++; }
+        void value(std::string_view) { events++; }
+        void value(int) { events++; }
+        void value(double) { events++; }
+        void value(bool) { events++; }
+        void value(std::monostate) { events++; }
+    };
+
+    JSONJay::SaxParser sax;
+    BENCHMARK("SAX events") {
+        JSONJay::BufferStreamReadinator reader(std::vector<char>(text.begin(), text.end()));
+        CountingHandler handler;
+        sax.parse(reader, handler);
+        return handler.events;
+    };
+}
+
+TEST_CASE("Writing a JSON text", "[.][benchmark]") {
+    std::string text = "[";
+    for ( int i = 0; i < 20000; i++ ) {
+        if ( i != 0 ) text += ",";
+        text += R"({"id":)" + std::to_string(i) + R"(,"name":"element \"number\" )" + std::to_string(i)
+            + R"(","score":)" + std::to_string(i * 0.25) + R"(,"flags":[true,false,null]})";
+    }
+    text += "]";
+
+    JSONJay::JSONParser parser;
+    JSONJay::Document document = parser.parse(text);
+
+    for ( JSONJay::JSONStyle style : { JSONJay::JSONStyle::MINIFIED, JSONJay::JSONStyle::PRETTY } ) {
+        JSONJay::JSONWriter writer(style);
+
+        BENCHMARK("write, style " + std::to_string(static_cast<int>(style))) {
+            JSONJay::BufferStreamWritinator stream;
+            writer.write(stream, document);
+            return stream.getBuffer().size();
+        };
+    }
+}
+
+TEST_CASE("Reading a few fields of a wide document", "[.][benchmark]") {
+    std::string text = "{";
+    for ( int i = 0; i < 300; i++ ) {
+        text += R"("field)" + std::to_string(i) + R"(":{"values":[1,2,3,4],"text":"some text of field )"
+            + std::to_string(i) + R"("},)";
+    }
+    text += R"("user":{"id":42,"name":"Jay"}})";
+
+    JSONJay::JSONParser parser;
+
+    BENCHMARK("JSONParser") {
+        JSONJay::Document document = parser.parse(text);
+        return document.object().get_object("user").get_int("id");
+    };
+
+    BENCHMARK("LazyDocument") {
+        JSONJay::LazyDocument document(text);
+        return document["user"]["id"].get_int();
+    };
+}
+
+TEST_CASE("Parsing a huge top-level List", "[.][benchmark]") {
+    std::string text = "[";
+    for ( int i = 0; i < 400000; i++ ) {
+        if ( i > 0 ) text += ",";
+        text += R"({"id":)" + std::to_string(i) + R"(,"name":"item [)" + std::to_string(i) + R"(]","values":[1.5,2,3]})";
+    }
+    text += "]";
+
+    JSONJay::JSONParser parser;
+    JSONJay::ParallelParser parallel;
+
+    BENCHMARK("JSONParser") {
+        return parser.parse(text).list().size();
+    };
+
+    BENCHMARK("ParallelParser") {
+        return parallel.parse(text).list().size();
+    };
+}
+
+TEST_CASE("Loading a cached document", "[.][benchmark]") {
+    std::string text = "[";
+    for ( int i = 0; i < 20000; i++ ) {
+        if ( i > 0 ) text += ",";
+        text += R"({"id":)" + std::to_string(i) + R"(,"name":"item )" + std::to_string(i)
+            + R"(","scores":[1.5,2.25,3.0],"flags":[true,false]})";
+    }
+    text += "]";
+
+    JSONJay::JSONParser parser;
+    JSONJay::BufferStreamWritinator stream;
+    JSONJay::BinaryWriter writer;
+    writer.write(stream, parser.parse(text));
+    JSONJay::BinaryReader reader;
+
+    BENCHMARK("JSON text, " + std::to_string(text.size()) + " bytes") {
+        return parser.parse(text).list().size();
+    };
+
+    BENCHMARK("binary, " + std::to_string(stream.getBuffer().size()) + " bytes") {
+        JSONJay::BufferStreamReadinator input(stream.getBuffer());
+        return reader.read(input).list().size();
+    };
+}
+
+TEST_CASE("Writing a vector of small structs", "[.][benchmark]") {
+    struct Point {
+        int x;
+        int y;
+    };
+    std::vector<Point> points(1000000, Point{ 1, 2 });
+
+    BENCHMARK("through StreamWritinator&") {
+        JSONJay::BufferStreamWritinator stream(points.size() * sizeof(Point) + 16);
+        JSONJay::StreamWritinator& base = stream;
+        base.writeVector(points);
+        return stream.getBuffer().size();
+    };
+
+    BENCHMARK("through BufferStreamWritinator") {
+        JSONJay::BufferStreamWritinator stream(points.size() * sizeof(Point) + 16);
+        stream.writeVector(points);
+        return stream.getBuffer().size();
+    };
+}
+
+TEST_CASE("Reading a vector of doubles", "[.][benchmark]") {
+    std::vector<double> values(1000000, 0.5);
+    JSONJay::BufferStreamWritinator native;
+    native.writeVector(values);
+    JSONJay::BufferStreamWritinator swapped;
+    swapped.setByteOrder(std::endian::native == std::endian::little ? std::endian::big : std::endian::little);
+    swapped.writeVector(values);
+
+    BENCHMARK("host byte order") {
+        JSONJay::BufferStreamReadinator input(native.getBuffer());
+        std::vector<double> result;
+        input.readVector(result);
+        return result.size();
+    };
+
+    BENCHMARK("swapped byte order") {
+        JSONJay::BufferStreamReadinator input(swapped.getBuffer());
+        input.setByteOrder(swapped.getByteOrder());
+        std::vector<double> result;
+        input.readVector(result);
+        return result.size();
+    };
+}
+
+TEST_CASE("Reading lines", "[.][benchmark]") {
+    std::string text;
+    while ( text.size() < (16 << 20) ) text += "a line of a record oriented file, about eighty bytes long ......\r\n";
+
+    BENCHMARK("readViewUntil, " + std::to_string(text.size()) + " bytes") {
+        JSONJay::SpanStreamReadinator stream{ std::string_view(text) };
+        std::string_view line;
+        size_t lines = 0;
+        while ( stream.readViewUntil(line, "\r\n") ) lines++;
+        return lines;
+    };
+
+    BENCHMARK("readUntil, " + std::to_string(text.size()) + " bytes") {
+        JSONJay::SpanStreamReadinator stream{ std::string_view(text) };
+        std::vector<char> line;
+        size_t lines = 0;
+        while ( stream.readUntil(line, '\n') ) {
+            lines++;
+            line.clear();
+        }
+        return lines;
+    };
+}
@@ -0,0 +1,144 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "BinaryWriter.hpp"
+#include "BinaryReader.hpp"
+#include "JSONParser.hpp"
+#include "JSONWriter.hpp"
+#include "BufferStreamReadinator.hpp"
+#include "BufferStreamWritinator.hpp"
+#include "Exceptions.hpp"
+
+#include <string>
+#include <vector>
+
+using JSONJay::BaseDataType;
+using JSONJay::BinaryReader;
+using JSONJay::BinaryWriter;
+using JSONJay::BufferStreamReadinator;
+using JSONJay::BufferStreamWritinator;
+using JSONJay::Document;
+using JSONJay::JSONParser;
+using JSONJay::JSONWriter;
+using JSONJay::List;
+using JSONJay::Object;
+
+namespace {
+
+std::string text_of(const Document& document) {
+    BufferStreamWritinator stream;
+    JSONWriter writer;
+    writer.write(stream, document);
+    return std::string(stream.getBuffer().begin(), stream.getBuffer().end());
+}
+
+} // namespace
+
+TEST_CASE("Binary encoding", "[Binary]") {
+    std::string text =
+        R"({"name":"JSON-Jay","description":"a string that does not fit inline","count":-3,)"
+        R"("ratio":0.25,"flag":true,"off":false,"nothing":null,"ints":[1,-2,300000],)"
+        R"("doubles":[0.5,1e300],"bools":[true,false],"mixed":[1,"two",[3],{"four":4}],)"
+        R"("empty":{},"none":[]})";
+    JSONParser parser;
+    Document original = parser.parse(text);
+
+    SECTION("Round trip") {
+        GIVEN("A Document with values of every type") {
+            BufferStreamWritinator stream;
+            BinaryWriter writer;
+            REQUIRE(writer.write(stream, original));
+
+            THEN("Reading it back should give the same Document") {
+                BufferStreamReadinator input(stream.getBuffer());
+                BinaryReader reader;
+                Document copy = reader.read(input);
+                REQUIRE(text_of(copy) == text_of(original));
+                REQUIRE(copy.object().get_list("ints").element_type() == BaseDataType::INT);
+                REQUIRE(copy.object().get_list("doubles").element_type() == BaseDataType::DOUBLE);
+                REQUIRE(copy.object().get_list("bools").element_type() == BaseDataType::BOOL);
+            }
+
+            THEN("The encoding should be smaller than the text") {
+                REQUIRE(stream.getBuffer().size() < text.size());
+            }
+        }
+
+        GIVEN("Several encodings in one stream") {
+            BufferStreamWritinator stream;
+            BinaryWriter writer;
+            List numbers;
+            for ( int i = 0; i < 1000; i++ ) numbers.push_back(i);
+            REQUIRE(writer.write(stream, numbers));
+            REQUIRE(writer.write(stream, original));
+            stream.writeRaw<int>(42);
+
+            THEN("Each read should stop right behind its encoding") {
+                BufferStreamReadinator input(stream.getBuffer());
+                BinaryReader reader;
+                List copy;
+                reader.read(input, copy);
+                REQUIRE(copy.ints().size() == 1000);
+                REQUIRE(copy.ints()[999] == 999);
+                REQUIRE(text_of(reader.read(input)) == text_of(original));
+                int tail = 0;
+                REQUIRE(input.readRaw(tail));
+                REQUIRE(tail == 42);
+            }
+        }
+
+        GIVEN("Objects and Lists written as serializables") {
+            BufferStreamWritinator stream;
+            Object object;
+            object.set("key", "value");
+            List list;
+            list.push_back(1.5);
+            stream.writeSerializable(object);
+            stream.writeSerializable(list);
+
+            THEN("They should read back as deserializables") {
+                BufferStreamReadinator input(stream.getBuffer());
+                Object objectCopy;
+                List listCopy;
+                input.readDeserializable(objectCopy);
+                input.readDeserializable(listCopy);
+                REQUIRE(objectCopy.get_string("key") == "value");
+                REQUIRE(listCopy.get_double(0) == 1.5);
+            }
+        }
+    }
+
+    SECTION("Invalid data") {
+        BufferStreamWritinator stream;
+        BinaryWriter writer;
+        REQUIRE(writer.write(stream, original));
+        std::vector<char> encoding = stream.getBuffer();
+        BinaryReader reader;
+
+        GIVEN("Broken encodings") {
+            THEN("Reading should throw") {
+                std::vector<char> truncated(encoding.begin(), encoding.end() - 1);
+                BufferStreamReadinator shortInput(truncated);
+                REQUIRE_THROWS_AS(reader.read(shortInput), JSONJay::InvalidFormatException);
+
+                std::vector<char> wrongMagic = encoding;
+                wrongMagic[0] = 'X';
+                BufferStreamReadinator magicInput(wrongMagic);
+                REQUIRE_THROWS_AS(reader.read(magicInput), JSONJay::InvalidFormatException);
+
+                // {"a": <tag 99>}
+                std::vector<char> wrongTag = { 'J', 'J', 'B', 1, 5, 6, 1, 1, 'a', 99 };
+                BufferStreamReadinator tagInput(wrongTag);
+                REQUIRE_THROWS_AS(reader.read(tagInput), JSONJay::InvalidFormatException);
+
+                // a size of 2^63 - 1 with no data behind it
+                std::vector<char> hugeSize = { 'J', 'J', 'B', 1, '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\xff', '\x7f' };
+                BufferStreamReadinator hugeInput(hugeSize);
+                REQUIRE_THROWS_AS(reader.read(hugeInput), JSONJay::InvalidFormatException);
+
+                BufferStreamReadinator listInput(encoding);
+                List list;
+                REQUIRE_THROWS_AS(reader.read(listInput, list), JSONJay::InvalidFormatException);
+            }
+        }
+    }
+}
@@ -0,0 +1,408 @@
+#include "catch2/catch_test_macros.hpp"
+#include "AllocationCounter.hpp"
+
+#include "BufferStreamWritinator.hpp"
+#include "BufferStreamReadinator.hpp"
+#include "SpanStreamReadinator.hpp"
+#include "Varint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <map>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using JSONJay::BufferStreamReadinator;
+using JSONJay::BufferStreamWritinator;
+using JSONJay::IntegerEncoding;
+using JSONJay::SpanStreamReadinator;
+using JSONJay::StreamReadinator;
+using JSONJay::StreamWritinator;
+
+namespace {
+
+// a stream with nothing but the required overrides, to use the defaults of StreamReadinator
+class PlainReadinator : public StreamReadinator {
+private:
+    const std::vector<char>& mData;
+    uint64_t mPosition = 0;
+
+public:
+    explicit PlainReadinator(const std::vector<char>& data) : mData(data) {}
+
+    bool isStreamGood() const override {
+        return true;
+    }
+
+    uint64_t getStreamPosition() override {
+        return mPosition;
+    }
+
+    void setStreamPosition(uint64_t position) override {
+        mPosition = position;
+    }
+
+    bool readData(char* data, uint64_t size) override {
+        if ( size > mData.size() - mPosition ) return false;
+        std::copy_n(mData.begin() + mPosition, size, data);
+        mPosition += size;
+        return true;
+    }
+};
+
+void write_message(StreamWritinator& stream) {
+    stream.writeRaw<uint64_t>(42);
+    stream.writeString(std::string("message"));
+    stream.writeVector(std::vector<int>{ 1, 2, 3 });
+    stream.writeMap(std::map<int, double>{ { 1, 0.5 } });
+}
+
+} // namespace
+
+TEST_CASE("Writing to a buffer", "[BufferStreamWritinator]") {
+    SECTION("Seeking") {
+        GIVEN("A message with a length prefix patched in afterwards") {
+            BufferStreamWritinator stream;
+            stream.writeRaw<uint32_t>(0);
+            stream.writeData("payload", 7);
+            uint64_t end = stream.getStreamPosition();
+            stream.setStreamPosition(0);
+            stream.writeRaw<uint32_t>(static_cast<uint32_t>(end - sizeof(uint32_t)));
+            stream.setStreamPosition(end);
+            stream.writeData("!", 1);
+
+            THEN("The prefix should be overwritten in place") {
+                REQUIRE(stream.getBuffer().size() == 12);
+                BufferStreamReadinator input(stream.getBuffer());
+                uint32_t size = 0;
+                REQUIRE(input.readRaw(size));
+                REQUIRE(size == 7);
+                REQUIRE(std::string(stream.getBuffer().begin() + 4, stream.getBuffer().end()) == "payload!");
+            }
+        }
+
+        GIVEN("Writes that run past the end or start behind it") {
+            BufferStreamWritinator stream;
+            stream.writeData("abcd", 4);
+            stream.setStreamPosition(2);
+            stream.writeData("XYZ", 3);
+            stream.setStreamPosition(7);
+            stream.writeData("!", 1);
+
+            THEN("The buffer should be extended and gaps filled with zeros") {
+                REQUIRE(stream.getBuffer() == std::vector<char>{ 'a', 'b', 'X', 'Y', 'Z', '\0', '\0', '!' });
+            }
+        }
+    }
+
+    SECTION("Capacity") {
+        GIVEN("A stream with reserved capacity") {
+            BufferStreamWritinator stream(1024);
+            const char* data = nullptr;
+
+            THEN("Writes within the capacity should not move the buffer") {
+                REQUIRE(stream.capacity() >= 1024);
+                stream.writeData("x", 1);
+                data = stream.getBuffer().data();
+                for ( int i = 0; i < 1000; i++ ) stream.writeData("y", 1);
+                REQUIRE(stream.getBuffer().data() == data);
+            }
+
+            THEN("Releasing should hand the buffer over and empty the stream") {
+                stream.writeData("message", 7);
+                data = stream.getBuffer().data();
+                std::vector<char> buffer = stream.release();
+                REQUIRE(buffer.data() == data);
+                REQUIRE(buffer.size() == 7);
+                REQUIRE(stream.getBuffer().empty());
+                REQUIRE(stream.getStreamPosition() == 0);
+            }
+        }
+    }
+
+    SECTION("Static dispatch") {
+        GIVEN("The same message written through the base class and the concrete class") {
+            BufferStreamWritinator virtualStream;
+            write_message(virtualStream);
+            BufferStreamWritinator staticStream;
+            staticStream.writeRaw<uint64_t>(42);
+            staticStream.writeString(std::string("message"));
+            staticStream.writeVector(std::vector<int>{ 1, 2, 3 });
+            staticStream.writeMap(std::map<int, double>{ { 1, 0.5 } });
+
+            THEN("The bytes should be the same and read back either way") {
+                REQUIRE(staticStream.getBuffer() == virtualStream.getBuffer());
+
+                BufferStreamReadinator concrete(staticStream.getBuffer());
+                BufferStreamReadinator base(staticStream.getBuffer());
+                StreamReadinator& virtualReader = base;
+                for ( int pass = 0; pass < 2; pass++ ) {
+                    uint64_t number = 0;
+                    std::string string;
+                    std::vector<int> values;
+                    std::map<int, double> map;
+                    if ( pass == 0 ) {
+                        concrete.readRaw(number);
+                        concrete.readString(string);
+                        concrete.readVector(values);
+                        concrete.readMap(map);
+                    } else {
+                        virtualReader.readRaw(number);
+                        virtualReader.readString(string);
+                        virtualReader.readVector(values);
+                        virtualReader.readMap(map);
+                    }
+                    REQUIRE(number == 42);
+                    REQUIRE(string == "message");
+                    REQUIRE(values == std::vector<int>{ 1, 2, 3 });
+                    REQUIRE(map.at(1) == 0.5);
+                }
+            }
+        }
+    }
+
+    SECTION("Bulk I/O") {
+        GIVEN("Vectors, arrays and spans of trivially copyable elements") {
+            struct Point {
+                int x;
+                int y;
+            };
+            std::vector<Point> points{ { 1, 2 }, { 3, 4 } };
+            std::array<double, 3> doubles{ 0.5, 1.5, 2.5 };
+            short shorts[2] = { 7, 8 };
+            std::vector<uint64_t> large(10000);
+            for ( size_t i = 0; i < large.size(); i++ ) large[i] = i * 0x0101010101ull;
+
+            BufferStreamWritinator stream;
+            StreamWritinator& base = stream;
+            stream.writeVector(points);
+            base.writeArray(doubles);
+            stream.writeArray(shorts);
+            stream.writeArray(std::span<const uint64_t>(large));
+
+            THEN("Each container should be one block of memory") {
+                REQUIRE(stream.getBuffer().size() ==
+                    sizeof(uint32_t) + sizeof(Point) * 2 + sizeof(doubles) + sizeof(shorts) + large.size() * 8);
+                REQUIRE(std::memcmp(stream.getBuffer().data() + sizeof(uint32_t), points.data(), sizeof(Point) * 2) == 0);
+            }
+
+            THEN("The containers should read back") {
+                BufferStreamReadinator input(stream.getBuffer());
+                std::vector<Point> readPoints{ { 9, 9 } };
+                std::array<double, 3> readDoubles{};
+                short readShorts[2] = {};
+                std::vector<uint64_t> readLarge(large.size());
+                input.readVector(readPoints);
+                REQUIRE(static_cast<StreamReadinator&>(input).readArray(readDoubles));
+                REQUIRE(input.readArray(readShorts));
+                REQUIRE(input.readArray(std::span<uint64_t>(readLarge)));
+
+                REQUIRE(readPoints.size() == 3);
+                REQUIRE(readPoints[2].y == 4);
+                REQUIRE(readDoubles == doubles);
+                REQUIRE(readShorts[1] == 8);
+                REQUIRE(readLarge == large);
+                REQUIRE_FALSE(input.readArray(readShorts));
+            }
+        }
+
+        GIVEN("Maps of trivial and of string entries") {
+            std::map<int, double> ordered;
+            std::unordered_map<uint16_t, uint64_t> unordered;
+            for ( int i = 0; i < 1000; i++ ) {
+                ordered[i * 3] = i * 0.25;
+                unordered[static_cast<uint16_t>(i)] = i * 7ull;
+            }
+            std::map<std::string, int> named{ { "a", 1 }, { "b", 2 } };
+
+            BufferStreamWritinator stream;
+            stream.writeMap(ordered);
+            stream.writeMap(unordered);
+            stream.writeMap(named);
+
+            THEN("The maps should read back") {
+                BufferStreamReadinator input(stream.getBuffer());
+                std::map<int, double> readOrdered{ { 3, 100.0 } };
+                std::unordered_map<uint16_t, uint64_t> readUnordered;
+                std::map<std::string, int> readNamed;
+                input.readMap(readOrdered);
+                input.readMap(readUnordered);
+                input.readMap(readNamed);
+                REQUIRE(readOrdered == ordered);
+                REQUIRE(readUnordered == unordered);
+                REQUIRE(readNamed == named);
+            }
+        }
+    }
+
+    SECTION("Byte order") {
+        GIVEN("Numbers written in the opposite byte order") {
+            constexpr std::endian other =
+                std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+            BufferStreamWritinator stream;
+            stream.setByteOrder(other);
+            stream.writeRaw<uint32_t>(0x01020304);
+            stream.writeVector(std::vector<uint16_t>{ 0x0102, 0x0304 });
+            stream.writeMap(std::map<uint16_t, uint32_t>{ { 0x0102, 0x01020304 } });
+            stream.writeString(std::string("ab"));
+
+            THEN("The bytes should be swapped") {
+                const std::vector<char>& bytes = stream.getBuffer();
+                if constexpr ( std::endian::native == std::endian::little )
+                    REQUIRE(std::vector<char>(bytes.begin(), bytes.begin() + 4) == std::vector<char>{ 1, 2, 3, 4 });
+                else
+                    REQUIRE(std::vector<char>(bytes.begin(), bytes.begin() + 4) == std::vector<char>{ 4, 3, 2, 1 });
+            }
+
+            THEN("A reader in the same byte order should read them back") {
+                BufferStreamReadinator input(stream.getBuffer());
+                input.setByteOrder(other);
+                uint32_t number = 0;
+                std::vector<uint16_t> values;
+                std::map<uint16_t, uint32_t> map;
+                std::string string;
+                input.readRaw(number);
+                input.readVector(values);
+                input.readMap(map);
+                input.readString(string);
+                REQUIRE(number == 0x01020304);
+                REQUIRE(values == std::vector<uint16_t>{ 0x0102, 0x0304 });
+                REQUIRE(map.at(0x0102) == 0x01020304);
+                REQUIRE(string == "ab");
+            }
+
+            THEN("A reader in host byte order should see them swapped") {
+                BufferStreamReadinator input(stream.getBuffer());
+                uint32_t number = 0;
+                input.readRaw(number);
+                REQUIRE(number == 0x04030201);
+            }
+        }
+    }
+
+    SECTION("Varint encoding") {
+        GIVEN("Varints around every length") {
+            std::vector<uint64_t> numbers{ 0, 1, 127, 128, 300, 16383, 16384, (1ull << 49) - 1, 1ull << 56,
+                                           (1ull << 63) + 5, ~0ull };
+
+            THEN("They should decode from long and short input alike") {
+                for ( uint64_t number : numbers ) {
+                    char bytes[16] = {};
+                    size_t size = JSONJay::encode_varint(number, bytes);
+                    uint64_t decoded = 0;
+                    REQUIRE(JSONJay::decode_varint(bytes, sizeof(bytes), decoded) == size);
+                    REQUIRE(decoded == number);
+                    decoded = 0;
+                    REQUIRE(JSONJay::decode_varint(bytes, size, decoded) == size);
+                    REQUIRE(decoded == number);
+                    REQUIRE(JSONJay::decode_varint(bytes, size - 1, decoded) == 0);
+                }
+                const char overlong[11] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 0 };
+                uint64_t decoded = 0;
+                REQUIRE(JSONJay::decode_varint(overlong, sizeof(overlong), decoded) == 0);
+                REQUIRE(JSONJay::zigzag_decode(JSONJay::zigzag_encode(-3)) == -3);
+                REQUIRE(JSONJay::zigzag_encode(-1) == 1);
+            }
+        }
+
+        GIVEN("A small message written with varints") {
+            BufferStreamWritinator stream;
+            stream.setIntegerEncoding(IntegerEncoding::VARINT);
+            stream.writeString(std::string("ab"));
+            stream.writeRaw<int64_t>(-1);
+            stream.writeRaw<uint32_t>(300);
+            stream.writeVector(std::vector<int>{ 1, -64, 100000 });
+            stream.writeMap(std::map<uint16_t, int>{ { 1, 2 }, { 3, 4 } });
+            stream.writeRaw<double>(0.5);
+
+            THEN("Lengths and integers should take only the bytes they need") {
+                // 1+2, 1, 2, 1+1+1+3, 1+4, 8
+                REQUIRE(stream.getBuffer().size() == 25);
+            }
+
+            THEN("A reader with varints should read it back on every backend") {
+                BufferStreamReadinator buffer(stream.getBuffer());
+                SpanStreamReadinator span(std::span<const char>(stream.getBuffer()));
+                PlainReadinator plain(stream.getBuffer());
+                StreamReadinator* readers[] = { &buffer, &span, &plain };
+                for ( StreamReadinator* reader : readers ) {
+                    reader->setIntegerEncoding(IntegerEncoding::VARINT);
+                    std::string string;
+                    int64_t negative = 0;
+                    uint32_t number = 0;
+                    std::vector<int> values;
+                    std::map<uint16_t, int> map;
+                    double tail = 0;
+                    REQUIRE(reader->readString(string));
+                    REQUIRE(reader->readRaw(negative));
+                    REQUIRE(reader->readRaw(number));
+                    reader->readVector(values);
+                    reader->readMap(map);
+                    REQUIRE(reader->readRaw(tail));
+                    REQUIRE(string == "ab");
+                    REQUIRE(negative == -1);
+                    REQUIRE(number == 300);
+                    REQUIRE(values == std::vector<int>{ 1, -64, 100000 });
+                    REQUIRE(map == std::map<uint16_t, int>{ { 1, 2 }, { 3, 4 } });
+                    REQUIRE(tail == 0.5);
+                }
+            }
+        }
+
+        GIVEN("A varint too large for the integer it is read into") {
+            BufferStreamWritinator stream;
+            stream.writeVarint(100000);
+
+            THEN("Reading should fail") {
+                BufferStreamReadinator input(stream.getBuffer());
+                input.setIntegerEncoding(IntegerEncoding::VARINT);
+                int16_t number = 0;
+                REQUIRE_FALSE(input.readRaw(number));
+                REQUIRE(number == 0);
+            }
+        }
+    }
+
+    SECTION("Allocations") {
+        GIVEN("A stream with room for a message and the parts of the message") {
+            std::string string(100, 's');
+            std::string_view view = string;
+            std::vector<char> buffer(100, 'b');
+            std::vector<int> ints(100, 1);
+            std::vector<std::string> strings(10, string);
+            std::map<int, double> map{ { 1, 0.5 }, { 2, 1.5 } };
+            std::map<std::string, std::string> stringMap{ { string, string } };
+            std::array<uint64_t, 4> array{ 1, 2, 3, 4 };
+            BufferStreamWritinator stream(1 << 20);
+
+            WHEN("Writing it in every encoding") {
+                test::AllocationCounter counter;
+                for ( IntegerEncoding encoding : { IntegerEncoding::FIXED, IntegerEncoding::VARINT } ) {
+                    for ( std::endian order : { std::endian::little, std::endian::big } ) {
+                        stream.setIntegerEncoding(encoding);
+                        stream.setByteOrder(order);
+                        stream.writeString(string);
+                        stream.writeString(view);
+                        stream.writeBuffer(buffer);
+                        stream.writeZero(10000);
+                        stream.writeVector(ints);
+                        stream.writeVector(strings);
+                        stream.writeMap(map);
+                        stream.writeMap(stringMap);
+                        stream.writeArray(array);
+                    }
+                }
+                size_t allocations = counter.count();
+
+                THEN("Nothing should be allocated") {
+                    REQUIRE(allocations == 0);
+                    REQUIRE(stream.getBuffer().size() > 40000);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include "catch2/catch_test_macros.hpp"
+#include "Document.hpp"
+
+#include <memory_resource>
+
+using JSONJay::Document;
+using JSONJay::Object;
+using JSONJay::List;
+
+namespace {
+
+/**
+ * @brief memory resource that counts the blocks requested from it
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Document operations", "[Document]") {
+    SECTION("Root types") {
+        GIVEN("A default document") {
+            Document doc;
+
+            THEN("The root should be an empty object") {
+                REQUIRE(doc.root_type() == JSONJay::BaseDataType::OBJECT);
+                REQUIRE(doc.object().empty());
+                REQUIRE_THROWS_AS(doc.list(), JSONJay::InvalidTypeException);
+            }
+        }
+        AND_GIVEN("A document with a list root") {
+            Document doc(JSONJay::BaseDataType::LIST);
+
+            THEN("The root should be an empty list") {
+                REQUIRE(doc.root_type() == JSONJay::BaseDataType::LIST);
+                REQUIRE(doc.list().empty());
+                REQUIRE_THROWS_AS(doc.object(), JSONJay::InvalidTypeException);
+            }
+        }
+        AND_GIVEN("An invalid root type") {
+            THEN("Construction should throw") {
+                REQUIRE_THROWS_AS(Document(JSONJay::BaseDataType::INT), JSONJay::InvalidTypeException);
+            }
+        }
+    }
+
+    SECTION("Building a tree") {
+        GIVEN("A document") {
+            CountingResource upstream;
+            {
+                Document doc(JSONJay::BaseDataType::OBJECT, 1 << 16, &upstream);
+
+                WHEN("Adding many nested nodes") {
+                    List items = doc.make_list();
+                    for ( int i = 0; i < 1000; i++ ) {
+                        Object item = doc.make_object();
+                        item.set("id", i);
+                        item.set("name", "item");
+                        items.push_back(std::move(item));
+                    }
+                    doc.object().set("items", std::move(items));
+
+                    THEN("The nodes should be accessible") {
+                        REQUIRE(doc.object().get_list("items").size() == 1000);
+                        REQUIRE(doc.object().get_list("items").get_object(999).get_int("id") == 999);
+                    }
+
+                    THEN("The nodes should come from a few arena blocks") {
+                        REQUIRE(upstream.allocations < 16);
+                    }
+                }
+
+                AND_WHEN("Moving a heap allocated node into the document") {
+                    Object heapObject;
+                    heapObject.set("nested", new List());
+                    heapObject.get_list("nested").push_back(42);
+                    doc.object().set("moved", std::move(heapObject));
+                    doc.object().set("adopted", new Object());
+
+                    THEN("The node should be relocated into the arena") {
+                        Object& moved = doc.object().get_object("moved");
+                        REQUIRE(moved.get_allocator().resource() == doc.resource());
+                        REQUIRE(moved.get_list("nested").get_allocator().resource() == doc.resource());
+                        REQUIRE(moved.get_list("nested").get_int(0) == 42);
+                        REQUIRE(doc.object().get_object("adopted").get_allocator().resource() == doc.resource());
+                    }
+                }
+            }
+
+            THEN("All arena blocks should be released with the document") {
+                REQUIRE(upstream.allocations == upstream.deallocations);
+            }
+        }
+    }
+
+    SECTION("Moving a document") {
+        GIVEN("A document with elements") {
+            Document doc;
+            doc.object().set("key", 1);
+
+            WHEN("Moving the document") {
+                Document other(std::move(doc));
+
+                THEN("The elements should be owned by the new document") {
+                    REQUIRE(other.object().get_int("key") == 1);
+                }
+            }
+        }
+    }
+}
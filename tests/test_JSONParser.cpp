@@ -0,0 +1,211 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "JSONParser.hpp"
+#include "BufferStreamReadinator.hpp"
+#include "StructuralIndex.hpp"
+#include <cmath>
+
+#include <string>
+#include <vector>
+
+using JSONJay::BaseDataType;
+using JSONJay::Document;
+using JSONJay::Isa;
+using JSONJay::JSONParser;
+using JSONJay::List;
+using JSONJay::Object;
+using JSONJay::StructuralIndex;
+
+TEST_CASE("Structural index", "[JSONParser]") {
+    SECTION("Indexing") {
+        GIVEN("A text with strings, escapes and scalars") {
+            std::string text = R"({"a\"b":[1, true,"x\\"],"c" : null})";
+
+            THEN("Only characters outside of strings and the quotes should be indexed") {
+                std::vector<uint32_t> expected = { 0, 1, 6, 7, 8, 9, 10, 12, 16, 17, 21, 22, 23, 24, 26, 28, 30, 34 };
+                for ( Isa isa : { Isa::SCALAR, Isa::SSE2, Isa::AVX2 } ) {
+                    StructuralIndex index;
+                    index.build(text, isa);
+                    REQUIRE(std::vector<uint32_t>(index.positions().begin(), index.positions().end()) == expected);
+                }
+            }
+        }
+
+        GIVEN("A string spanning several blocks with escapes on the block boundary") {
+            std::string text = "[\"" + std::string(61, 'a') + "\\\\\\\"" + std::string(70, 'b') + "\"]";
+
+            THEN("The string should be skipped as a whole") {
+                for ( Isa isa : { Isa::SCALAR, Isa::SSE2, Isa::AVX2 } ) {
+                    StructuralIndex index;
+                    index.build(text, isa);
+                    REQUIRE(index.size() == 4);
+                    REQUIRE(index[2] == text.size() - 2);
+                }
+            }
+        }
+    }
+
+    SECTION("Errors") {
+        GIVEN("Broken strings") {
+            StructuralIndex index;
+
+            THEN("Building the index should throw") {
+                REQUIRE_THROWS_AS(index.build(R"(["abc])"), JSONJay::InvalidFormatException);
+                REQUIRE_THROWS_AS(index.build("[\"a\nb\"]"), JSONJay::InvalidFormatException);
+                REQUIRE_THROWS_AS(index.build(R"(["abc\"])"), JSONJay::InvalidFormatException);
+            }
+        }
+    }
+}
+
+TEST_CASE("JSON parsing", "[JSONParser]") {
+    JSONParser parser;
+
+    SECTION("Valid documents") {
+        GIVEN("An Object with values of every type") {
+            Document document = parser.parse(R"(
+                {
+                    "name": "JSON-Jay",
+                    "version": 4,
+                    "ratio": -1.5e2,
+                    "big": 12345678901,
+                    "stable": false,
+                    "license": null,
+                    "tags": ["json", "serialization", 3, [], {}],
+                    "nested": { "depth": { "level": 2 } }
+                }
+            )");
+
+            THEN("Every value should be stored with its type") {
+                REQUIRE(document.root_type() == BaseDataType::OBJECT);
+                Object& root = document.object();
+                REQUIRE(root.size() == 8);
+                REQUIRE(root.get_string("name") == "JSON-Jay");
+                REQUIRE(root.get_int("version") == 4);
+                REQUIRE(root.get_double("ratio") == -150.0);
+                REQUIRE(root.get_double("big") == 12345678901.0);
+                REQUIRE(root.get_bool("stable") == false);
+                REQUIRE(root.get_type("license") == BaseDataType::NONE);
+
+                List& tags = root.get_list("tags");
+                REQUIRE(tags.size() == 5);
+                REQUIRE(tags.get_string(1) == "serialization");
+                REQUIRE(tags.get_int(2) == 3);
+                REQUIRE(tags.get_list(3).empty());
+                REQUIRE(tags.get_object(4).empty());
+
+                REQUIRE(root.get_object("nested").get_object("depth").get_int("level") == 2);
+            }
+        }
+
+        GIVEN("A List of numbers") {
+            Document document = parser.parse("[0, -0, 2147483647, -2147483648, 2147483648, 0.5, 1E3, 1e-2]");
+
+            THEN("Integers that fit into int should stay integers") {
+                List& list = document.list();
+                REQUIRE(list.size() == 8);
+                REQUIRE(list.get_int(2) == 2147483647);
+                REQUIRE(list.get_int(3) == -2147483648);
+                REQUIRE(list.get_type(4) == BaseDataType::DOUBLE);
+                REQUIRE(list.get_double(4) == 2147483648.0);
+                REQUIRE(list.get_double(6) == 1000.0);
+                REQUIRE(list.get_double(7) == 0.01);
+            }
+        }
+
+        GIVEN("Numbers at the edges of double") {
+            Document document = parser.parse("[-0, 1e-400, -1e-400, 0.0000001e-400]");
+
+            THEN("-0 should keep its sign and tiny numbers should become zero") {
+                List& list = document.list();
+                REQUIRE(list.get_type(0) == BaseDataType::DOUBLE);
+                REQUIRE(std::signbit(list.get_double(0)));
+                REQUIRE(list.get_double(1) == 0.0);
+                REQUIRE_FALSE(std::signbit(list.get_double(1)));
+                REQUIRE(std::signbit(list.get_double(2)));
+                REQUIRE(list.get_double(3) == 0.0);
+            }
+        }
+
+        GIVEN("Keys that Key would reject") {
+            Document document = parser.parse(R"({"a b": 1, "": 2, "a": 3, "a": [4]})");
+
+            THEN("They should be accepted and the last duplicate should win") {
+                JSONJay::Object& root = document.object();
+                REQUIRE(root.size() == 3);
+                REQUIRE(root.get_int("a b") == 1);
+                REQUIRE(root.get_int("") == 2);
+                REQUIRE(root.get_list("a").get_int(0) == 4);
+            }
+        }
+
+        GIVEN("Strings with escapes") {
+            Document document = parser.parse(R"(["tab\there", "quote\"d", "\u00e9\u20AC", "\ud83d\ude00", "\/\\\b\f\n\r"])");
+
+            THEN("The escapes should be resolved") {
+                List& list = document.list();
+                REQUIRE(list.get_string(0) == "tab\there");
+                REQUIRE(list.get_string(1) == "quote\"d");
+                REQUIRE(list.get_string(2) == "\xC3\xA9\xE2\x82\xAC");
+                REQUIRE(list.get_string(3) == "\xF0\x9F\x98\x80");
+                REQUIRE(list.get_string(4) == "/\\\b\f\n\r");
+            }
+        }
+
+        GIVEN("A large document") {
+            std::string text = "[";
+            for ( int i = 0; i < 2000; i++ ) {
+                if ( i != 0 ) text += ",";
+                text += R"({"id":)" + std::to_string(i) + R"(,"label":"item \")" + std::to_string(i) + R"(\"","tags":[true,null]})";
+            }
+            text += "]";
+
+            THEN("Every instruction set should produce the same tree") {
+                for ( Isa isa : { Isa::SCALAR, Isa::SSE2, Isa::AVX2 } ) {
+                    parser.set_isa(isa);
+                    Document document = parser.parse(text);
+                    List& list = document.list();
+                    REQUIRE(list.size() == 2000);
+                    REQUIRE(list.get_object(1234).get_int("id") == 1234);
+                    REQUIRE(list.get_object(1999).get_string("label") == "item \"1999\"");
+                    REQUIRE(list.get_object(7).get_list("tags").get_bool(0));
+                }
+            }
+        }
+
+        GIVEN("A stream") {
+            std::string text = R"({"streamed": [1, 2, 3]})";
+            JSONJay::BufferStreamReadinator reader(std::vector<char>(text.begin(), text.end()));
+            Document document = parser.parse(reader);
+
+            THEN("The whole stream should be parsed") {
+                REQUIRE(document.object().get_list("streamed").get_int(2) == 3);
+            }
+        }
+    }
+
+    SECTION("Invalid documents") {
+        GIVEN("Malformed texts") {
+            std::vector<std::string> texts = {
+                "", "   ", "42", "\"text\"", "{", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":}", "{,}",
+                "[01]", "[1.]", "[-]", "[1e]", "[tru]", "[nul]", "[\"\\x\"]", "[\"\\ud800\"]",
+                "[1e999]", "{} []", "[}", "{\"a\":1,}",
+            };
+
+            THEN("Parsing should throw") {
+                for ( const std::string& text : texts ) {
+                    REQUIRE_THROWS_AS(parser.parse(text), JSONJay::InvalidFormatException);
+                }
+            }
+        }
+
+        GIVEN("Deeply nested Lists") {
+            std::string text = std::string(JSONParser::kMaxDepth + 1, '[') + std::string(JSONParser::kMaxDepth + 1, ']');
+
+            THEN("Parsing should stop at the depth limit") {
+                REQUIRE_THROWS_AS(parser.parse(text), JSONJay::InvalidFormatException);
+                REQUIRE_NOTHROW(parser.parse(text.substr(1, 2 * JSONParser::kMaxDepth)));
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "JSONWriter.hpp"
+#include "JSONParser.hpp"
+#include "BufferStreamWritinator.hpp"
+
+#include <limits>
+#include <string>
+
+using JSONJay::BufferStreamWritinator;
+using JSONJay::Document;
+using JSONJay::Isa;
+using JSONJay::JSONParser;
+using JSONJay::JSONStyle;
+using JSONJay::JSONWriter;
+using JSONJay::List;
+using JSONJay::Object;
+
+namespace {
+
+std::string text_of(const BufferStreamWritinator& stream) {
+    return std::string(stream.getBuffer().begin(), stream.getBuffer().end());
+}
+
+} // namespace
+
+TEST_CASE("JSON writing", "[JSONWriter]") {
+    Object object;
+    object.set("name", "JSON-Jay");
+    object.set("count", 3);
+    object.set("ratio", 0.1);
+    object.set("whole", 2.0);
+    object.set("flag", true);
+    object.set("nothing", std::monostate());
+    List& numbers = object.emplace<List>("numbers");
+    numbers.push_back(1);
+    numbers.push_back(-20);
+    object.emplace<List>("empty");
+    object.emplace<Object>("nested").set("level", 1);
+
+    SECTION("Minified") {
+        GIVEN("An Object with values of every type") {
+            BufferStreamWritinator stream;
+            JSONWriter writer;
+            REQUIRE(writer.write(stream, object));
+
+            THEN("The text should contain no whitespace") {
+                REQUIRE(text_of(stream) ==
+                    R"({"count":3,"empty":[],"flag":true,"name":"JSON-Jay","nested":{"level":1},)"
+                    R"("nothing":null,"numbers":[1,-20],"ratio":0.1,"whole":2.0})");
+            }
+        }
+    }
+
+    SECTION("Pretty") {
+        GIVEN("A small Object") {
+            Object small;
+            small.set("a", 1);
+            small.emplace<List>("b").push_back(false);
+            small.emplace<Object>("c");
+
+            BufferStreamWritinator stream;
+            JSONWriter writer(JSONStyle::PRETTY, 2);
+            REQUIRE(writer.write(stream, small));
+
+            THEN("Every value should be on its own line") {
+                REQUIRE(text_of(stream) == "{\n  \"a\": 1,\n  \"b\": [\n    false\n  ],\n  \"c\": {}\n}");
+            }
+        }
+    }
+
+    SECTION("Strings and numbers") {
+        GIVEN("Strings that need escaping") {
+            List list;
+            list.push_back("quote \" backslash \\ newline \n tab \t bell \x07 end");
+            list.push_back(std::string(100, 'x') + "\"" + std::string(40, 'y'));
+
+            THEN("Every instruction set should escape them the same way") {
+                for ( Isa isa : { Isa::SCALAR, Isa::SSE2, Isa::AVX2 } ) {
+                    BufferStreamWritinator stream;
+                    JSONWriter writer;
+                    writer.set_isa(isa);
+                    REQUIRE(writer.write(stream, list));
+                    REQUIRE(text_of(stream) ==
+                        "[\"quote \\\" backslash \\\\ newline \\n tab \\t bell \\u0007 end\",\""
+                        + std::string(100, 'x') + "\\\"" + std::string(40, 'y') + "\"]");
+                }
+            }
+        }
+
+        GIVEN("Doubles") {
+            List list;
+            list.push_back(0.1);
+            list.push_back(1e300);
+            list.push_back(-0.0);
+            list.push_back(123456789.125);
+
+            BufferStreamWritinator stream;
+            JSONWriter writer;
+            REQUIRE(writer.write(stream, list));
+
+            THEN("They should be written in their shortest form") {
+                REQUIRE(text_of(stream) == "[0.1,1e+300,-0.0,123456789.125]");
+            }
+
+            THEN("NaN and infinity should throw") {
+                list.push_back(std::numeric_limits<double>::quiet_NaN());
+                BufferStreamWritinator failing;
+                REQUIRE_THROWS_AS(writer.write(failing, list), JSONJay::InvalidValueException);
+            }
+        }
+    }
+
+    SECTION("Round trip") {
+        GIVEN("A large parsed document") {
+            std::string text = "[";
+            for ( int i = 0; i < 3000; i++ ) {
+                if ( i != 0 ) text += ",";
+                text += R"({"id":)" + std::to_string(i) + R"(,"score":)" + std::to_string(i) + R"(.5,"label":"line\n)"
+                    + std::to_string(i) + R"(","tags":[true,null,"x"]})";
+            }
+            text += "]";
+
+            JSONParser parser;
+            Document document = parser.parse(text);
+
+            THEN("Writing it minified should reproduce the text") {
+                BufferStreamWritinator stream;
+                JSONWriter writer;
+                REQUIRE(writer.write(stream, document));
+                REQUIRE(text_of(stream).size() > JSONWriter::kBufferSize);
+
+                Document reparsed = parser.parse(text_of(stream));
+                REQUIRE(reparsed.list().size() == 3000);
+                REQUIRE(reparsed.list().get_object(2999).get_double("score") == 2999.5);
+                REQUIRE(reparsed.list().get_object(17).get_string("label") == "line\n17");
+            }
+
+            THEN("Pretty text should parse to the same document") {
+                BufferStreamWritinator pretty;
+                JSONWriter writer(JSONStyle::PRETTY);
+                REQUIRE(writer.write(pretty, document));
+
+                BufferStreamWritinator minified;
+                REQUIRE(JSONWriter().write(minified, parser.parse(text_of(pretty))));
+                REQUIRE(text_of(minified).size() == text.size());
+            }
+        }
+    }
+}
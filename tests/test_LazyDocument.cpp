@@ -0,0 +1,86 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "LazyDocument.hpp"
+#include "Exceptions.hpp"
+
+#include <string>
+
+using JSONJay::BaseDataType;
+using JSONJay::LazyDocument;
+using JSONJay::LazyValue;
+
+TEST_CASE("Lazy document access", "[LazyDocument]") {
+    std::string text = R"({
+        "skipped": { "deep": [[1, 2, {"x": "]}"}], "}{"], "more": {} },
+        "user": { "id": 42, "name": "Jay", "score": 9.5, "admin": false, "manager": null },
+        "tags": ["a", "b\n\"c\"", 3],
+        "escaped\tkey": "value"
+    })";
+    LazyDocument document(text);
+
+    SECTION("Lookups") {
+        GIVEN("A nested document") {
+            THEN("Members should be found past skipped subtrees") {
+                REQUIRE(document["user"]["id"].get_int() == 42);
+                REQUIRE(document["user"]["name"].get_string() == "Jay");
+                REQUIRE(document["user"]["score"].get_double() == 9.5);
+                REQUIRE(document["user"]["admin"].get_bool() == false);
+                REQUIRE(document["user"]["manager"].is_null());
+                REQUIRE(document["escaped\tkey"].get_string() == "value");
+            }
+
+            THEN("Elements should be found by index") {
+                LazyValue tags = document["tags"];
+                REQUIRE(tags.size() == 3);
+                REQUIRE(tags[0].get_string() == "a");
+                REQUIRE(tags[1].get_string() == "b\n\"c\"");
+                REQUIRE(tags[2].get_int() == 3);
+                REQUIRE(document["skipped"]["deep"][0][2]["x"].get_string() == "]}");
+            }
+
+            THEN("Types should be reported without decoding") {
+                REQUIRE(document.root().type() == BaseDataType::OBJECT);
+                REQUIRE(document.root().size() == 4);
+                REQUIRE(document["tags"].type() == BaseDataType::LIST);
+                REQUIRE(document["user"]["score"].type() == BaseDataType::DOUBLE);
+                REQUIRE(document["user"]["manager"].type() == BaseDataType::NONE);
+                REQUIRE(document["skipped"]["more"].size() == 0);
+                REQUIRE(document["user"].contains("admin"));
+                REQUIRE_FALSE(document["user"].contains("missing"));
+            }
+
+            THEN("Unescaped strings should stay valid") {
+                std::string_view first = document["tags"][1].get_string();
+                std::string_view second = document["escaped\tkey"].get_string();
+                REQUIRE(document["tags"][1].get_string() == first);
+                REQUIRE(first == "b\n\"c\"");
+                REQUIRE(second == "value");
+            }
+        }
+    }
+
+    SECTION("Errors") {
+        GIVEN("A nested document") {
+            THEN("Wrong accesses should throw") {
+                REQUIRE_THROWS_AS(document["missing"], JSONJay::InvalidKeyException);
+                REQUIRE_THROWS_AS(document["tags"][3], JSONJay::InvalidIndexException);
+                REQUIRE_THROWS_AS(document["tags"]["a"], JSONJay::InvalidTypeException);
+                REQUIRE_THROWS_AS(document["user"][0], JSONJay::InvalidTypeException);
+                REQUIRE_THROWS_AS(document["user"]["id"].get_string(), JSONJay::InvalidTypeException);
+                REQUIRE_THROWS_AS(document["user"]["score"].get_int(), JSONJay::InvalidTypeException);
+                REQUIRE_THROWS_AS(document["user"].get_int(), JSONJay::InvalidTypeException);
+                REQUIRE_FALSE(document["user"].is_null());
+            }
+        }
+
+        GIVEN("Malformed texts") {
+            THEN("Errors should be found where the text is walked") {
+                REQUIRE_THROWS_AS(LazyDocument(R"({"a": "b)"), JSONJay::InvalidFormatException);
+                LazyDocument truncated(R"({"a": [1, 2, {"b": 3})");
+                REQUIRE_THROWS_AS(truncated["c"], JSONJay::InvalidFormatException);
+                LazyDocument empty("");
+                REQUIRE_THROWS_AS(empty.root(), JSONJay::InvalidFormatException);
+            }
+        }
+    }
+}
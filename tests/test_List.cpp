@@ -1,7 +1,16 @@
 #include "catch2/catch_test_macros.hpp"
+#include "BufferStreamWritinator.hpp"
+#include "Document.hpp"
+#include "Exceptions.hpp"
+#include "JSONParser.hpp"
+#include "JSONWriter.hpp"
 #include "List.hpp"
+#include "Numeric.hpp"
 #include "Object.hpp"
 
+#include <string>
+#include <string_view>
+
 using JSONJay::List;
 using JSONJay::Object;
 
@@ -99,6 +108,166 @@ TEST_CASE("List operations", "[List]") {
         }
     }
 
+    SECTION("Homogeneous lists") {
+        GIVEN("A list of integers") {
+            List list;
+            for ( int i = 0; i < 100; i++ )
+                list.push_back(i);
+
+            THEN("The integers should be stored contiguously") {
+                REQUIRE(list.element_type() == JSONJay::BaseDataType::INT);
+                REQUIRE(list.ints().size() == 100);
+                REQUIRE(list.ints()[42] == 42);
+                REQUIRE_THROWS_AS(list.doubles(), JSONJay::InvalidTypeException);
+            }
+
+            WHEN("Modifying and erasing elements") {
+                list.at<int>(1) = 7;
+                list.erase(0);
+                list.insert(0, -1);
+
+                THEN("The array should reflect the changes") {
+                    REQUIRE(list.size() == 100);
+                    REQUIRE(list.ints()[0] == -1);
+                    REQUIRE(list.ints()[1] == 7);
+                    REQUIRE(list.value_at(1).get<int>() == 7);
+                    REQUIRE(list.get_type(1) == JSONJay::BaseDataType::INT);
+                }
+            }
+
+            WHEN("Adding an element of another type") {
+                list.push_back(0.5);
+
+                THEN("The list should fall back to mixed storage") {
+                    REQUIRE(list.element_type() == JSONJay::BaseDataType::NONE);
+                    REQUIRE(list.size() == 101);
+                    REQUIRE(list.get_int(99) == 99);
+                    REQUIRE(list.get_double(100) == 0.5);
+                    REQUIRE_THROWS_AS(list.ints(), JSONJay::InvalidTypeException);
+                }
+
+                AND_WHEN("Clearing the list") {
+                    list.clear();
+                    list.push_back(1.5);
+
+                    THEN("The list should be homogeneous again") {
+                        REQUIRE(list.element_type() == JSONJay::BaseDataType::DOUBLE);
+                        REQUIRE(list.doubles()[0] == 1.5);
+                    }
+                }
+            }
+        }
+
+        GIVEN("A typed list in a Document whose elements are handed out") {
+            JSONJay::JSONParser parser;
+            JSONJay::Document document = parser.parse("[1,2,3]");
+            List& list = document.list();
+            REQUIRE(list.element_type() == JSONJay::BaseDataType::INT);
+
+            WHEN("Iterating over it") {
+                int sum = 0;
+                for ( const auto& [element, type] : list ) sum += element.get<int>();
+
+                THEN("The list should stay typed") {
+                    REQUIRE(sum == 6);
+                    REQUIRE(list.size() == 3);
+                    REQUIRE_FALSE(list.empty());
+                    REQUIRE(list.at<int>(0) == 1);
+                    REQUIRE(list[2].get<int>() == 3);
+                    REQUIRE(list.element_type() == JSONJay::BaseDataType::INT);
+                    REQUIRE(list.ints().size() == 3);
+                    REQUIRE(JSONJay::numeric::sum(list) == 6);
+
+                    JSONJay::BufferStreamWritinator stream;
+                    REQUIRE(JSONJay::JSONWriter().write(stream, list));
+                    REQUIRE(std::string(stream.getBuffer().begin(), stream.getBuffer().end()) == "[1,2,3]");
+                }
+
+                AND_WHEN("Appending another element") {
+                    list.push_back(4);
+
+                    THEN("It should go behind the others") {
+                        REQUIRE(list.size() == 4);
+                        REQUIRE(list.at<int>(0) == 1);
+                        REQUIRE(list.at<int>(3) == 4);
+                        REQUIRE(JSONJay::numeric::sum(list) == 10);
+                    }
+                }
+            }
+
+            WHEN("Finding an element of a list of doubles") {
+                JSONJay::Document other = parser.parse("[0.5,1.5]");
+                List& values = other.list();
+                REQUIRE(values.find(0)->get<double>() == 0.5);
+
+                THEN("The list should stay typed") {
+                    REQUIRE(values.size() == 2);
+                    REQUIRE(values.doubles()[0] == 0.5);
+                    REQUIRE(values.at<double>(1) == 1.5);
+                    REQUIRE(JSONJay::numeric::sum(values) == 2.0);
+                    values.push_back(2.0);
+                    REQUIRE(values.size() == 3);
+                    REQUIRE(values.at<double>(2) == 2.0);
+                }
+            }
+        }
+
+        GIVEN("A const list of short strings") {
+            List list;
+            list.push_back("short");
+            const List& constList = list;
+
+            THEN("Views of its strings should stay valid") {
+                std::string_view string = constList[0].get<std::string>();
+                REQUIRE(string == "short");
+                REQUIRE(list.value_at(0).get<std::string>() == "short");
+            }
+        }
+
+        GIVEN("A const typed list") {
+            List list;
+            list.push_back(5);
+            const List& constList = list;
+
+            THEN("Its elements should be readable by index") {
+                REQUIRE(constList[0].get<int>() == 5);
+                REQUIRE(constList[0].type() == JSONJay::BaseDataType::INT);
+                REQUIRE_THROWS_AS(constList[0].get<double>(), JSONJay::InvalidTypeException);
+                REQUIRE(constList.value_at(0).get<int>() == 5);
+            }
+        }
+
+        GIVEN("A list of integers that is iterated") {
+            List list;
+            for ( int i = 0; i < 5; i++ )
+                list.push_back(i);
+
+            WHEN("Changing the elements while iterating") {
+                for ( const auto& [element, type] : list ) element.get<int>() *= 2;
+
+                THEN("The changes should land in the typed array") {
+                    REQUIRE(list.element_type() == JSONJay::BaseDataType::INT);
+                    REQUIRE(list.ints()[4] == 8);
+                    REQUIRE(*list.find(3)->get_if<int>() == 6);
+                    REQUIRE(list.find(3)->get_if<double>() == nullptr);
+                    List::ConstElement first = *list.find(0);
+                    REQUIRE(first.get<int>() == 0);
+                }
+            }
+        }
+
+        GIVEN("A list of strings") {
+            List list;
+            list.push_back("short");
+            list.push_back("a string that does not fit inline");
+
+            THEN("The strings should be accessible as Values") {
+                REQUIRE(list.element_type() == JSONJay::BaseDataType::STRING);
+                REQUIRE(list.strings()[1].as_string() == "a string that does not fit inline");
+            }
+        }
+    }
+
     SECTION("Iterating over the list") {
         GIVEN("A list with elements") {
             List list;
@@ -109,7 +278,7 @@ TEST_CASE("List operations", "[List]") {
             WHEN("Iterating over the list") {
                 size_t sum = 0;
                 for (const auto& [element, type] : list) {
-                    sum += std::get<int>(element);
+                    sum += element.get<int>();
                 }
 
                 THEN("The sum of the elements should be correct") {
@@ -185,11 +354,21 @@ TEST_CASE("List operations", "[List]") {
                 REQUIRE_THROWS_AS(list.at<List*>(0), JSONJay::InvalidTypeException);
             }
             AND_THEN("The elements should be accessible with the operator[] method") {
-                REQUIRE(std::get<int>(list[0]) == 1);
-                REQUIRE(std::get<double>(list[1]) == 2.0);
-                REQUIRE(std::get<std::string>(list[2]) == "Hello");
-                REQUIRE(std::get<bool>(list[3]) == true);
-                REQUIRE(std::get<Object*>(list[4])->empty());
+                REQUIRE(list[0].get<int>() == 1);
+                REQUIRE(list[1].get<double>() == 2.0);
+                REQUIRE(list[2].get<std::string>() == "Hello");
+                REQUIRE(list[3].get<bool>() == true);
+                REQUIRE(list[4].get<Object*>()->empty());
+            }
+            AND_THEN("The elements should be accessible without exceptions") {
+                REQUIRE(*list.get_if<int>(0) == 1);
+                REQUIRE(list.get_if<int>(1) == nullptr);
+                REQUIRE(list.get_if<Object>(4)->empty());
+                REQUIRE(list.get_if<bool>(5) == nullptr);
+                REQUIRE(list.try_get<std::string>(2).value() == "Hello");
+                REQUIRE(list.try_get<double>(0).error() == JSONJay::LookupError::INVALID_TYPE);
+                REQUIRE(list.try_get<double>(5).error() == JSONJay::LookupError::INVALID_INDEX);
+                REQUIRE_FALSE(list.find(5).has_value());
             }
         }
     }
@@ -0,0 +1,142 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "MappedWriter.hpp"
+#include "MappedDocument.hpp"
+#include "JSONParser.hpp"
+#include "BufferStreamWritinator.hpp"
+#include "Exceptions.hpp"
+
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+using JSONJay::BaseDataType;
+using JSONJay::BufferStreamWritinator;
+using JSONJay::Document;
+using JSONJay::JSONParser;
+using JSONJay::MappedDocument;
+using JSONJay::MappedWriter;
+
+namespace {
+
+// stands in for a file mapping, which is page aligned
+struct Image {
+    std::vector<uint64_t> words;
+    size_t size;
+
+    explicit Image(const std::vector<char>& bytes) : words((bytes.size() + 7) / 8), size(bytes.size()) {
+        std::memcpy(words.data(), bytes.data(), bytes.size());
+    }
+
+    std::span<const char> bytes() const {
+        return std::span<const char>(reinterpret_cast<const char*>(words.data()), size);
+    }
+};
+
+Image image_of(const Document& document) {
+    BufferStreamWritinator stream;
+    MappedWriter writer;
+    REQUIRE(writer.write(stream, document));
+    return Image(stream.getBuffer());
+}
+
+} // namespace
+
+TEST_CASE("Mapped documents", "[MappedDocument]") {
+    std::string text = R"({"name":"JSON-Jay","description":"a string that does not fit inline",)"
+        R"("count":-3,"ratio":0.25,"flag":true,"nothing":null,"ints":[1,-2,300000],)"
+        R"("doubles":[0.5,1e300],"bools":[true,false],"mixed":[1,"two",[3],{"four":4.5}],"empty":{}})";
+    JSONParser parser;
+    Image image = image_of(parser.parse(text));
+
+    SECTION("Lookups") {
+        GIVEN("An image of an Object with values of every type") {
+            MappedDocument document(image.bytes());
+
+            THEN("Every value should be read in place") {
+                REQUIRE(document.root().type() == BaseDataType::OBJECT);
+                REQUIRE(document["name"].get_string() == "JSON-Jay");
+                REQUIRE(document["description"].get_string() == "a string that does not fit inline");
+                REQUIRE(document["count"].get_int() == -3);
+                REQUIRE(document["ratio"].get_double() == 0.25);
+                REQUIRE(document["flag"].get_bool());
+                REQUIRE(document["nothing"].is_null());
+                REQUIRE(document["mixed"][1].get_string() == "two");
+                REQUIRE(document["mixed"][2][0].get_int() == 3);
+                REQUIRE(document["mixed"][3]["four"].get_double() == 4.5);
+                REQUIRE(document["empty"].as_object().empty());
+            }
+
+            THEN("Typed Lists should be packed arrays") {
+                JSONJay::MappedList ints = document["ints"].as_list();
+                REQUIRE(ints.element_type() == BaseDataType::INT);
+                REQUIRE(std::vector<int>(ints.ints().begin(), ints.ints().end()) == std::vector<int>{ 1, -2, 300000 });
+                REQUIRE(ints[2].get_int() == 300000);
+                REQUIRE(document["doubles"].as_list().doubles()[1] == 1e300);
+                REQUIRE(document["doubles"][0].get_double() == 0.5);
+                REQUIRE(document["bools"].as_list().bools()[0]);
+                REQUIRE_FALSE(document["bools"][1].get_bool());
+                REQUIRE(document["mixed"].as_list().element_type() == BaseDataType::NONE);
+            }
+
+            THEN("Members should be in key order") {
+                JSONJay::MappedObject root = document.root().as_object();
+                REQUIRE(root.size() == 11);
+                for ( size_t i = 1; i < root.size(); i++ ) REQUIRE(root.key(i - 1) < root.key(i));
+                REQUIRE(root.contains("ratio"));
+                REQUIRE_FALSE(root.contains("missing"));
+            }
+
+            THEN("Wrong lookups should throw") {
+                REQUIRE_THROWS_AS(document["missing"], JSONJay::InvalidKeyException);
+                REQUIRE_THROWS_AS(document["count"].get_string(), JSONJay::InvalidTypeException);
+                REQUIRE_THROWS_AS(document["ints"][3], JSONJay::InvalidIndexException);
+                REQUIRE_THROWS_AS(document["mixed"].as_list().ints(), JSONJay::InvalidTypeException);
+                REQUIRE_THROWS_AS(document[0], JSONJay::InvalidTypeException);
+            }
+        }
+
+        GIVEN("An image of a large Object") {
+            std::string wide = "{";
+            for ( int i = 0; i < 500; i++ ) wide += (i > 0 ? ",\"key" : "\"key") + std::to_string(i) + "\":" + std::to_string(i);
+            wide += "}";
+            Image wideImage = image_of(parser.parse(wide));
+            MappedDocument document(wideImage.bytes());
+
+            THEN("Every key should be found") {
+                for ( int i = 0; i < 500; i++ ) REQUIRE(document["key" + std::to_string(i)].get_int() == i);
+            }
+        }
+    }
+
+    SECTION("Invalid images") {
+        GIVEN("Broken images") {
+            THEN("Opening or reading them should throw") {
+                std::vector<char> bytes(image.bytes().begin(), image.bytes().end());
+
+                Image truncated(std::vector<char>(bytes.begin(), bytes.end() - 8));
+                REQUIRE_THROWS_AS(MappedDocument(truncated.bytes()), JSONJay::InvalidFormatException);
+
+                std::vector<char> wrongMagic = bytes;
+                wrongMagic[0] = 'X';
+                REQUIRE_THROWS_AS(MappedDocument(Image(wrongMagic).bytes()), JSONJay::InvalidFormatException);
+
+                std::vector<char> wrongByteOrder = bytes;
+                std::swap(wrongByteOrder[4], wrongByteOrder[7]);
+                REQUIRE_THROWS_AS(MappedDocument(Image(wrongByteOrder).bytes()), JSONJay::InvalidFormatException);
+
+                Image shifted(std::vector<char>(bytes.size() + 1));
+                REQUIRE_THROWS_AS(MappedDocument(shifted.bytes().subspan(1)), JSONJay::InvalidFormatException);
+
+                // point the root past the end of the image
+                std::vector<char> wrongRoot = bytes;
+                uint32_t offset = 0xFFFFFF00;
+                std::memcpy(wrongRoot.data() + 20, &offset, sizeof(offset));
+                Image wrongRootImage(wrongRoot);
+                MappedDocument document(wrongRootImage.bytes());
+                REQUIRE_THROWS_AS(document["name"], JSONJay::InvalidFormatException);
+            }
+        }
+    }
+}
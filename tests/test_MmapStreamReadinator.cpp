@@ -0,0 +1,96 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "MmapStreamReadinator.hpp"
+#include "FileStreamWritinator.hpp"
+#include "MappedWriter.hpp"
+#include "MappedDocument.hpp"
+#include "JSONParser.hpp"
+
+#include <filesystem>
+#include <string>
+
+using JSONJay::FileStreamWritinator;
+using JSONJay::JSONParser;
+using JSONJay::MappedDocument;
+using JSONJay::MappedWriter;
+using JSONJay::MmapAdvice;
+using JSONJay::MmapStreamReadinator;
+
+namespace {
+
+std::string temp_file(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("JSONJay_" + name)).string();
+}
+
+} // namespace
+
+TEST_CASE("Memory mapped reading", "[MmapStreamReadinator]") {
+    SECTION("Reading") {
+        GIVEN("A file with raw values") {
+            std::string filename = temp_file("mmap_raw.bin");
+            {
+                FileStreamWritinator stream(filename);
+                stream.writeRaw<uint32_t>(0xDEADBEEF);
+                stream.writeRaw<double>(2.5);
+                stream.writeData("tail", 4);
+            }
+            MmapStreamReadinator stream(filename);
+
+            THEN("The values should be read from the mapping") {
+                REQUIRE(stream.isStreamGood());
+                REQUIRE(stream.bytes().size() == 16);
+                uint32_t word = 0;
+                double number = 0;
+                REQUIRE(stream.readRaw(word));
+                REQUIRE(stream.readRaw(number));
+                REQUIRE(word == 0xDEADBEEF);
+                REQUIRE(number == 2.5);
+
+                char tail[8] = {};
+                REQUIRE(stream.readSome(tail, 8) == 4);
+                REQUIRE(std::string(tail) == "tail");
+                REQUIRE(stream.readSome(tail, 8) == 0);
+            }
+
+            THEN("Seeking and reading past the end should work like the other readinators") {
+                stream.advise(MmapAdvice::RANDOM);
+                stream.setStreamPosition(12);
+                uint32_t word = 0;
+                REQUIRE(stream.readRaw(word));
+                REQUIRE(stream.getStreamPosition() == 16);
+                REQUIRE_FALSE(stream.readRaw(word));
+                REQUIRE_FALSE(stream.isStreamGood());
+            }
+            std::filesystem::remove(filename);
+        }
+
+        GIVEN("A mapped document in a file") {
+            std::string filename = temp_file("mmap_document.bin");
+            {
+                JSONParser parser;
+                FileStreamWritinator stream(filename);
+                MappedWriter writer;
+                REQUIRE(writer.write(stream, parser.parse(R"({"values":[1,2,3],"name":"mapped"})")));
+            }
+            MmapStreamReadinator stream(filename, MmapAdvice::WILLNEED);
+
+            THEN("It should be readable in place") {
+                MappedDocument document(stream.bytes());
+                REQUIRE(document["name"].get_string() == "mapped");
+                REQUIRE(document["values"].as_list().ints()[2] == 3);
+            }
+            std::filesystem::remove(filename);
+        }
+
+        GIVEN("A file that does not exist") {
+            MmapStreamReadinator stream(temp_file("mmap_missing.bin"));
+
+            THEN("The stream should be bad") {
+                char c;
+                REQUIRE_FALSE(stream.isStreamGood());
+                REQUIRE(stream.bytes().empty());
+                REQUIRE_FALSE(stream.readData(&c, 1));
+            }
+        }
+    }
+}
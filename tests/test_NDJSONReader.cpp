@@ -0,0 +1,118 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "NDJSONReader.hpp"
+#include "ThreadPool.hpp"
+#include "BufferStreamReadinator.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+using JSONJay::BatchOrder;
+using JSONJay::BufferStreamReadinator;
+using JSONJay::NDJSONBatch;
+using JSONJay::NDJSONReader;
+using JSONJay::ThreadPool;
+
+TEST_CASE("Thread pool", "[ThreadPool]") {
+    SECTION("Tasks") {
+        GIVEN("A pool with several workers") {
+            ThreadPool pool(4);
+            std::atomic<int> total = 0;
+            std::atomic<size_t> highestWorker = 0;
+
+            THEN("Every task and every task it submits should run") {
+                for ( int i = 0; i < 100; i++ ) {
+                    pool.submit([&pool, &total, &highestWorker](size_t worker) {
+                        size_t seen = highestWorker;
+                        while ( worker > seen && !highestWorker.compare_exchange_weak(seen, worker) ) {}
+                        total += 1;
+                        pool.submit([&total](size_t) { total += 10; });
+                    });
+                }
+                pool.wait();
+                REQUIRE(total == 1100);
+                REQUIRE(highestWorker < pool.size());
+            }
+
+            THEN("Exceptions should be rethrown by wait") {
+                pool.submit([](size_t) { throw JSONJay::InvalidValueException("failed"); });
+                pool.submit([&total](size_t) { total += 1; });
+                REQUIRE_THROWS_AS(pool.wait(), JSONJay::InvalidValueException);
+                REQUIRE(total == 1);
+                REQUIRE_NOTHROW(pool.wait());
+            }
+        }
+    }
+}
+
+TEST_CASE("NDJSON reading", "[NDJSONReader]") {
+    std::string text;
+    for ( int i = 0; i < 5000; i++ ) {
+        text += R"({"id":)" + std::to_string(i) + R"(,"message":"line )" + std::to_string(i) + "\"}\n";
+        if ( i % 1000 == 0 ) text += "\n \r\n";
+    }
+
+    SECTION("Batches") {
+        GIVEN("Text in memory") {
+            NDJSONReader reader(4, 4096);
+
+            THEN("Ordered batches should arrive in input order") {
+                std::vector<int> ids;
+                size_t expectedBatch = 0;
+                size_t count = reader.read(text, [&](NDJSONBatch& batch) {
+                    REQUIRE(batch.index == expectedBatch++);
+                    for ( JSONJay::Document& document : batch.documents ) ids.push_back(document.object().get_int("id"));
+                });
+                REQUIRE(count == 5000);
+                REQUIRE(ids.size() == 5000);
+                for ( int i = 0; i < 5000; i++ ) REQUIRE(ids[i] == i);
+            }
+
+            THEN("Unordered batches should hold every line once") {
+                std::vector<int> ids;
+                size_t count = reader.read(text, [&](NDJSONBatch& batch) {
+                    for ( JSONJay::Document& document : batch.documents ) ids.push_back(document.object().get_int("id"));
+                }, BatchOrder::UNORDERED);
+                std::sort(ids.begin(), ids.end());
+                REQUIRE(count == 5000);
+                for ( int i = 0; i < 5000; i++ ) REQUIRE(ids[i] == i);
+            }
+        }
+
+        GIVEN("Text from a stream without a final line end") {
+            std::string stream = text + R"(["last"])";
+            BufferStreamReadinator readinator(std::vector<char>(stream.begin(), stream.end()));
+            NDJSONReader reader(3, 1000);
+
+            THEN("Every line should be read") {
+                std::vector<std::string> lines;
+                size_t count = reader.read(readinator, [&](NDJSONBatch& batch) {
+                    for ( JSONJay::Document& document : batch.documents ) {
+                        if ( document.root_type() == JSONJay::BaseDataType::LIST )
+                            lines.emplace_back(document.list().get_string(0));
+                        else
+                            lines.emplace_back(document.object().get_string("message"));
+                    }
+                });
+                REQUIRE(count == 5001);
+                REQUIRE(lines[4321] == "line 4321");
+                REQUIRE(lines.back() == "last");
+            }
+        }
+    }
+
+    SECTION("Errors") {
+        GIVEN("A malformed line") {
+            std::string broken = text + "{\"id\": }\n" + text;
+            NDJSONReader reader(2, 2048);
+
+            THEN("Reading should throw") {
+                REQUIRE_THROWS_AS(reader.read(broken, [](NDJSONBatch&) {}), JSONJay::InvalidFormatException);
+                REQUIRE(reader.read(text, [](NDJSONBatch&) {}) == 5000);
+            }
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+#include "Numeric.hpp"
+#include "List.hpp"
+#include "Object.hpp"
+
+#include <vector>
+
+using JSONJay::List;
+using JSONJay::numeric::Compare;
+using JSONJay::numeric::Isa;
+
+namespace numeric = JSONJay::numeric;
+
+TEST_CASE("Numeric kernels", "[Numeric]") {
+    std::vector<double> doubles;
+    std::vector<int> ints;
+    for ( int i = 0; i < 1003; i++ ) {
+        doubles.push_back((i % 17) * 0.25 - 2.0);
+        ints.push_back((i * 7919) % 2001 - 1000);
+    }
+
+    SECTION("Every instruction set") {
+        GIVEN("The kernels of every supported instruction set") {
+            Isa detected = numeric::detected_isa();
+            std::vector<Isa> isas;
+            for ( Isa isa : { Isa::SCALAR, Isa::SSE2, Isa::AVX2 } )
+                if ( isa <= detected ) isas.push_back(isa);
+
+            double doubleSum = 0;
+            long long intSum = 0;
+            size_t greater = 0, notEqual = 0;
+            for ( double value : doubles ) doubleSum += value;
+            for ( int value : ints ) {
+                intSum += value;
+                greater += value > 10;
+                notEqual += value != -1000;
+            }
+
+            THEN("The results should match a plain loop") {
+                for ( Isa isa : isas ) {
+                    REQUIRE(numeric::set_isa(isa) == isa);
+                    REQUIRE(numeric::active_isa() == isa);
+
+                    REQUIRE(numeric::sum(doubles) == Catch::Approx(doubleSum));
+                    REQUIRE(numeric::sum(ints) == intSum);
+                    REQUIRE(numeric::minmax(doubles).min == -2.0);
+                    REQUIRE(numeric::minmax(doubles).max == 2.0);
+                    REQUIRE(numeric::minmax(ints).min == -1000);
+                    REQUIRE(numeric::minmax(ints).max == 1000);
+                    REQUIRE(numeric::count_if(ints, Compare::GREATER, 10) == greater);
+                    REQUIRE(numeric::count_if(ints, Compare::NOT_EQUAL, -1000) == notEqual);
+                    REQUIRE(numeric::count_if(doubles, Compare::LESS_EQUAL, -2.0) == 59);
+                }
+                numeric::set_isa(detected);
+            }
+
+            THEN("Transforms should touch every element") {
+                for ( Isa isa : isas ) {
+                    numeric::set_isa(isa);
+                    std::vector<double> converted(ints.size());
+                    numeric::convert(ints, converted);
+                    numeric::scale(converted, 0.5);
+                    for ( size_t i = 0; i < ints.size(); i++ )
+                        REQUIRE(converted[i] == ints[i] * 0.5);
+                }
+                numeric::set_isa(detected);
+            }
+        }
+    }
+
+    SECTION("Empty ranges") {
+        REQUIRE(numeric::sum(std::span<const double>()) == 0.0);
+        REQUIRE_THROWS_AS(numeric::minmax(std::span<const int>()), JSONJay::InvalidValueException);
+    }
+}
+
+TEST_CASE("Numeric kernels over Lists", "[Numeric]") {
+    SECTION("Homogeneous lists") {
+        GIVEN("A list of integers") {
+            List list;
+            for ( int i = 1; i <= 100; i++ ) list.push_back(i);
+
+            THEN("Reductions should run over the integers") {
+                REQUIRE(numeric::sum(list) == 5050.0);
+                REQUIRE(numeric::mean(list) == 50.5);
+                REQUIRE(numeric::minmax(list).max == 100.0);
+                REQUIRE(numeric::count_if(list, Compare::GREATER, 90.0) == 10);
+                REQUIRE(numeric::count_if(list, Compare::GREATER, 90.5) == 10);
+            }
+
+            WHEN("Scaling the list") {
+                numeric::scale(list, 2.0);
+
+                THEN("The list should hold doubles") {
+                    REQUIRE(list.element_type() == JSONJay::BaseDataType::DOUBLE);
+                    REQUIRE(list.doubles()[99] == 200.0);
+                }
+            }
+        }
+    }
+
+    SECTION("Mixed lists") {
+        GIVEN("A list of integers and doubles") {
+            List list;
+            list.push_back(1);
+            list.push_back(2.5);
+            list.push_back(-3);
+
+            THEN("Reductions should still work") {
+                REQUIRE(numeric::sum(list) == 0.5);
+                REQUIRE(numeric::minmax(list).min == -3.0);
+                REQUIRE(numeric::count_if(list, Compare::LESS, 2.0) == 2);
+            }
+
+            WHEN("Converting the list to doubles") {
+                list.convert_to_doubles();
+
+                THEN("The list should be homogeneous") {
+                    REQUIRE(list.element_type() == JSONJay::BaseDataType::DOUBLE);
+                    REQUIRE(list.get_double(2) == -3.0);
+                }
+            }
+        }
+
+        GIVEN("A list with a string") {
+            List list;
+            list.push_back(1);
+            list.push_back("one");
+
+            THEN("The kernels should refuse it") {
+                REQUIRE_THROWS_AS(numeric::sum(list), JSONJay::InvalidTypeException);
+                REQUIRE_THROWS_AS(list.convert_to_doubles(), JSONJay::InvalidTypeException);
+                REQUIRE(list.get_int(0) == 1);
+            }
+        }
+    }
+}
@@ -1,5 +1,12 @@
 #include "catch2/catch_test_macros.hpp"
 
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <memory_resource>
+#include <new>
+#include <string>
+
 #define private public
 #define protected public
 
@@ -12,6 +19,39 @@
 using JSONJay::Object;
 using JSONJay::List;
 
+namespace {
+
+/**
+ * @brief memory resource that fails once a number of blocks were handed out
+ */
+class FailingResource : public std::pmr::memory_resource {
+public:
+    size_t limit;
+    size_t allocations = 0;
+    size_t bytes = 0;   ///< the bytes currently handed out
+
+    explicit FailingResource(size_t limit) : limit(limit) {}
+
+private:
+    void* do_allocate(size_t size, size_t alignment) override {
+        if ( allocations == limit ) throw std::bad_alloc();
+        ++allocations;
+        bytes += size;
+        return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+
+    void do_deallocate(void* p, size_t size, size_t alignment) override {
+        bytes -= size;
+        std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
 TEST_CASE("Object operations", "[Object]") {
     SECTION("Empty object") {
         GIVEN("An empty object") {
@@ -137,6 +177,290 @@ TEST_CASE("Object operations", "[Object]") {
         }
     }
 
+    SECTION("Many members") {
+        GIVEN("An object with more members than the hash threshold") {
+            JSONJay::Object obj;
+            const int count = 200;
+            for ( int i = 0; i < count; i++ )
+                obj.set("key" + std::to_string(i), i);
+
+            THEN("The object should use the hash index") {
+                REQUIRE(obj.size() == count);
+                REQUIRE(obj.mData.hashed());
+            }
+
+            THEN("All members should be accessible") {
+                for ( int i = 0; i < count; i++ )
+                    REQUIRE(obj.get_int("key" + std::to_string(i)) == i);
+                REQUIRE_FALSE(obj.check_key_exists("key200"));
+            }
+
+            WHEN("Erasing most of the members") {
+                for ( int i = 0; i < count; i += 2 )
+                    obj.erase("key" + std::to_string(i));
+                for ( int i = 1; i < count - 6; i += 2 )
+                    obj.erase("key" + std::to_string(i));
+
+                THEN("The object should fall back to the sorted vector") {
+                    REQUIRE(obj.size() == 3);
+                    REQUIRE_FALSE(obj.mData.hashed());
+                }
+
+                THEN("The remaining members should be accessible") {
+                    REQUIRE(obj.get_int("key195") == 195);
+                    REQUIRE(obj.get_int("key197") == 197);
+                    REQUIRE(obj.get_int("key199") == 199);
+                    REQUIRE_FALSE(obj.check_key_exists("key193"));
+                }
+            }
+
+            AND_WHEN("Overwriting members") {
+                for ( int i = 0; i < count; i++ )
+                    obj.set("key" + std::to_string(i), -i);
+
+                THEN("The size should not change") {
+                    REQUIRE(obj.size() == count);
+                    REQUIRE(obj.get_int("key42") == -42);
+                }
+            }
+        }
+    }
+
+    SECTION("Member order") {
+        GIVEN("An object growing past the hash threshold and shrinking again") {
+            JSONJay::Object obj;
+            auto keysSorted = [&obj] {
+                const JSONJay::MemberStore& members = obj.members();
+                return std::is_sorted(members.begin(), members.end(),
+                    [](const auto& lhs, const auto& rhs) { return lhs.key() < rhs.key(); });
+            };
+
+            THEN("The members should be iterated in key order at every size") {
+                const int count = 3 * static_cast<int>(JSONJay::MemberStore::kHashThreshold);
+                for ( int i = count; i > 0; i-- ) {
+                    obj.set("key" + std::to_string(i * 7 % count), i);
+                    REQUIRE(keysSorted());
+                }
+                REQUIRE(obj.mData.hashed());
+
+                for ( int i = 0; i < count - 3; i++ ) {
+                    obj.erase("key" + std::to_string(i * 5 % count));
+                    REQUIRE(keysSorted());
+                }
+                REQUIRE_FALSE(obj.mData.hashed());
+                REQUIRE(obj.size() == 3);
+                REQUIRE(obj.get_int("key" + std::to_string((count - 1) * 5 % count)) != 0);
+            }
+        }
+    }
+
+    SECTION("Failing allocations") {
+        GIVEN("Objects whose allocations fail at every point of filling them") {
+            THEN("No key should leak") {
+                bool completed = false;
+                for ( size_t limit = 0; !completed; limit++ ) {
+                    FailingResource resource(limit);
+                    {
+                        Object obj{ Object::allocator_type(&resource) };
+                        try {
+                            for ( int i = 0; i < 100; i++ )
+                                obj.set("a_key_that_is_long_enough_" + std::to_string(i), i);
+                            completed = true;
+                        } catch ( const std::bad_alloc& ) {}
+                    }
+                    REQUIRE(resource.bytes == 0);
+                }
+            }
+        }
+    }
+
+    SECTION("Inserting in place") {
+        GIVEN("An object with elements") {
+            JSONJay::Object obj;
+            obj.set("key1", 1);
+            obj.set("key2", "Hello");
+
+            WHEN("Emplacing new members") {
+                obj.emplace<int>("key3", 3) += 1;
+                std::string_view text = obj.emplace<std::string>("key4", "A string that does not fit inline");
+                Object& nested = obj.emplace<Object>("key5");
+                nested.set("inner", true);
+
+                THEN("The members should be constructed in place") {
+                    REQUIRE(obj.get_int("key3") == 4);
+                    REQUIRE(text == "A string that does not fit inline");
+                    REQUIRE(obj.get_string("key4") == text);
+                    REQUIRE(obj.get_object("key5").get_bool("inner"));
+                    REQUIRE(obj.size() == 5);
+                }
+            }
+
+            WHEN("Emplacing an existing key") {
+                THEN("An exception should be thrown and the value kept") {
+                    REQUIRE_THROWS_AS(obj.emplace<int>("key1", 5), JSONJay::InvalidKeyException);
+                    REQUIRE(obj.get_int("key1") == 1);
+                }
+            }
+
+            WHEN("Trying to emplace") {
+                auto [existing, existingInserted] = obj.try_emplace<int>("key1", 5);
+                auto [added, addedInserted] = obj.try_emplace<List>("key3");
+
+                THEN("Only missing keys should be inserted") {
+                    REQUIRE_FALSE(existingInserted);
+                    REQUIRE(existing == 1);
+                    REQUIRE(addedInserted);
+                    REQUIRE(added.empty());
+                    REQUIRE(obj.size() == 3);
+                }
+
+                THEN("Existing keys of another type should throw") {
+                    REQUIRE_THROWS_AS(obj.try_emplace<double>("key2", 1.0), JSONJay::InvalidTypeException);
+                }
+            }
+
+            WHEN("Inserting or assigning") {
+                bool replaced = !obj.insert_or_assign("key2", 2.5);
+                bool inserted = obj.insert_or_assign("key3", Object());
+
+                THEN("Values of any type should be replaced") {
+                    REQUIRE(replaced);
+                    REQUIRE(inserted);
+                    REQUIRE(obj.get_double("key2") == 2.5);
+                    REQUIRE(obj.get_type("key3") == JSONJay::BaseDataType::OBJECT);
+                }
+            }
+
+            WHEN("Setting a nested object by move") {
+                Object nested;
+                nested.set("inner", 7);
+                obj.set("key3", std::move(nested));
+
+                THEN("The contents should move over") {
+                    REQUIRE(obj.get_object("key3").get_int("inner") == 7);
+                }
+            }
+
+            WHEN("Using invalid keys") {
+                THEN("Nothing should be inserted") {
+                    REQUIRE_THROWS_AS(obj.set("", 1), JSONJay::InvalidKeyException);
+                    REQUIRE_THROWS_AS(obj.emplace<int>("a key", 1), JSONJay::InvalidKeyException);
+                    REQUIRE_THROWS_AS(obj.insert_or_assign("a\tkey", 1), JSONJay::InvalidKeyException);
+                    REQUIRE(obj.size() == 2);
+                }
+            }
+        }
+    }
+
+    SECTION("Looking up keys without a std::string") {
+        GIVEN("An object with long keys") {
+            JSONJay::Object obj;
+            obj.set("a_key_too_long_for_small_strings_1", 1);
+            obj.set("a_key_too_long_for_small_strings_2", "Hello");
+            obj.set("a_key_too_long_for_small_strings_3", new Object());
+            std::string_view view = "a_key_too_long_for_small_strings_1";
+
+            WHEN("Reading with literal and string_view keys") {
+                test::AllocationCounter counter;
+                int number = obj.get_int(view);
+                std::string_view text = obj.get_string("a_key_too_long_for_small_strings_2");
+                bool found = obj.check_key_exists("a_key_too_long_for_small_strings_3");
+                JSONJay::BaseDataType type = obj.get_type("a_key_too_long_for_small_strings_3");
+                size_t allocations = counter.count();
+
+                THEN("Nothing should be allocated") {
+                    REQUIRE(allocations == 0);
+                    REQUIRE(number == 1);
+                    REQUIRE(text == "Hello");
+                    REQUIRE(found);
+                    REQUIRE(type == JSONJay::BaseDataType::OBJECT);
+                }
+            }
+
+            WHEN("Erasing with a string_view key") {
+                obj.erase(view);
+
+                THEN("The member should be gone") {
+                    REQUIRE_FALSE(obj.check_key_exists(view));
+                    REQUIRE(obj.size() == 2);
+                }
+            }
+        }
+    }
+
+    SECTION("Prehashed keys") {
+        static constexpr JSONJay::Key kNumber("number");
+        static constexpr JSONJay::Key kNested("nested");
+        static_assert(kNumber.hash() == JSONJay::hash_key("number"));
+
+        GIVEN("An object with more members than the hash threshold") {
+            JSONJay::Object obj;
+            for ( int i = 0; i < 20; i++ )
+                obj.set("key" + std::to_string(i), i);
+            obj.set(kNumber, 42);
+            obj.set(kNested, Object());
+
+            THEN("Members should be accessible by Key and by name") {
+                REQUIRE(obj.get_int(kNumber) == 42);
+                REQUIRE(obj.at<int>(kNumber) == obj.get_int("number"));
+                REQUIRE(obj.get_type(kNested) == JSONJay::BaseDataType::OBJECT);
+                REQUIRE(obj.get_object(kNested).empty());
+                REQUIRE(obj.get_int(JSONJay::Key("key7")) == 7);
+            }
+
+            THEN("Missing keys should throw") {
+                REQUIRE_THROWS_AS(obj.get_int(JSONJay::Key("missing")), JSONJay::InvalidKeyException);
+            }
+        }
+
+        GIVEN("An invalid name") {
+            THEN("Building a Key should throw") {
+                REQUIRE_THROWS_AS(JSONJay::Key(""), JSONJay::InvalidKeyException);
+                REQUIRE_THROWS_AS(JSONJay::Key("a key"), JSONJay::InvalidKeyException);
+            }
+        }
+    }
+
+    SECTION("Looking up without exceptions") {
+        GIVEN("An object with a nested object") {
+            JSONJay::Object obj;
+            obj.set("number", 1);
+            obj.set("text", "Hello");
+            Object& user = obj.emplace<Object>("user");
+            user.set("id", 7);
+
+            THEN("Existing values should be found") {
+                REQUIRE(obj.find("number") != nullptr);
+                REQUIRE(*obj.get_if<int>("number") == 1);
+                REQUIRE(obj.get_if<Object>("user") == &user);
+                REQUIRE(obj.try_get<std::string>("text").value() == "Hello");
+                REQUIRE(obj.try_get<int>(JSONJay::Key("number")).value() == 1);
+            }
+
+            THEN("Missing keys and other types should not throw") {
+                REQUIRE(obj.find("missing") == nullptr);
+                REQUIRE(obj.find("an invalid key") == nullptr);
+                REQUIRE(obj.get_if<int>("missing") == nullptr);
+                REQUIRE(obj.get_if<double>("number") == nullptr);
+                REQUIRE(obj.try_get<int>("missing").error() == JSONJay::LookupError::MISSING_KEY);
+                REQUIRE(obj.try_get<List>("user").error() == JSONJay::LookupError::INVALID_TYPE);
+                REQUIRE(obj.try_get<int>("missing").value_or(3) == 3);
+            }
+
+            THEN("Lookups should chain") {
+                auto id = obj.try_get<Object>("user").and_then([](Object& o) { return o.try_get<int>("id"); });
+                auto name = obj.try_get<Object>("user").and_then([](Object& o) { return o.try_get<std::string>("name"); });
+                auto deep = obj.try_get<Object>("missing").and_then([](Object& o) { return o.try_get<int>("id"); });
+
+                REQUIRE(id.has_value());
+                REQUIRE(*id == 7);
+                REQUIRE(name.error() == JSONJay::LookupError::MISSING_KEY);
+                REQUIRE(deep.error() == JSONJay::LookupError::MISSING_KEY);
+                REQUIRE_THROWS_AS(deep.value(), JSONJay::InvalidKeyException);
+            }
+        }
+    }
+
     SECTION("Getting Types") {
         GIVEN("An object with elements") {
             JSONJay::Object obj;
@@ -0,0 +1,159 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "ParallelParser.hpp"
+#include "JSONParser.hpp"
+#include "JSONWriter.hpp"
+#include "StructuralIndex.hpp"
+#include "ThreadPool.hpp"
+#include "BufferStreamWritinator.hpp"
+#include "Exceptions.hpp"
+
+#include <string>
+#include <vector>
+
+using JSONJay::BaseDataType;
+using JSONJay::BufferStreamWritinator;
+using JSONJay::Document;
+using JSONJay::Isa;
+using JSONJay::JSONParser;
+using JSONJay::JSONWriter;
+using JSONJay::ParallelParser;
+using JSONJay::StructuralIndex;
+using JSONJay::ThreadPool;
+
+namespace {
+
+std::string text_of(const Document& document) {
+    BufferStreamWritinator stream;
+    JSONWriter writer;
+    writer.write(stream, document);
+    return std::string(stream.getBuffer().begin(), stream.getBuffer().end());
+}
+
+// strings full of brackets, quotes and escapes make the speculative
+// string state of many chunks wrong
+std::string mixed_array(int count) {
+    std::string text = "[";
+    for ( int i = 0; i < count; i++ ) {
+        if ( i > 0 ) text += i % 7 == 0 ? ",\n  " : ",";
+        switch ( i % 5 ) {
+            case 0: text += std::to_string(i); break;
+            case 1: text += R"("]}, [{ \"quoted\" \\)" + std::to_string(i) + R"(\\\" [")"; break;
+            case 2: text += R"({"id":)" + std::to_string(i) + R"(,"tags":["a,b","[c]"],"ratio":0.5})"; break;
+            case 3: text += R"([true,false,null,")" + std::string(i % 97, 'y') + R"("])"; break;
+            default: text += R"("é\"\\\"")"; break;
+        }
+    }
+    return text + "]";
+}
+
+} // namespace
+
+TEST_CASE("Parallel structural index", "[ParallelParser]") {
+    SECTION("Indexing") {
+        GIVEN("A large text and a pool") {
+            std::string text = mixed_array(20000);
+            ThreadPool pool(4);
+
+            THEN("The positions should match the sequential index for every instruction set") {
+                for ( Isa isa : { Isa::SCALAR, Isa::SSE2, Isa::AVX2 } ) {
+                    StructuralIndex sequential;
+                    StructuralIndex parallel;
+                    sequential.build(text, isa);
+                    parallel.build(text, pool, isa);
+                    REQUIRE(std::vector<uint32_t>(parallel.positions().begin(), parallel.positions().end()) ==
+                        std::vector<uint32_t>(sequential.positions().begin(), sequential.positions().end()));
+                }
+            }
+        }
+    }
+
+    SECTION("Errors") {
+        GIVEN("A large text with an unterminated string") {
+            std::string text = mixed_array(20000);
+            text.insert(text.size() / 2, "\"");
+            ThreadPool pool(4);
+            StructuralIndex index;
+
+            THEN("Building should throw") {
+                REQUIRE_THROWS_AS(index.build(text, pool), JSONJay::InvalidFormatException);
+            }
+        }
+    }
+}
+
+TEST_CASE("Parallel parsing", "[ParallelParser]") {
+    std::string text = mixed_array(20000);
+    JSONParser sequential;
+    std::string expected = text_of(sequential.parse(text));
+
+    SECTION("Valid documents") {
+        GIVEN("A large top-level List") {
+            THEN("The Document should match the sequential parser for any number of threads") {
+                for ( size_t threads : { 1, 2, 3, 8 } ) {
+                    ParallelParser parser(threads, 0);
+                    Document document = parser.parse(text);
+                    REQUIRE(document.list().size() == 20000);
+                    REQUIRE(text_of(document) == expected);
+                }
+            }
+        }
+
+        GIVEN("A List of integers") {
+            std::string numbers = "[";
+            for ( int i = 0; i < 50000; i++ ) numbers += (i > 0 ? "," : "") + std::to_string(i);
+            numbers += "]";
+            ParallelParser parser(4, 0);
+            Document document = parser.parse(numbers);
+
+            THEN("The elements should stay in typed storage and in order") {
+                REQUIRE(document.list().element_type() == BaseDataType::INT);
+                REQUIRE(document.list().ints().size() == 50000);
+                REQUIRE(document.list().ints()[0] == 0);
+                REQUIRE(document.list().ints()[49999] == 49999);
+            }
+        }
+
+        GIVEN("Small texts and Object roots") {
+            ParallelParser parser(4, 0);
+
+            THEN("They should parse like with the sequential parser") {
+                REQUIRE(parser.parse("[]").list().empty());
+                REQUIRE(parser.parse(" [ 1 ] ").list().at<int>(0) == 1);
+                REQUIRE(parser.parse(R"({"a":[1,2]})").object().get_list("a").size() == 2);
+            }
+        }
+    }
+
+    SECTION("Invalid documents") {
+        GIVEN("Broken large Lists") {
+            ParallelParser parser(4, 0);
+
+            THEN("Parsing should throw") {
+                REQUIRE_THROWS_AS(parser.parse(text.substr(0, text.size() - 1)), JSONJay::InvalidFormatException);
+                REQUIRE_THROWS_AS(parser.parse(text + "1"), JSONJay::InvalidFormatException);
+                REQUIRE_THROWS_AS(parser.parse("[" + text.substr(1, text.size() - 2) + ",]"), JSONJay::InvalidFormatException);
+                REQUIRE_THROWS_AS(parser.parse("[1,,2]"), JSONJay::InvalidFormatException);
+                REQUIRE_THROWS_AS(parser.parse("[1 2]"), JSONJay::InvalidFormatException);
+                REQUIRE_THROWS_AS(parser.parse("[1,2}"), JSONJay::InvalidFormatException);
+            }
+        }
+    }
+}
+
+TEST_CASE("Appending Documents", "[Document]") {
+    SECTION("Append") {
+        GIVEN("Two List Documents") {
+            JSONParser parser;
+            Document first = parser.parse(R"([1,2])");
+            Document second = parser.parse(R"([3,"a long string that is stored out of line",{"k":[true]}])");
+
+            THEN("The elements of the second should move to the end of the first") {
+                first.append(std::move(second));
+                REQUIRE(first.list().size() == 5);
+                REQUIRE(text_of(first) == R"([1,2,3,"a long string that is stored out of line",{"k":[true]}])");
+                REQUIRE_THROWS_AS(second.list(), JSONJay::InvalidTypeException);
+            }
+        }
+    }
+}
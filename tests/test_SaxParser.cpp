@@ -0,0 +1,148 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "SaxParser.hpp"
+#include "Exceptions.hpp"
+#include "BufferStreamReadinator.hpp"
+#include "AllocationCounter.hpp"
+
+#include <string>
+#include <vector>
+
+using JSONJay::BufferStreamReadinator;
+using JSONJay::SaxParser;
+
+namespace {
+
+/**
+ * @brief handler that records the events as text
+ */
+struct RecordingHandler {
+    std::string events;
+
+    void start_object() { events += "{"; }
+    void end_object() { events += "}"; }
+    void start_list() { events += "["; }
+    void end_list() { events += "]"; }
+    void key(std::string_view text) { events += "k:" + std::string(text) + " "; }
+    void value(std::string_view text) { events += "s:" + std::string(text) + " "; }
+    void value(int number) { events += "i:" + std::to_string(number) + " "; }
+    void value(double number) { events += "d:" + std::to_string(number) + " "; }
+    void value(bool flag) { events += flag ? "true " : "false "; }
+    void value(std::monostate) { events += "null "; }
+};
+
+/**
+ * @brief handler that only counts the events
+ */
+struct CountingHandler {
+    size_t containers = 0;
+    size_t keys = 0;
+    size_t values = 0;
+
+    void start_object() { containers++; }
+    void end_object() {}
+    void start_list() { containers++; }
+    void end_list() {}
+    void key(std::string_view) { keys++; }
+    void value(std::string_view) { values++; }
+    void value(int) { values++; }
+    void value(double) { values++; }
+    void value(bool) { values++; }
+    void value(std::monostate) { values++; }
+};
+
+BufferStreamReadinator reader_of(const std::string& text) {
+    return BufferStreamReadinator(std::vector<char>(text.begin(), text.end()));
+}
+
+} // namespace
+
+TEST_CASE("SAX parsing", "[SaxParser]") {
+    SECTION("Events") {
+        GIVEN("A text with every kind of token") {
+            std::string text = R"( {"name": "JSON-Jay", "list": [1, -2.5, true, false, null, [], {}],)"
+                               R"( "escaped \"key\"": "tab\tand \u00e9", "long": "abcdefghijklmnopqrstuvwxyz"} )";
+            std::string expected = "{k:name s:JSON-Jay k:list [i:1 d:-2.500000 true false null []{}]"
+                                   "k:escaped \"key\" s:tab\tand \xC3\xA9 k:long s:abcdefghijklmnopqrstuvwxyz }";
+
+            THEN("Every chunk size should produce the same events") {
+                for ( size_t chunkSize : { size_t(1), size_t(2), size_t(7), size_t(64), SaxParser::kDefaultChunkSize } ) {
+                    BufferStreamReadinator reader = reader_of(text);
+                    RecordingHandler handler;
+                    SaxParser parser(chunkSize);
+                    parser.parse(reader, handler);
+                    REQUIRE(handler.events == expected);
+                }
+            }
+        }
+
+        GIVEN("Scalar roots") {
+            THEN("They should be reported as single values") {
+                for ( std::string text : { "42", " \"text\" ", "null" } ) {
+                    BufferStreamReadinator reader = reader_of(text);
+                    CountingHandler handler;
+                    SaxParser parser;
+                    parser.parse(reader, handler);
+                    REQUIRE(handler.values == 1);
+                }
+            }
+        }
+    }
+
+    SECTION("Bounded memory") {
+        GIVEN("A large stream") {
+            std::string text = "[";
+            for ( int i = 0; i < 20000; i++ ) {
+                if ( i != 0 ) text += ",";
+                text += R"({"id":)" + std::to_string(i) + R"(,"label":"element \"number\")" + std::to_string(i) + R"(","ok":true})";
+            }
+            text += "]";
+            BufferStreamReadinator reader = reader_of(text);
+            SaxParser parser(4096);
+            CountingHandler handler;
+
+            test::AllocationCounter counter;
+            parser.parse(reader, handler);
+            size_t allocations = counter.count();
+
+            THEN("Every token should be reported") {
+                REQUIRE(handler.containers == 20001);
+                REQUIRE(handler.keys == 60000);
+                REQUIRE(handler.values == 60000);
+            }
+
+            THEN("Memory use should not grow with the text") {
+                REQUIRE(allocations < 16);
+            }
+        }
+    }
+
+    SECTION("Errors") {
+        GIVEN("Malformed texts") {
+            std::vector<std::string> texts = {
+                "", "{", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":}", "{,}", "[}", "{\"a\":1]",
+                "[01]", "[tru]", "[\"abc]", "[\"\\x\"]", "[\"a\nb\"]", "{} []", "{1:2}",
+            };
+
+            THEN("Parsing should throw") {
+                for ( const std::string& text : texts ) {
+                    BufferStreamReadinator reader = reader_of(text);
+                    CountingHandler handler;
+                    SaxParser parser(3);
+                    REQUIRE_THROWS_AS(parser.parse(reader, handler), JSONJay::InvalidFormatException);
+                }
+            }
+        }
+
+        GIVEN("Deeply nested Lists") {
+            std::string text = std::string(SaxParser::kMaxDepth + 1, '[') + std::string(SaxParser::kMaxDepth + 1, ']');
+            BufferStreamReadinator reader = reader_of(text);
+            CountingHandler handler;
+            SaxParser parser;
+
+            THEN("Parsing should stop at the depth limit") {
+                REQUIRE_THROWS_AS(parser.parse(reader, handler), JSONJay::InvalidFormatException);
+            }
+        }
+    }
+}
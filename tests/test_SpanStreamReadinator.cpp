@@ -0,0 +1,154 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "SpanStreamReadinator.hpp"
+#include "BufferStreamReadinator.hpp"
+#include "BufferStreamWritinator.hpp"
+#include "FileStreamReadinator.hpp"
+#include "FileStreamWritinator.hpp"
+#include "BinaryReader.hpp"
+#include "BinaryWriter.hpp"
+#include "JSONParser.hpp"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using JSONJay::BufferStreamReadinator;
+using JSONJay::BufferStreamWritinator;
+using JSONJay::SpanStreamReadinator;
+
+TEST_CASE("Reading borrowed memory", "[SpanStreamReadinator]") {
+    BufferStreamWritinator writer;
+    writer.writeRaw<uint16_t>(7);
+    writer.writeString(std::string_view("borrowed"));
+    writer.writeData("rest", 4);
+    const std::vector<char>& payload = writer.getBuffer();
+
+    SECTION("Views") {
+        GIVEN("A payload owned elsewhere") {
+            SpanStreamReadinator stream(std::span<const char>(payload.data(), payload.size()));
+
+            THEN("Strings and spans should point into the payload") {
+                uint16_t number = 0;
+                REQUIRE(stream.readRaw(number));
+                REQUIRE(number == 7);
+
+                std::string_view string;
+                REQUIRE(stream.readStringView(string));
+                REQUIRE(string == "borrowed");
+                REQUIRE(string.data() >= payload.data());
+                REQUIRE(string.data() < payload.data() + payload.size());
+
+                std::span<const char> rest;
+                REQUIRE_FALSE(stream.readSpan(rest, 5));
+                REQUIRE(stream.remaining().size() == 4);
+                REQUIRE(stream.readSpan(rest, 4));
+                REQUIRE(std::string_view(rest.data(), rest.size()) == "rest");
+                REQUIRE_FALSE(stream.isStreamGood());
+            }
+
+            THEN("Failed string reads should leave the position alone") {
+                stream.setStreamPosition(payload.size() - 4);
+                std::string_view string;
+                REQUIRE_FALSE(stream.readStringView(string));
+                REQUIRE(stream.getStreamPosition() == payload.size() - 4);
+            }
+        }
+
+        GIVEN("A binary document in borrowed memory") {
+            JSONJay::JSONParser parser;
+            BufferStreamWritinator encoded;
+            JSONJay::BinaryWriter().write(encoded, parser.parse(R"({"a":[1,2,3]})"));
+            SpanStreamReadinator stream(std::span<const char>(encoded.getBuffer()));
+
+            THEN("It should decode like from an owned buffer") {
+                JSONJay::Document document = JSONJay::BinaryReader().read(stream);
+                REQUIRE(document.object().get_list("a").size() == 3);
+            }
+        }
+    }
+
+    SECTION("Owned buffers") {
+        GIVEN("A buffer handed over by move") {
+            std::vector<char> copy = payload;
+            BufferStreamReadinator stream(std::move(copy));
+
+            THEN("It should read the same data") {
+                uint16_t number = 0;
+                std::string string;
+                char rest[4];
+                REQUIRE(stream.readRaw(number));
+                REQUIRE(stream.readString(string));
+                REQUIRE(stream.readData(rest, 4));
+                REQUIRE(string == "borrowed");
+                REQUIRE_FALSE(stream.readData(rest, 1));
+            }
+        }
+    }
+
+    SECTION("Reading until a delimiter") {
+        GIVEN("Records with delimiters at every offset of a vector") {
+            std::string text;
+            for ( size_t n = 0; n < 80; n++ ) text += std::string(n, 'x') + "\r\n";
+            text += "tail";
+
+            THEN("Every record should be found in place") {
+                SpanStreamReadinator stream{ std::string_view(text) };
+                for ( size_t n = 0; n < 80; n++ ) {
+                    std::string_view record;
+                    REQUIRE(stream.readViewUntil(record, "\r\n"));
+                    REQUIRE(record == std::string(n, 'x') + "\r\n");
+                    REQUIRE(record.data() >= text.data());
+                }
+                std::string_view rest;
+                REQUIRE_FALSE(stream.readViewUntil(rest, "\r\n"));
+                REQUIRE(rest == "tail");
+            }
+
+            THEN("Copying readers should append the same bytes") {
+                BufferStreamReadinator stream(std::vector<char>(text.begin(), text.end()));
+                std::vector<char> data{ '>' };
+                REQUIRE(stream.readUntil(data, '\n'));
+                REQUIRE(stream.readUntil(data, std::string("\r\n")));
+                REQUIRE(std::string(data.begin(), data.end()) == ">\r\nx\r\n");
+                data.clear();
+                REQUIRE(stream.readUntil(data, std::string("")));
+                REQUIRE(data.empty());
+            }
+        }
+
+        GIVEN("Delimiters with repeated and partial matches") {
+            std::string text = std::string(40, 'a') + "abab" + std::string(40, 'b') + "aab";
+            SpanStreamReadinator stream{ std::string_view(text) };
+
+            THEN("The first full match should be found") {
+                std::string_view record;
+                REQUIRE(stream.readViewUntil(record, "aabab"));
+                REQUIRE(record.size() == 44);
+                REQUIRE(stream.readViewUntil(record, "aab"));
+                REQUIRE(record.size() == 43);
+                REQUIRE_FALSE(stream.readViewUntil(record, "b"));
+                REQUIRE(record.empty());
+            }
+        }
+
+        GIVEN("A delimiter across the blocks the generic reader used to read") {
+            std::string filename = (std::filesystem::temp_directory_path() / "JSONJay_read_until.bin").string();
+            {
+                JSONJay::FileStreamWritinator file(filename);
+                file.writeData("ab\r\r\nc", 6);
+            }
+            JSONJay::FileStreamReadinator stream(filename);
+
+            THEN("It should be found wherever it starts") {
+                std::vector<char> data;
+                REQUIRE(stream.readUntil(data, std::string("\r\n")));
+                REQUIRE(std::string(data.begin(), data.end()) == "ab\r\r\n");
+                data.clear();
+                REQUIRE_FALSE(stream.readUntil(data, std::string("\r\n")));
+                REQUIRE(std::string(data.begin(), data.end()) == "c");
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include "catch2/catch_test_macros.hpp"
+#include "Value.hpp"
+#include "Object.hpp"
+#include "List.hpp"
+
+#include <string>
+
+using JSONJay::Value;
+using JSONJay::BaseDataType;
+
+TEST_CASE("Value operations", "[Value]") {
+    JSONJay::node_allocator_t allocator;
+
+    SECTION("Size") {
+        THEN("A value should be 16 bytes") {
+            REQUIRE(sizeof(Value) == 16);
+        }
+    }
+
+    SECTION("Scalars") {
+        GIVEN("Values of every scalar type") {
+            Value none;
+            Value integer(42);
+            Value real(3.14);
+            Value boolean(true);
+
+            THEN("The types should be correct") {
+                REQUIRE(none.type() == BaseDataType::NONE);
+                REQUIRE(integer.type() == BaseDataType::INT);
+                REQUIRE(real.type() == BaseDataType::DOUBLE);
+                REQUIRE(boolean.type() == BaseDataType::BOOL);
+            }
+
+            THEN("The content should be accessible") {
+                REQUIRE(integer.get<int>() == 42);
+                REQUIRE(real.get<double>() == 3.14);
+                REQUIRE(boolean.get<bool>() == true);
+            }
+
+            THEN("Accessing the wrong type should throw") {
+                REQUIRE_THROWS_AS(integer.get<double>(), JSONJay::InvalidTypeException);
+                REQUIRE_THROWS_AS(none.get<std::string>(), JSONJay::InvalidTypeException);
+            }
+
+            WHEN("Modifying the content through a reference") {
+                integer.get<int>() = 7;
+
+                THEN("The value should be updated") {
+                    REQUIRE(integer.get<int>() == 7);
+                }
+            }
+        }
+    }
+
+    SECTION("Strings") {
+        GIVEN("A short and a long string") {
+            std::string shortString(Value::kInlineCapacity, 's');
+            std::string longString(Value::kInlineCapacity + 1, 'l');
+            Value inlineValue(shortString, allocator);
+            Value heapValue(longString, allocator);
+
+            THEN("Both should read back unchanged") {
+                REQUIRE(inlineValue.type() == BaseDataType::STRING);
+                REQUIRE(heapValue.type() == BaseDataType::STRING);
+                REQUIRE(inlineValue.as_string() == shortString);
+                REQUIRE(heapValue.get<std::string>() == longString);
+            }
+
+            THEN("Only the long string should live out of line") {
+                REQUIRE(inlineValue.as_string().data() == reinterpret_cast<const char*>(&inlineValue) + 2);
+                REQUIRE(heapValue.as_string().data() != reinterpret_cast<const char*>(&heapValue) + 2);
+            }
+
+            WHEN("Destroying the values") {
+                inlineValue.destroy(allocator);
+                heapValue.destroy(allocator);
+
+                THEN("The values should be empty") {
+                    REQUIRE(inlineValue.type() == BaseDataType::NONE);
+                    REQUIRE(heapValue.type() == BaseDataType::NONE);
+                }
+            }
+
+            heapValue.destroy(allocator);
+        }
+    }
+
+    SECTION("Nested nodes") {
+        GIVEN("A value holding a list") {
+            Value value = Value::make<JSONJay::List*>(new JSONJay::List(), allocator);
+
+            THEN("The list should be accessible") {
+                REQUIRE(value.type() == BaseDataType::LIST);
+                REQUIRE(value.get<JSONJay::List*>()->empty());
+            }
+
+            value.destroy(allocator);
+        }
+    }
+}